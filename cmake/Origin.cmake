@@ -48,7 +48,13 @@ if(NOT ORIGIN_INCLUDED)
 
   # Be sure to compile in C++11 mode!
   # FIXME: Move the C++ configuration stuff into a separate config module.
-  set(CMAKE_CXX_FLAGS "-std=c++11")
+  set(CMAKE_CXX_FLAGS "-std=c++11 -pthread")
+
+  # Count graph container events (see [graph.instrument]).
+  option(ORIGIN_GRAPH_INSTRUMENT "Enable the graph instrumentation counters" OFF)
+  if(ORIGIN_GRAPH_INSTRUMENT)
+    add_definitions(-DORIGIN_GRAPH_INSTRUMENT)
+  endif()
 
   # Make sure that we can include files as <origin/xxx>.
   # FIXME: It would be nice if...
@@ -61,6 +67,7 @@ if(NOT ORIGIN_INCLUDED)
   include(OriginVersion)
   include(OriginModule)
   include(OriginTest)
+  include(OriginPerformance)
 
 endif()
 
@@ -8,17 +8,30 @@
 
 
 # This module contains macros used to build performance testing targets.
-# Each performance test is hosted in a different directory (usually as a
-# subdirectory of tests/perf), and contains one or more programs that are
-# compiled and run (using 'make performance') to produce and compile results.
+# Each performance test is hosted in a different directory (usually the
+# perf directory of a module, e.g., graph.perf), and contains programs that are
+# compiled and run (using 'make perform') to produce and compile results.
 #
 # Note that a full system for compiling performance test results is still
 # being worked out.
 
 
-# Tools used to analyze and graph results
+# Turning this option on builds the performance tests, which are run by
+# 'make perform'.
+option(ORIGIN_BUILD_PERFORMANCE "Build performance tests" OFF)
 
-set(ORIGIN_PLOT_COMP_RATIO ${ORIGIN_ROOT}/tools/)
+if(ORIGIN_BUILD_PERFORMANCE)
+  find_program(ORIGIN_PYTHON NAMES python3 python)
+  if(NOT ORIGIN_PYTHON)
+    message(FATAL_ERROR "Performance tests require Python.")
+  endif()
+  add_custom_target(perform)
+endif()
+
+
+# Tools used to analyze results
+
+set(ORIGIN_PERF_COMPARE ${ORIGIN_PROJECT_ROOT}/tools/perf_compare.py)
 
 
 # Build a head-to-head performance comparison for two different source code
@@ -29,14 +42,10 @@ set(ORIGIN_PLOT_COMP_RATIO ${ORIGIN_ROOT}/tools/)
 # If REPEAT is not given, the default value is 1. For head-to-head performance
 # tests, that isn't generally a good idea.
 #
-# TODO: Support arguments for annotating the resulting documents or selecting
-# the output format. Currently, we generate pdf, but generating png might be
-# useful for web reporting. Or build commands that generate generate all such
-# outputs and build a single target that intgrates the performance reporting.
-#
-# FIXME: I will need to change the call mechanism when I get the performance
-# tester's argument parsing in better shape. Repetitions will probably be
-# passed as an option (-r or --repeat).
+# Each program is run with the number of repetitions as its argument, and
+# writes its results to stdout as CSV, with a header row. The results are
+# merged into perf_<id>.csv, in which each row is compared with the matching
+# row of the first program (see tools/perf_compare.py).
 macro(origin_perf_comparison id)
   # Parse the command line arguments.
   parse_arguments(parsed "COMPARE;REPEAT" "" ${ARGN})
@@ -55,34 +64,33 @@ macro(origin_perf_comparison id)
     get_filename_component(name ${i} NAME_WE)
     set(tgt ${main}_${name})
 
-    # Create a target for the test program.
-    origin_executable(${tgt} ${i})
-    target_link_libraries(${tgt} origin)
+    # Create a target for the test program, linked like the unit tests of
+    # the current module. Performance tests are always optimized.
+    add_executable(${tgt} ${i})
+    set_target_properties(${tgt} PROPERTIES COMPILE_FLAGS "-O2 -DNDEBUG")
+    link_imports(${tgt} ${ORIGIN_CURRENT_MODULE})
 
     # And create a command that will generate its output.
-    # FIXME: This probably won't work in a non-unix environment or
-    # anywhere where executable targets have a non-empty suffix.
-    set(exe ${bin}/${tgt})
-    set(txt ${exe}.txt)
+    set(csv ${bin}/${tgt}.csv)
     add_custom_command(
-      OUTPUT ${txt}
-      COMMAND ${exe} ${repeat} > ${txt}
+      OUTPUT ${csv}
+      COMMAND $<TARGET_FILE:${tgt}> ${repeat} > ${csv}
       DEPENDS ${tgt})
 
-    # Add the output text to the list of dependencies that this
-    # performance comparison will depend upon.
-    list(APPEND results ${txt})
+    # Add the output to the list of dependencies that this performance
+    # comparison will depend upon.
+    list(APPEND results ${csv})
   endforeach()
 
-  # Generate a command to synthesize the output into a graph of some kind.
-  set(pdf ${main}.pdf)
+  # Merge the results into a single table.
+  set(csv ${bin}/${main}.csv)
   add_custom_command(
-    OUTPUT ${pdf}
-    COMMAND ${ORIGIN_PLOT_COMP_RATIO}.py -o ${pdf} ${results}
-    DEPENDS ${results})
+    OUTPUT ${csv}
+    COMMAND ${ORIGIN_PYTHON} ${ORIGIN_PERF_COMPARE} -o ${csv} ${results}
+    DEPENDS ${results} ${ORIGIN_PERF_COMPARE})
 
   # Build a target for this performance comparison
-  add_custom_target(${main} DEPENDS ${pdf})
+  add_custom_target(${main} DEPENDS ${csv})
 
   # Register this performance test as a dependency of the perf target.
   add_dependencies(perform ${main})
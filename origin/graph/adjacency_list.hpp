@@ -9,10 +9,17 @@
 #define ORIGIN_GRAPH_ADJACENCY_LIST_HPP
 
 #include <cassert>
+#include <cstdint>
 
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <queue>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include <origin/type/concepts.hpp>
@@ -25,8 +32,12 @@
 #include <origin/graph/handle.hpp>
 #include <origin/graph/graph.hpp>
 #include <origin/graph/io.hpp>
+#include <origin/graph/batch.hpp>
+#include <origin/graph/memory.hpp>
+#include <origin/graph/instrument.hpp>
 
 #include <origin/graph/adjacency_list.impl/pool.hpp>
+#include <origin/graph/adjacency_list.impl/epoch.hpp>
 
 namespace origin
 {
@@ -41,10 +52,10 @@ namespace origin
     template<typename C, typename H>
       struct handle_accessor;
 
-    template<typename T, typename H>
-      struct handle_accessor<pool<T>, H>
+    template<typename T, typename N, typename H>
+      struct handle_accessor<pool<T, N>, H>
       {
-        using I = Iterator_of<const pool<T>>;
+        using I = Iterator_of<const pool<T, N>>;
 
         H get(I i) const { return i.index(); }
       };
@@ -59,13 +70,20 @@ namespace origin
 
 
     // The handle iterator wraps a constant iterator of the container type C and
-    // returns handles of type H when dereferenced.
+    // returns handles of type H when dereferenced. Handles are returned by
+    // value, so the iterator is only an input iterator.
     template<typename C, typename H>
       struct handle_iterator : handle_accessor<C, H>
       {
         using handle_type = H;
         using iterator = Iterator_of<const C>;
 
+        using iterator_category = std::input_iterator_tag;
+        using value_type = H;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const H*;
+        using reference = H;
+
         handle_iterator(iterator i)
           : iter(i)
         { }
@@ -112,6 +130,63 @@ namespace origin
       }
 
 
+    // ---------------------------------------------------------------------- //
+    //                            Version Iterator
+    //
+    // The version iterator enumerates the live indexes of a pool version,
+    // returning handles of type H when dereferenced.
+    template<typename T, typename H>
+      struct version_iterator
+      {
+        using handle_type = H;
+        using version_type = pool_version<T>;
+
+        version_iterator(const version_type* v, std::size_t n)
+          : ver(v), index(v->next(n))
+        { }
+
+        handle_type operator*() const { return index; }
+
+        version_iterator& operator++();
+        version_iterator  operator++(int);
+
+        const version_type* ver;
+        std::size_t index;
+      };
+
+    template<typename T, typename H>
+      inline version_iterator<T, H>&
+      version_iterator<T, H>::operator++()
+      {
+        index = ver->next(index + 1);
+        return *this;
+      }
+
+    template<typename T, typename H>
+      inline version_iterator<T, H>
+      version_iterator<T, H>::operator++(int)
+      {
+        version_iterator tmp = *this;
+        operator++();
+        return tmp;
+      }
+
+    // Equality
+    template<typename T, typename H>
+      inline bool
+      operator==(const version_iterator<T, H>& a, const version_iterator<T, H>& b)
+      {
+        return a.index == b.index;
+      }
+
+    template<typename T, typename H>
+      inline bool
+      operator!=(const version_iterator<T, H>& a, const version_iterator<T, H>& b)
+      {
+        return a.index != b.index;
+      }
+
+
     // ---------------------------------------------------------------------- //
     //                            Edge Representation
     //
@@ -122,56 +197,60 @@ namespace origin
     // In an undirected adjacency list, the source and target vertices refer to
     // the vertices in the order they were specified on addition. There is no
     // other meaning attributed to them.
-    template<typename E>
+    template<typename E, typename N>
       struct edge
       {
         using value_type = E;
+        using vertex_type = basic_vertex_handle<N>;
 
         edge()
           : data(-1, -1, E{})
         { }
 
-        edge(vertex_handle s, vertex_handle t)
+        edge(vertex_type s, vertex_type t)
           : data(s, t, E{})
         { }
 
         template<typename... Args>
-          edge(vertex_handle s, vertex_handle t, Args&&... args)
+          edge(vertex_type s, vertex_type t, Args&&... args)
             : data(s, t, std::forward<Args>(args)...)
           { }
 
-        std::size_t& source()       { return std::get<0>(data); }
-        std::size_t  source() const { return std::get<0>(data); }
+        vertex_type& source()       { return std::get<0>(data); }
+        vertex_type  source() const { return std::get<0>(data); }
 
-        std::size_t& target()       { return std::get<1>(data); }
-        std::size_t  target() const { return std::get<1>(data); }
+        vertex_type& target()       { return std::get<1>(data); }
+        vertex_type  target() const { return std::get<1>(data); }
 
         E&       value()       { return std::get<2>(data); }
         const E& value() const { return std::get<2>(data); }
 
-        std::tuple<vertex_handle, vertex_handle,  E> data;
+        std::tuple<vertex_type, vertex_type,  E> data;
       };
 
     // An (incident) edge list is a vector of indexes.
-    using edge_list = std::vector<edge_handle>;
-  
+    template<typename N>
+      using edge_list = std::vector<basic_edge_handle<N>>;
+
     // An alias for the edge pool.
-    template<typename E>
-      using edge_pool = pool<edge<E>>;
+    template<typename E, typename N>
+      using edge_pool = pool<edge<E, N>, N>;
 
     // An alias for the vertex iterator.
-    template<typename E>
-      using edge_iterator = handle_iterator<edge_pool<E>, edge_handle>;
+    template<typename E, typename N>
+      using edge_iterator = handle_iterator<edge_pool<E, N>, basic_edge_handle<N>>;
 
     // An alias for the edge range.
-    template<typename E>
-      using edge_range = bounded_range<edge_iterator<E>>;
+    template<typename E, typename N>
+      using edge_range = bounded_range<edge_iterator<E, N>>;
 
     // An alias for the incident edge iterator.
-    using incidence_iterator = handle_iterator<edge_list, edge_handle>;
+    template<typename N>
+      using incidence_iterator = handle_iterator<edge_list<N>, basic_edge_handle<N>>;
 
     // An alias for the icident edge range.
-    using incidence_range = bounded_range<incidence_iterator>;
+    template<typename N>
+      using incidence_range = bounded_range<incidence_iterator<N>>;
 
   } // namespace adjacency_list_impl
 
@@ -183,13 +262,20 @@ namespace origin
   //
   // A directed adjacency list...
   //
+  // The unsigned integer type N is the index type of the vertex and edge
+  // handles of both the directed and undirected adjacency lists, and of the
+  // pools that store their vertices and edges.
 
 
   namespace directed_adjacency_list_impl
   {
     // Imports
     using adjacency_list_impl::pool;
+    using adjacency_list_impl::pool_version;
     using adjacency_list_impl::handle_iterator;
+    using adjacency_list_impl::version_iterator;
+    using adjacency_list_impl::version_store;
+    using adjacency_list_impl::version_control;
     using adjacency_list_impl::edge_list;
 
 
@@ -201,12 +287,12 @@ namespace origin
     // separate edge container.
     //
     // Note that the class will compress the value type if it is empty.
-    template<typename V>
+    template<typename V, typename N>
       struct vertex
       {
         using value_type = V;
-        using iterator = typename edge_list::iterator;
-        using const_iterator = typename edge_list::const_iterator;
+        using iterator = typename edge_list<N>::iterator;
+        using const_iterator = typename edge_list<N>::const_iterator;
     
         vertex()
           : data()
@@ -214,16 +300,16 @@ namespace origin
 
         template<typename... Args>
           vertex(Args&&... args) 
-            : data(edge_list{}, edge_list{}, std::forward<Args>(args)...)
+            : data(edge_list<N>{}, edge_list<N>{}, std::forward<Args>(args)...)
           { }
 
         // Returns the out ege list
-        edge_list&       out()       { return std::get<0>(data); }
-        const edge_list& out() const { return std::get<0>(data); }
+        edge_list<N>&       out()       { return std::get<0>(data); }
+        const edge_list<N>& out() const { return std::get<0>(data); }
         
         // Returns the in edge list
-        edge_list&       in()       { return std::get<1>(data); }
-        const edge_list& in() const { return std::get<1>(data); }
+        edge_list<N>&       in()       { return std::get<1>(data); }
+        const edge_list<N>& in() const { return std::get<1>(data); }
 
         // Returns the user-supplied data object.
         V&       value()       { return std::get<2>(data); }
@@ -232,8 +318,8 @@ namespace origin
         // Out edges
         std::size_t out_degree() const { return out().size(); }
 
-        void insert_out(edge_handle e) { insert_edge(out(), e); }
-        void erase_out(edge_handle e)  { erase_edge(out(), e); }
+        void insert_out(basic_edge_handle<N> e) { insert_edge(out(), e); }
+        void erase_out(basic_edge_handle<N> e) { erase_edge(out(), e); }
 
         iterator begin_out() { return out().begin(); }
         iterator end_out()   { return out().end(); }
@@ -243,8 +329,8 @@ namespace origin
         // In edges
         std::size_t in_degree() const { return in().size(); }
         
-        void insert_in(edge_handle e) { insert_edge(in(), e); }
-        void erase_in(edge_handle e)  { erase_edge(in(), e); }
+        void insert_in(basic_edge_handle<N> e) { insert_edge(in(), e); }
+        void erase_in(basic_edge_handle<N> e) { erase_edge(in(), e); }
 
         iterator begin_in() { return in().begin(); }
         iterator end_in()   { return in().end(); }
@@ -252,23 +338,24 @@ namespace origin
         const_iterator end_in() const   { return in().end(); }
 
         // Helper functions
-        void insert_edge(edge_list& l, edge_handle e);
-        void erase_edge(edge_list& l, edge_handle e);
+        void insert_edge(edge_list<N>& l, basic_edge_handle<N> e);
+        void erase_edge(edge_list<N>& l, basic_edge_handle<N> e);
 
       public:
-        std::tuple<edge_list, edge_list, V> data;
+        std::tuple<edge_list<N>, edge_list<N>, V> data;
       };
 
-    template<typename V>
+    template<typename V, typename N>
       inline void
-      vertex<V>::insert_edge(edge_list& l, edge_handle e)
+      vertex<V, N>::insert_edge(edge_list<N>& l, basic_edge_handle<N> e)
       {
+        ORIGIN_GRAPH_GROWTH(l);
         l.push_back(e);
       }
 
-    template<typename V>
+    template<typename V, typename N>
       inline void
-      vertex<V>::erase_edge(edge_list& l, edge_handle e)
+      vertex<V, N>::erase_edge(edge_list<N>& l, basic_edge_handle<N> e)
       {
         auto i = std::find(l.begin(), l.end(), e);
         if (i != l.end())
@@ -276,43 +363,234 @@ namespace origin
       }
 
     // A vertex set is a pool of vertices.
-    template<typename V>
-      using vertex_pool = pool<vertex<V>>;
+    template<typename V, typename N>
+      using vertex_pool = pool<vertex<V, N>, N>;
 
     // An alias for the vertex iterator.
-    template<typename V>
-      using vertex_iterator = handle_iterator<vertex_pool<V>, vertex_handle>;
+    template<typename V, typename N>
+      using vertex_iterator = handle_iterator<vertex_pool<V, N>, basic_vertex_handle<N>>;
 
     // An alias for the vertex range.
-    template<typename V>
-      using vertex_range = bounded_range<vertex_iterator<V>>;
+    template<typename V, typename N>
+      using vertex_range = bounded_range<vertex_iterator<V, N>>;
+
+
+    // ---------------------------------------------------------------------- //
+    //                            Graph Versions
+    //
+    // A version of a directed adjacency list is a pair of pool versions: one
+    // for the vertex set and one for the edge set.
+    template<typename V, typename E, typename N>
+      struct version
+      {
+        pool_version<vertex<V, N>>                   verts;
+        pool_version<adjacency_list_impl::edge<E, N>> edges;
+      };
+
+
+    // ---------------------------------------------------------------------- //
+    //                                Snapshot
+    //
+    // A snapshot is a read-only view of a committed version of a directed
+    // adjacency list. A snapshot pins its version for as long as it exists,
+    // and it can be traversed without synchronizing with the writer, even
+    // while the graph is being modified. Vertex and edge handles in a
+    // snapshot are the same as those in the graph at the time of the commit.
+    //
+    // Snapshots are movable but not copyable. A snapshot must not outlive
+    // the graph from which it was taken.
+    template<typename V, typename E, typename N>
+      class snapshot
+      {
+        using version_type = version<V, E, N>;
+        using store_type = version_store<version_type>;
+
+        using vertex_node = directed_adjacency_list_impl::vertex<V, N>;
+        using vertex_iter = version_iterator<vertex_node, basic_vertex_handle<N>>;
+
+        using edge_node = adjacency_list_impl::edge<E, N>;
+        using edge_iter = version_iterator<edge_node, basic_edge_handle<N>>;
+
+        using incidence_iter = adjacency_list_impl::incidence_iterator<N>;
+      public:
+        using vertex = basic_vertex_handle<N>;
+        using vertex_range = bounded_range<vertex_iter>;
+
+        using edge = basic_edge_handle<N>;
+        using edge_range = bounded_range<edge_iter>;
+
+        using incidence_range = adjacency_list_impl::incidence_range<N>;
+
+        snapshot(const store_type* s);
+        snapshot(snapshot&& x);
+        ~snapshot();
+
+        snapshot(const snapshot&) = delete;
+        snapshot& operator=(const snapshot&) = delete;
+
+        // Observers
+        bool        null() const  { return ver().verts.empty(); }
+        std::size_t order() const { return ver().verts.size(); }
+
+        bool        empty() const { return ver().edges.empty(); }
+        std::size_t size() const  { return ver().edges.size(); }
+
+        // Vertex observers
+        std::size_t out_degree(vertex v) const { return node(v).out_degree(); }
+        std::size_t in_degree(vertex v) const  { return node(v).in_degree(); }
+        std::size_t degree(vertex v) const { return out_degree(v) + in_degree(v); }
+
+        // Edge observers
+        vertex source(edge e) const { return get_edge(e).source(); }
+        vertex target(edge e) const { return get_edge(e).target(); }
+
+        // Data access
+        const V& operator()(vertex v) const { return node(v).value(); }
+        const E& operator()(edge e) const   { return get_edge(e).value(); }
+
+        // Edge relation
+        edge operator()(vertex u, vertex v) const;
+
+        // Iterators
+        vertex_range    vertices() const;
+        edge_range      edges() const;
+        incidence_range out_edges(vertex v) const;
+        incidence_range in_edges(vertex v) const;
+
+      private:
+        const version_type& ver() const { return ver_ ? *ver_ : empty_; }
+
+        const vertex_node& node(vertex v) const;
+        const edge_node&   get_edge(edge e) const;
+
+      private:
+        const store_type*   store_;
+        std::size_t         slot_;
+        const version_type* ver_;
+        version_type        empty_; // Viewed when nothing has been committed
+      };
+
+    template<typename V, typename E, typename N>
+      inline
+      snapshot<V, E, N>::snapshot(const store_type* s)
+        : store_(s), slot_(0), ver_(nullptr)
+      {
+        if (store_)
+          std::tie(slot_, ver_) = store_->pin();
+      }
+
+    template<typename V, typename E, typename N>
+      inline
+      snapshot<V, E, N>::snapshot(snapshot&& x)
+        : store_(x.store_), slot_(x.slot_), ver_(x.ver_)
+      {
+        x.store_ = nullptr;
+        x.ver_ = nullptr;
+      }
+
+    template<typename V, typename E, typename N>
+      inline
+      snapshot<V, E, N>::~snapshot()
+      {
+        if (store_)
+          store_->unpin(slot_);
+      }
+
+    template<typename V, typename E, typename N>
+      inline auto
+      snapshot<V, E, N>::node(vertex v) const -> const vertex_node&
+      {
+        const vertex_node* p = ver().verts.get(v);
+        assert(p);
+        return *p;
+      }
+
+    template<typename V, typename E, typename N>
+      inline auto
+      snapshot<V, E, N>::get_edge(edge e) const -> const edge_node&
+      {
+        const edge_node* p = ver().edges.get(e);
+        assert(p);
+        return *p;
+      }
+
+    template<typename V, typename E, typename N>
+      inline auto
+      snapshot<V, E, N>::operator()(vertex u, vertex v) const -> edge
+      {
+        const vertex_node& un = node(u);
+        const vertex_node& vn = node(v);
+        if (un.out_degree() <= vn.in_degree()) {
+          auto i = find_if(un.out(), has_target<snapshot>(*this, v));
+          ORIGIN_GRAPH_SEARCH(u, instrument_impl::probes(un.out(), i));
+          return i == un.end_out() ? edge() : *i;
+        } else {
+          auto i = find_if(vn.in(), has_source<snapshot>(*this, u));
+          ORIGIN_GRAPH_SEARCH(v, instrument_impl::probes(vn.in(), i));
+          return i == vn.end_in() ? edge() : *i;
+        }
+      }
+
+    template<typename V, typename E, typename N>
+      inline auto
+      snapshot<V, E, N>::vertices() const -> vertex_range
+      {
+        const auto& vs = ver().verts;
+        return {vertex_iter(&vs, 0), vertex_iter(&vs, vs.extent)};
+      }
+
+    template<typename V, typename E, typename N>
+      inline auto
+      snapshot<V, E, N>::edges() const -> edge_range
+      {
+        const auto& es = ver().edges;
+        return {edge_iter(&es, 0), edge_iter(&es, es.extent)};
+      }
+
+    template<typename V, typename E, typename N>
+      inline auto
+      snapshot<V, E, N>::out_edges(vertex v) const -> incidence_range
+      {
+        const vertex_node& vn = node(v);
+        return {incidence_iter(vn.begin_out()), incidence_iter(vn.end_out())};
+      }
+
+    template<typename V, typename E, typename N>
+      inline auto
+      snapshot<V, E, N>::in_edges(vertex v) const -> incidence_range
+      {
+        const vertex_node& vn = node(v);
+        return {incidence_iter(vn.begin_in()), incidence_iter(vn.end_in())};
+      }
 
   } // namespace directed_adjacency_list_impl
 
 
   // Implementation of a diretected adjacency list.
-  template<typename V = empty_t, typename E = empty_t>
+  template<typename V = empty_t, typename E = empty_t, typename N = std::size_t>
     class directed_adjacency_list
     {
-      using this_type = directed_adjacency_list<V, E>;
+      using this_type = directed_adjacency_list<V, E, N>;
 
-      using vertex_node = directed_adjacency_list_impl::vertex<V>;
-      using vertex_set = directed_adjacency_list_impl::vertex_pool<V>;
-      using vertex_iter = directed_adjacency_list_impl::vertex_iterator<V>;
+      using vertex_node = directed_adjacency_list_impl::vertex<V, N>;
+      using vertex_set = directed_adjacency_list_impl::vertex_pool<V, N>;
+      using vertex_iter = directed_adjacency_list_impl::vertex_iterator<V, N>;
 
-      using edge_node = adjacency_list_impl::edge<E>;
-      using edge_set = adjacency_list_impl::edge_pool<E>;
-      using edge_iter = adjacency_list_impl::edge_iterator<E>;
+      using edge_node = adjacency_list_impl::edge<E, N>;
+      using edge_set = adjacency_list_impl::edge_pool<E, N>;
+      using edge_iter = adjacency_list_impl::edge_iterator<E, N>;
 
-      using incidence_iter = adjacency_list_impl::incidence_iterator;
+      using incidence_iter = adjacency_list_impl::incidence_iterator<N>;
     public:
-      using vertex = vertex_handle;
-      using vertex_range = directed_adjacency_list_impl::vertex_range<V>;
+      using vertex = basic_vertex_handle<N>;
+      using vertex_range = directed_adjacency_list_impl::vertex_range<V, N>;
 
-      using edge = edge_handle;
-      using edge_range = adjacency_list_impl::edge_range<E>;
+      using edge = basic_edge_handle<N>;
+      using edge_range = adjacency_list_impl::edge_range<E, N>;
 
-      using incidence_range = adjacency_list_impl::incidence_range;
+      using incidence_range = adjacency_list_impl::incidence_range<N>;
+
+      using snapshot_type = directed_adjacency_list_impl::snapshot<V, E, N>;
 
 
       // Observers
@@ -366,6 +644,22 @@ namespace origin
       void remove_edges(vertex v);
       void remove_edges();
 
+      // Edge batches
+      using edge_insertion = std::tuple<vertex, vertex, E>;
+      using edge_deletion = std::pair<vertex, vertex>;
+
+      void apply_batch(const std::vector<edge_insertion>& insertions,
+                       const std::vector<edge_deletion>& deletions,
+                       std::size_t threads = 0);
+
+      // Versioning
+      void          commit();
+      snapshot_type snapshot() const;
+
+      // Memory
+      graph_memory memory_usage() const;
+      void         shrink_to_fit();
+
       // Iterators
       vertex_range    vertices() const;
       edge_range      edges() const;
@@ -373,6 +667,8 @@ namespace origin
       incidence_range in_edges(vertex v) const;
 
     private:
+      using version_type = directed_adjacency_list_impl::version<V, E, N>;
+
       vertex_node&       node(vertex v)       { return verts_[v]; }
       const vertex_node& node(vertex v) const { return verts_[v]; }
 
@@ -384,7 +680,7 @@ namespace origin
       edge find_in_edge(vertex u, vertex v) const;
 
       template<typename S, typename P>
-        edge find_edge(const S& seq, P pred) const;
+        edge find_edge(vertex x, const S& seq, P pred) const;
 
       void link_edge(vertex u, vertex v, edge e);
       void unlink_edge(vertex u, vertex v, edge e);
@@ -396,20 +692,22 @@ namespace origin
       void unlink_source(edge e);
 
       template<typename S, typename P>
-        void unlink_first_edge(S& seq, P pred);
+        void unlink_first_edge(vertex x, S& seq, P pred);
 
       template<typename S1, typename S2, typename P>
-        void unlink_multi_edge(S1& seq1, S2& seq2, P pred);
+        void unlink_multi_edge(vertex x, S1& seq1, vertex y, S2& seq2, P pred);
 
     private:
       vertex_set verts_;
       edge_set   edges_;
+
+      directed_adjacency_list_impl::version_control<version_type> versions_;
     };
 
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::operator()(vertex u, vertex v) const -> edge
+    directed_adjacency_list<V, E, N>::operator()(vertex u, vertex v) const -> edge
     {
       if (out_degree(u) <= in_degree(v))
         return find_out_edge(u, v);
@@ -417,118 +715,121 @@ namespace origin
         return find_in_edge(u, v);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::find_out_edge(vertex u, vertex v) const -> edge
+    directed_adjacency_list<V, E, N>::find_out_edge(vertex u, vertex v) const -> edge
     {
       using P = has_target<this_type>;
       const vertex_node& n = node(u);
-      return find_edge(n.out(), P(*this, v));
+      return find_edge(u, n.out(), P(*this, v));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::find_in_edge(vertex u, vertex v) const -> edge
+    directed_adjacency_list<V, E, N>::find_in_edge(vertex u, vertex v) const -> edge
     {
       using P = has_source<this_type>;
       const vertex_node& n = node(v);
-      return find_edge(n.in(), P(*this, u));
+      return find_edge(v, n.in(), P(*this, u));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename S, typename P>
       inline auto
-      directed_adjacency_list<V, E>::find_edge(const S& seq, P pred) const -> edge
+      directed_adjacency_list<V, E, N>::
+        find_edge(vertex x, const S& seq, P pred) const -> edge
       {
         auto i = find_if(seq, pred);
+        ORIGIN_GRAPH_SEARCH(x, instrument_impl::probes(seq, i));
         return i == seq.end() ? edge() : *i;
       }
 
   // Add a vertex to the graph, returning a handle to the new object. If
   // V is a user-supplied type, its value is default constructed.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::add_vertex() -> vertex
+    directed_adjacency_list<V, E, N>::add_vertex() -> vertex
     {
       return verts_.emplace();
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::add_vertex(V&& x) -> vertex
+    directed_adjacency_list<V, E, N>::add_vertex(V&& x) -> vertex
     {
       return verts_.emplace(std::move(x));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::add_vertex(const V& x) -> vertex
+    directed_adjacency_list<V, E, N>::add_vertex(const V& x) -> vertex
     {
       return verts_.emplace(x);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename... Args>
       inline auto
-      directed_adjacency_list<V, E>::emplace_vertex(Args&&... args) -> vertex
+      directed_adjacency_list<V, E, N>::emplace_vertex(Args&&... args) -> vertex
       {
         return verts_.emplace(std::forward<Args>(args)...);
       }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::remove_vertex(vertex v)
+    directed_adjacency_list<V, E, N>::remove_vertex(vertex v)
     {
       remove_edges(v);
       verts_.erase(v);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::remove_vertices()
+    directed_adjacency_list<V, E, N>::remove_vertices()
     {
       edges_.clear();
       verts_.clear();
     }
 
   // Add a defaul edge from u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::add_edge(vertex u, vertex v) -> edge
+    directed_adjacency_list<V, E, N>::add_edge(vertex u, vertex v) -> edge
     {
       return emplace_edge(u, v);
     }
 
   // Move x into an edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::add_edge(vertex u, vertex v, E&& x) -> edge
+    directed_adjacency_list<V, E, N>::add_edge(vertex u, vertex v, E&& x) -> edge
     {
       return emplace_edge(u, v, std::move(x));
     }
 
   // Copy x into an edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::add_edge(vertex u, vertex v, const E& x) -> edge
+    directed_adjacency_list<V, E, N>::add_edge(vertex u, vertex v, const E& x) -> edge
     {
       return emplace_edge(u, v, x);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename... Args>
       inline auto
-      directed_adjacency_list<V, E>::
+      directed_adjacency_list<V, E, N>::
         emplace_edge(vertex u, vertex v, Args&&... args) -> edge
       {
+        ORIGIN_GRAPH_COUNT(add_edge, 1);
         edge e = edges_.emplace(u, v, std::forward<Args>(args)...);
         link_edge(u, v, e);
         return e;
       }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::link_edge(vertex u, vertex v, edge e)
+    directed_adjacency_list<V, E, N>::link_edge(vertex u, vertex v, edge e)
     {
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
@@ -537,31 +838,36 @@ namespace origin
     }
 
   // Remove the specified edge from the graph.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::remove_edge(edge e)
+    directed_adjacency_list<V, E, N>::remove_edge(edge e)
     {
       unlink_edge(source(e), target(e), e);
     }
 
   // Unlink the given edge from the source and target vertices, and erase
   // it from the edge set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::unlink_edge(vertex u, vertex v, edge e)
+    directed_adjacency_list<V, E, N>::unlink_edge(vertex u, vertex v, edge e)
     {
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
-      un.erase_out(e);
-      vn.erase_in(e);
+      auto i = std::find(un.begin_out(), un.end_out(), e);
+      ORIGIN_GRAPH_SEARCH(u, instrument_impl::probes(un.out(), i));
+      un.out().erase(i);
+      auto j = std::find(vn.begin_in(), vn.end_in(), e);
+      ORIGIN_GRAPH_SEARCH(v, instrument_impl::probes(vn.in(), j));
+      vn.in().erase(j);
       edges_.erase(e);
+      ORIGIN_GRAPH_COUNT(remove_edge, 1);
     }
 
 
   // Remove the first edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::remove_edge(vertex u, vertex v)
+    directed_adjacency_list<V, E, N>::remove_edge(vertex u, vertex v)
     {
       if (out_degree(u) <= in_degree(v))
         unlink_out_edge(u, v);
@@ -569,38 +875,39 @@ namespace origin
         unlink_in_edge(u, v);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::unlink_out_edge(vertex u, vertex v)
+    directed_adjacency_list<V, E, N>::unlink_out_edge(vertex u, vertex v)
     {
       using P = has_target<this_type>;
       vertex_node& un = node(u);
-      unlink_first_edge(un.out(), P(*this, v));
+      unlink_first_edge(u, un.out(), P(*this, v));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::unlink_in_edge(vertex u, vertex v)
+    directed_adjacency_list<V, E, N>::unlink_in_edge(vertex u, vertex v)
     {
       using P = has_source<this_type>;
       vertex_node& vn = node(v);
-      unlink_first_edge(vn.in(), P(*this, u));
+      unlink_first_edge(v, vn.in(), P(*this, u));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename S, typename P>
       inline void
-      directed_adjacency_list<V, E>::unlink_first_edge(S& seq, P pred)
+      directed_adjacency_list<V, E, N>::unlink_first_edge(vertex x, S& seq, P pred)
       {
         auto i = find_if(seq, pred);
-        if (i != seq.end());
+        ORIGIN_GRAPH_SEARCH(x, instrument_impl::probes(seq, i));
+        if (i != seq.end())
           remove_edge(*i);
       }
 
   // Remove all edges connecting u to v. 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::remove_edges(vertex u, vertex v)
+    directed_adjacency_list<V, E, N>::remove_edges(vertex u, vertex v)
     {
       if (out_degree(u) <= in_degree(v))
         unlink_out_edges(u, v);
@@ -608,40 +915,44 @@ namespace origin
         unlink_in_edges(u, v);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::unlink_out_edges(vertex u, vertex v)
+    directed_adjacency_list<V, E, N>::unlink_out_edges(vertex u, vertex v)
     {
       using P = has_target<this_type>;
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
-      unlink_multi_edge(un.out(), vn.in(), P(*this, v));
+      unlink_multi_edge(u, un.out(), v, vn.in(), P(*this, v));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::unlink_in_edges(vertex u, vertex v)
+    directed_adjacency_list<V, E, N>::unlink_in_edges(vertex u, vertex v)
     {
       using P = has_source<this_type>;
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
-      unlink_multi_edge(vn.in(), un.out(), P(*this, u));
+      unlink_multi_edge(v, vn.in(), u, un.out(), P(*this, u));
     }
 
-  // Remove all edges from seq1 that are connected to seq2. 
-  template<typename V, typename E>
+  // Remove all edges from seq1, the incidence list of x, that are connected
+  // to seq2, the incidence list of y.
+  template<typename V, typename E, typename N>
     template<typename S1, typename S2, typename P>
       inline void
-      directed_adjacency_list<V, E>::unlink_multi_edge(S1& seq1, S2& seq2, P pred)
+      directed_adjacency_list<V, E, N>::
+        unlink_multi_edge(vertex x, S1& seq1, vertex y, S2& seq2, P pred)
       {
         // Partition the 1st sequence by the given predicate into "save" and
         // "erase" components. 
         //
         // NOTE: We may want this to be a stable partition... not sure. It
         // seems like the saved edges are not reordered by the partitioning.
+        ORIGIN_GRAPH_SEARCH(x, seq1.size());
         auto i = partition(seq1, negate(pred));
         for (auto j = i; j != seq1.end(); ++j) {
           // Remove those edges from the in 2nd sequence.
+          ORIGIN_GRAPH_SEARCH(y, seq2.size());
           auto k = remove(seq2, *j);
           seq2.erase(k, seq2.end());
 
@@ -655,9 +966,9 @@ namespace origin
 
 
   // Remove all edges incident to the vertex v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::remove_edges(vertex v)
+    directed_adjacency_list<V, E, N>::remove_edges(vertex v)
     {
       vertex_node& vn = node(v);
       
@@ -672,12 +983,13 @@ namespace origin
       vn.in().clear();
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::unlink_target(edge e)
+    directed_adjacency_list<V, E, N>::unlink_target(edge e)
     {
       vertex_node& t = node(target(e));
       auto i = find(t.in(), e);
+      ORIGIN_GRAPH_SEARCH(target(e), instrument_impl::probes(t.in(), i));
       t.in().erase(i);
       edges_.erase(e);
     }
@@ -685,21 +997,22 @@ namespace origin
   // Note that loops will not result in the double erasure of an edge. The
   // edge is initially erased in unlink_source, and the erase operation
   // here will have no effect.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::unlink_source(edge e)
+    directed_adjacency_list<V, E, N>::unlink_source(edge e)
     {
       vertex_node& t = node(source(e));
       auto i = find(t.out(), e);
+      ORIGIN_GRAPH_SEARCH(source(e), instrument_impl::probes(t.out(), i));
       t.out().erase(i);
       edges_.erase(e);
     }
 
 
   // Remove all edges from a graph, making it empty.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    directed_adjacency_list<V, E>::remove_edges()
+    directed_adjacency_list<V, E, N>::remove_edges()
     {
       for (vertex_node& n : verts_) {
         n.out().clear();
@@ -708,34 +1021,152 @@ namespace origin
       edges_.clear();
     }
 
+  // Apply a batch of edge updates: add an edge from u to v with the value x
+  // for each insertion (u, v, x), and remove one edge from u to v, if any,
+  // for each deletion (u, v). Deletions apply only to the edges in the graph
+  // before the batch. The updates are grouped by vertex, and the incidence
+  // lists of the affected vertices are rewritten in parallel (see
+  // [graph.batch]). Only the affected vertices are recorded as changed for
+  // the next commit.
+  template<typename V, typename E, typename N>
+    void
+    directed_adjacency_list<V, E, N>::
+      apply_batch(const std::vector<edge_insertion>& insertions,
+                  const std::vector<edge_deletion>& deletions,
+                  std::size_t threads)
+    {
+      std::size_t k = insertions.size();
+      std::vector<std::size_t> source(k), target(k);
+      std::vector<edge> added(k);
+      ORIGIN_GRAPH_COUNT(add_edge, k);
+      for (std::size_t i = 0; i < k; ++i) {
+        const edge_insertion& x = insertions[i];
+        source[i] = std::get<0>(x);
+        target[i] = std::get<1>(x);
+        added[i] = edges_.emplace(std::get<0>(x), std::get<1>(x), std::get<2>(x));
+      }
+
+      // Vertex nodes are looked up through a non-const reference, which
+      // records the vertex as changed, before the lists are rewritten. The
+      // edges are only read while the lists are rewritten.
+      const edge_set& es = edges_;
+      std::vector<edge> removed = batch_impl::apply(
+        source, target, added, deletions,
+        [this](std::size_t v) -> vertex_node& { return verts_[v]; },
+        [&es](edge e) -> std::size_t { return es[e].target(); },
+        threads);
+      ORIGIN_GRAPH_COUNT(remove_edge, removed.size());
+      for (edge e : removed)
+        edges_.erase(e);
+    }
+
+  // Publish the current state of the graph as a new version. Only vertices
+  // and edges modified since the previous commit are copied; the rest of
+  // the new version is shared with the previous one. Versions that are no
+  // longer pinned by a snapshot are reclaimed.
+  //
+  // Commits must be made by the thread that modifies the graph.
+  template<typename V, typename E, typename N>
+    void
+    directed_adjacency_list<V, E, N>::commit()
+    {
+      auto& store = versions_.writer();
+      const version_type* prev = store.current();
+      version_type* next = new version_type();
+      if (prev) {
+        next->verts = verts_.commit(prev->verts);
+        next->edges = edges_.commit(prev->edges);
+      } else {
+        next->verts = verts_.commit({});
+        next->edges = edges_.commit({});
+      }
+      store.publish(next);
+    }
+
+  // Return a snapshot of the most recently committed version of the graph.
+  // If the graph has never been committed, the snapshot is a null graph.
+  // This function may be called concurrently with modifications and commits
+  // of the graph.
+  template<typename V, typename E, typename N>
+    inline auto
+    directed_adjacency_list<V, E, N>::snapshot() const -> snapshot_type
+    {
+      return snapshot_type(versions_.get());
+    }
+
+  // Returns the memory used by the graph, as described in [graph.memory].
+  template<typename V, typename E, typename N>
+    graph_memory
+    directed_adjacency_list<V, E, N>::memory_usage() const
+    {
+      using namespace memory_impl;
+      using adjacency_list_impl::pool_memory;
+      constexpr std::size_t pv = payload_size<V>();
+      constexpr std::size_t pe = payload_size<E>();
+      constexpr std::size_t sv = sizeof(vertex_node);
+      constexpr std::size_t se = sizeof(edge_node);
+      pool_memory vm = verts_.memory_usage();
+      pool_memory em = edges_.memory_usage();
+      graph_memory m {};
+      m.vertices = share(vm.elements, sv - pv, sv);
+      m.edges = share(em.elements, se - pe, se);
+      m.payload = share(vm.elements, pv, sv) + share(em.elements, pe, se);
+      m.free_list = vm.links + vm.free_list + vm.tracking
+                  + em.links + em.free_list + em.tracking;
+      for (const vertex_node& n : verts_)
+        m.incidence += block(n.out()) + block(n.in());
+      return m;
+    }
+
+  // Release the capacity reserved beyond the last node of the vertex and
+  // edge pools, and beyond the size of each incidence list. Only vertices
+  // whose lists are shrunk are recorded as changed for the next commit.
+  template<typename V, typename E, typename N>
+    void
+    directed_adjacency_list<V, E, N>::shrink_to_fit()
+    {
+      verts_.shrink_to_fit();
+      edges_.shrink_to_fit();
+      const vertex_set& vs = verts_;
+      for (vertex v : vertices()) {
+        const vertex_node& n = vs[v];
+        if (n.out().capacity() != n.out().size() ||
+            n.in().capacity() != n.in().size()) {
+          vertex_node& x = node(v);
+          x.out().shrink_to_fit();
+          x.in().shrink_to_fit();
+        }
+      }
+    }
+
   // Retrun a range over the vertex set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::vertices() const -> vertex_range
+    directed_adjacency_list<V, E, N>::vertices() const -> vertex_range
     {
       return {vertex_iter(verts_.begin()), vertex_iter(verts_.end())};
     }
 
   // Return a range over the edge set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::edges() const -> edge_range
+    directed_adjacency_list<V, E, N>::edges() const -> edge_range
     {
       return {edge_iter(edges_.begin()), edge_iter(edges_.end())};
     }
 
   // Return a range over the out edges of the vertex v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::out_edges(vertex v) const -> incidence_range
+    directed_adjacency_list<V, E, N>::out_edges(vertex v) const -> incidence_range
     {
       const vertex_node& vn = node(v);
       return {incidence_iter(vn.begin_out()), incidence_iter(vn.end_out())};
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    directed_adjacency_list<V, E>::in_edges(vertex v) const -> incidence_range
+    directed_adjacency_list<V, E, N>::in_edges(vertex v) const -> incidence_range
     {
       const vertex_node& vn = node(v);
       return {incidence_iter(vn.begin_in()), incidence_iter(vn.end_in())};
@@ -761,12 +1192,12 @@ namespace origin
     
     // A vertex in an undirected adjacency list is simply a list of incident
     // edges. No distinction is made between in or out edges.
-    template<typename V>
+    template<typename V, typename N>
       struct vertex
       {
         using value_type = V;
-        using iterator = typename edge_list::iterator;
-        using const_iterator = typename edge_list::const_iterator;
+        using iterator = typename edge_list<N>::iterator;
+        using const_iterator = typename edge_list<N>::const_iterator;
     
         vertex()
           : data()
@@ -774,12 +1205,12 @@ namespace origin
 
         template<typename... Args>
           vertex(Args&&... args) 
-            : data(edge_list{}, std::forward<Args>(args)...)
+            : data(edge_list<N>{}, std::forward<Args>(args)...)
           { }
 
         // Returns the out ege list
-        edge_list&       edges()       { return std::get<0>(data); }
-        const edge_list& edges() const { return std::get<0>(data); }
+        edge_list<N>&       edges()       { return std::get<0>(data); }
+        const edge_list<N>& edges() const { return std::get<0>(data); }
         
         // Returns the user-supplied data object.
         V&       value()       { return std::get<1>(data); }
@@ -797,19 +1228,20 @@ namespace origin
         const_iterator end() const   { return edges().end(); }
 
       public:
-        std::tuple<edge_list, V> data;
+        std::tuple<edge_list<N>, V> data;
       };
 
-    template<typename V>
+    template<typename V, typename N>
       inline void
-      vertex<V>::insert(std::size_t e)
+      vertex<V, N>::insert(std::size_t e)
       {
+        ORIGIN_GRAPH_GROWTH(edges());
         edges().push_back(e);
       }
 
-    template<typename V>
+    template<typename V, typename N>
       inline void
-      vertex<V>::erase(std::size_t e)
+      vertex<V, N>::erase(std::size_t e)
       {
         auto i = std::find(begin(), end(), e);
         if (i != end())
@@ -817,43 +1249,43 @@ namespace origin
       }
 
     // A vertex set is a pool of vertices.
-    template<typename V>
-      using vertex_pool = pool<vertex<V>>;
+    template<typename V, typename N>
+      using vertex_pool = pool<vertex<V, N>, N>;
 
     // An alias for the vertex iterator.
-    template<typename V>
-      using vertex_iterator = handle_iterator<vertex_pool<V>, vertex_handle>;
+    template<typename V, typename N>
+      using vertex_iterator = handle_iterator<vertex_pool<V, N>, basic_vertex_handle<N>>;
 
     // An alias for the vertex range.
-    template<typename V>
-      using vertex_range = bounded_range<vertex_iterator<V>>;
+    template<typename V, typename N>
+      using vertex_range = bounded_range<vertex_iterator<V, N>>;
 
   } // namespace undirected_adjacency_list_impl
 
 
   // Implementation of the undirected adjacency list.
-  template<typename V = empty_t, typename E = empty_t>
+  template<typename V = empty_t, typename E = empty_t, typename N = std::size_t>
     class undirected_adjacency_list
     {
-      using this_type = undirected_adjacency_list<V, E>;
+      using this_type = undirected_adjacency_list<V, E, N>;
 
-      using vertex_node = undirected_adjacency_list_impl::vertex<V>;
-      using vertex_set = undirected_adjacency_list_impl::vertex_pool<V>;
-      using vertex_iter = undirected_adjacency_list_impl::vertex_iterator<V>;
+      using vertex_node = undirected_adjacency_list_impl::vertex<V, N>;
+      using vertex_set = undirected_adjacency_list_impl::vertex_pool<V, N>;
+      using vertex_iter = undirected_adjacency_list_impl::vertex_iterator<V, N>;
 
-      using edge_node = adjacency_list_impl::edge<E>;
-      using edge_set = adjacency_list_impl::edge_pool<E>;
-      using edge_iter = adjacency_list_impl::edge_iterator<E>;
+      using edge_node = adjacency_list_impl::edge<E, N>;
+      using edge_set = adjacency_list_impl::edge_pool<E, N>;
+      using edge_iter = adjacency_list_impl::edge_iterator<E, N>;
 
-      using incidence_iter = adjacency_list_impl::incidence_iterator;
+      using incidence_iter = adjacency_list_impl::incidence_iterator<N>;
     public:
-      using vertex = vertex_handle;
-      using vertex_range = undirected_adjacency_list_impl::vertex_range<V>;
+      using vertex = basic_vertex_handle<N>;
+      using vertex_range = undirected_adjacency_list_impl::vertex_range<V, N>;
 
-      using edge = edge_handle;
-      using edge_range = adjacency_list_impl::edge_range<E>;
+      using edge = basic_edge_handle<N>;
+      using edge_range = adjacency_list_impl::edge_range<E, N>;
 
-      using incidence_range = adjacency_list_impl::incidence_range;
+      using incidence_range = adjacency_list_impl::incidence_range<N>;
 
 
       // Observers
@@ -909,6 +1341,10 @@ namespace origin
       void remove_edges(vertex v);
       void remove_edges();
 
+      // Memory
+      graph_memory memory_usage() const;
+      void         shrink_to_fit();
+
       // Iterators
       vertex_range    vertices() const;
       edge_range      edges() const;
@@ -925,7 +1361,7 @@ namespace origin
       edge find_edge(vertex u, vertex v) const;
 
       template<typename S, typename P>
-        edge find_endpoints(const S& seq, P pred) const;
+        edge find_endpoints(vertex x, const S& seq, P pred) const;
 
       void link_edge(vertex u, vertex v, edge e);
       void unlink_loop(vertex v, edge e);
@@ -947,9 +1383,9 @@ namespace origin
     };
 
   // Returns true if the an edge {u, v} is in the graph.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::operator()(vertex u, vertex v) const -> edge
+    undirected_adjacency_list<V, E, N>::operator()(vertex u, vertex v) const -> edge
     {
       if (degree(u) <= degree(v))
         return find_edge(u, v);
@@ -963,114 +1399,116 @@ namespace origin
   // Note that, if u and v are connected, then the edge was added as either
   // (u, v) or (v, u). We prefer to search the vertex with the smaller degree
   // for evidence of either construction.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::find_edge(vertex u, vertex v) const -> edge
+    undirected_adjacency_list<V, E, N>::find_edge(vertex u, vertex v) const -> edge
     {
       using P = has_endpoints<this_type>;
       const vertex_node& n = node(v);
-      return find_endpoints(n.edges(), P(*this, u, v));
+      return find_endpoints(v, n.edges(), P(*this, u, v));
     }
 
   // Return an iterator to the the first incident edge whose end (either
   // source or target) is equal to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename S, typename P>
       inline auto
-      undirected_adjacency_list<V, E>::
-        find_endpoints(const S& seq, P pred) const -> edge
+      undirected_adjacency_list<V, E, N>::
+        find_endpoints(vertex x, const S& seq, P pred) const -> edge
       {
         auto i = find_if(seq, pred);
+        ORIGIN_GRAPH_SEARCH(x, instrument_impl::probes(seq, i));
         return i == seq.end() ? edge() : *i;
       }
 
 
   // Add a vertex to the graph, returning a handle to the new object. If
   // V is a user-supplied type, its value is default constructed.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::add_vertex() -> vertex
+    undirected_adjacency_list<V, E, N>::add_vertex() -> vertex
     {
       return verts_.emplace();
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::add_vertex(V&& x) -> vertex
+    undirected_adjacency_list<V, E, N>::add_vertex(V&& x) -> vertex
     {
       return verts_.emplace(std::move(x));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::add_vertex(const V& x) -> vertex
+    undirected_adjacency_list<V, E, N>::add_vertex(const V& x) -> vertex
     {
       return verts_.emplace(x);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename... Args>
       inline auto
-      undirected_adjacency_list<V, E>::emplace_vertex(Args&&... args) -> vertex
+      undirected_adjacency_list<V, E, N>::emplace_vertex(Args&&... args) -> vertex
       {
         return verts_.emplace(std::forward<Args>(args)...);
       }
 
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::remove_vertex(vertex v)
+    undirected_adjacency_list<V, E, N>::remove_vertex(vertex v)
     {
       remove_edges(v);
       verts_.erase(v);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::remove_vertices()
+    undirected_adjacency_list<V, E, N>::remove_vertices()
     {
       edges_.clear();
       verts_.clear();
     }
 
   // Add a defaul edge from u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::add_edge(vertex u, vertex v) -> edge
+    undirected_adjacency_list<V, E, N>::add_edge(vertex u, vertex v) -> edge
     {
       return emplace_edge(u, v);
     }
 
   // Move x into an edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::add_edge(vertex u, vertex v, E&& x) -> edge
+    undirected_adjacency_list<V, E, N>::add_edge(vertex u, vertex v, E&& x) -> edge
     {
       return emplace_edge(u, v, std::move(x));
     }
 
   // Copy x into an edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::add_edge(vertex u, vertex v, const E& x) -> edge
+    undirected_adjacency_list<V, E, N>::add_edge(vertex u, vertex v, const E& x) -> edge
     {
       return emplace_edge(u, v, x);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename... Args>
       inline auto
-      undirected_adjacency_list<V, E>::
+      undirected_adjacency_list<V, E, N>::
         emplace_edge(vertex u, vertex v, Args&&... args) -> edge
       {
+        ORIGIN_GRAPH_COUNT(add_edge, 1);
         edge e = edges_.emplace(u, v, std::forward<Args>(args)...);
         link_edge(u, v, e);
         return e;
       }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::link_edge(vertex u, vertex v, edge e)
+    undirected_adjacency_list<V, E, N>::link_edge(vertex u, vertex v, edge e)
     {
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
@@ -1079,9 +1517,9 @@ namespace origin
     }
 
   // Remove the specified edge from the graph.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::remove_edge(edge e)
+    undirected_adjacency_list<V, E, N>::remove_edge(edge e)
     {
       vertex u = source(e);
       vertex v = target(e);
@@ -1092,31 +1530,33 @@ namespace origin
     }
 
   // Unlink the given edge from the vertex, when the edge is looped.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::unlink_loop(vertex v, edge e)
+    undirected_adjacency_list<V, E, N>::unlink_loop(vertex v, edge e)
     {
       vertex_node& n = node(v);
       auto i = find(n.edges(), e);
+      ORIGIN_GRAPH_SEARCH(v, instrument_impl::probes(n.edges(), i));
       if (i != n.end())
         erase_loop(n.edges(), i);
     }
 
   // Erase the loop edge referred to by the edge list iterator i.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename S, typename I>
       inline void
-      undirected_adjacency_list<V, E>::erase_loop(S& seq, I iter)
+      undirected_adjacency_list<V, E, N>::erase_loop(S& seq, I iter)
       {
+        ORIGIN_GRAPH_COUNT(remove_edge, 1);
         edges_.erase(*iter);
         seq.erase(iter, std::next(iter, 2));
       }
 
   // Unlink the given edge from the source and target vertices, and erase
   // it from the edge set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::unlink_edge(vertex u, vertex v, edge e)
+    undirected_adjacency_list<V, E, N>::unlink_edge(vertex u, vertex v, edge e)
     {
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
@@ -1124,26 +1564,29 @@ namespace origin
       // Find the edge in the corresponding edge lists, and then erase them.
       auto i = find(un.edges(), e);
       auto j = find(vn.edges(), e);
+      ORIGIN_GRAPH_SEARCH(u, instrument_impl::probes(un.edges(), i));
+      ORIGIN_GRAPH_SEARCH(v, instrument_impl::probes(vn.edges(), j));
       if (i != un.end())
         erase_edge(un.edges(), i, vn.edges(), j);
     }
 
   // Erase the edge e from the graph by removing the endpoints and the edge
   // object.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     template<typename S, typename I>
       inline void
-      undirected_adjacency_list<V, E>::erase_edge(S& seq1, I iter1, S& seq2, I iter2)
+      undirected_adjacency_list<V, E, N>::erase_edge(S& seq1, I iter1, S& seq2, I iter2)
         {
+          ORIGIN_GRAPH_COUNT(remove_edge, 1);
           edges_.erase(*iter1);
           seq1.erase(iter1);
           seq2.erase(iter2);
         }
 
   // Remove the first edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::remove_edge(vertex u, vertex v)
+    undirected_adjacency_list<V, E, N>::remove_edge(vertex u, vertex v)
     {
       if (u == v)
         unlink_first_loop(v);
@@ -1154,21 +1597,22 @@ namespace origin
     }
 
   // Find and remove the first loop connecting v to itself.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::unlink_first_loop(vertex v)
+    undirected_adjacency_list<V, E, N>::unlink_first_loop(vertex v)
     {
       using P = has_endpoint<this_type>;
       vertex_node& n = node(v); 
       auto i = find_if(n.edges(), P(*this, v));
+      ORIGIN_GRAPH_SEARCH(v, instrument_impl::probes(n.edges(), i));
       if (i != n.end())
         erase_loop(n.edges(), i);
     }
 
   // Find and remove the first edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::unlink_first_edge(vertex u, vertex v)
+    undirected_adjacency_list<V, E, N>::unlink_first_edge(vertex u, vertex v)
     {
       using P = has_endpoints<this_type>;
       vertex_node& un = node(u);
@@ -1177,20 +1621,22 @@ namespace origin
       // Find the first edge with u and v as endpoints. If we didn't find
       // it, just return.
       auto i = find_if(un.edges(), P(*this, u, v));
+      ORIGIN_GRAPH_SEARCH(u, instrument_impl::probes(un.edges(), i));
       if (i == un.end())
         return;
       
       // Find the corresponding edge in v's list. Note that *i must exist
       // in the incidence list of vn, otherwise, the graph is ill-formed.
       auto j = find(vn.begin(), vn.end(), *i);
+      ORIGIN_GRAPH_SEARCH(v, instrument_impl::probes(vn.edges(), j));
       assert(j != vn.end());
       erase_edge(un.edges(), i, vn.edges(), j);
     }
 
   // Remove all edges connecting u to v. 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::remove_edges(vertex u, vertex v)
+    undirected_adjacency_list<V, E, N>::remove_edges(vertex u, vertex v)
     {
       if (u == v)
         unlink_multi_loop(u);
@@ -1198,26 +1644,29 @@ namespace origin
         unlink_multi_edge(u, v);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::unlink_multi_loop(vertex v)
+    undirected_adjacency_list<V, E, N>::unlink_multi_loop(vertex v)
     {
       using P = is_looped<this_type>;
       vertex_node& n = node(v);
+      ORIGIN_GRAPH_SEARCH(v, n.edges().size());
       auto i = partition(n, negate(P(*this, v)));
       for (auto j = i; j != n.end(); advance(j, 2))
         edges_.erase(*j);
       n.edges().erase(i, n.end());
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::unlink_multi_edge(vertex u, vertex v)
+    undirected_adjacency_list<V, E, N>::unlink_multi_edge(vertex u, vertex v)
     {
       using P = has_endpoints<this_type>;
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
 
+      ORIGIN_GRAPH_SEARCH(u, un.edges().size());
+      ORIGIN_GRAPH_SEARCH(v, vn.edges().size());
       auto i = partition(un.edges(), negate(P(*this, u, v)));
       auto j = partition(vn.edges(), negate(P(*this, v, u)));
       for (auto k = i; k != un.end(); ++k)
@@ -1228,9 +1677,9 @@ namespace origin
 
 
   // Remove all edges incident to the vertex v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::remove_edges(vertex v)
+    undirected_adjacency_list<V, E, N>::remove_edges(vertex v)
     {
       vertex_node& vn = node(v);
       
@@ -1246,8 +1695,10 @@ namespace origin
           edges_.erase(*i);
           std::advance(i, 2);
         } else {
-          vertex_node& n = node(opposite(*this, *i, v));
+          vertex u = opposite(*this, *i, v);
+          vertex_node& n = node(u);
           auto j = find(n.edges(), *i);
+          ORIGIN_GRAPH_SEARCH(u, instrument_impl::probes(n.edges(), j));
           if (j != n.end()) {
             n.edges().erase(j);
             edges_.erase(*i);
@@ -1260,35 +1711,78 @@ namespace origin
 
 
   // Remove all edges from a graph, making it empty.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline void
-    undirected_adjacency_list<V, E>::remove_edges()
+    undirected_adjacency_list<V, E, N>::remove_edges()
     {
       for (vertex_node& n : verts_)
         n.edges().clear();
       edges_.clear();
     }
 
+  // Returns the memory used by the graph, as described in [graph.memory].
+  template<typename V, typename E, typename N>
+    graph_memory
+    undirected_adjacency_list<V, E, N>::memory_usage() const
+    {
+      using namespace memory_impl;
+      using adjacency_list_impl::pool_memory;
+      constexpr std::size_t pv = payload_size<V>();
+      constexpr std::size_t pe = payload_size<E>();
+      constexpr std::size_t sv = sizeof(vertex_node);
+      constexpr std::size_t se = sizeof(edge_node);
+      pool_memory vm = verts_.memory_usage();
+      pool_memory em = edges_.memory_usage();
+      graph_memory m {};
+      m.vertices = share(vm.elements, sv - pv, sv);
+      m.edges = share(em.elements, se - pe, se);
+      m.payload = share(vm.elements, pv, sv) + share(em.elements, pe, se);
+      m.free_list = vm.links + vm.free_list + vm.tracking
+                  + em.links + em.free_list + em.tracking;
+      for (const vertex_node& n : verts_)
+        m.incidence += block(n.edges());
+      return m;
+    }
+
+  // Release the capacity reserved beyond the last node of the vertex and
+  // edge pools, and beyond the size of each incidence list. Only vertices
+  // whose lists are shrunk are recorded as changed for the next commit.
+  template<typename V, typename E, typename N>
+    void
+    undirected_adjacency_list<V, E, N>::shrink_to_fit()
+    {
+      verts_.shrink_to_fit();
+      edges_.shrink_to_fit();
+      const vertex_set& vs = verts_;
+      for (vertex v : vertices()) {
+        const vertex_node& n = vs[v];
+        if (n.edges().capacity() != n.edges().size()) {
+          vertex_node& x = node(v);
+          x.edges().shrink_to_fit();
+        }
+      }
+    }
+
   // Retrun a range over the vertex set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::vertices() const -> vertex_range
+    undirected_adjacency_list<V, E, N>::vertices() const -> vertex_range
     {
       return {vertex_iter(verts_.begin()), vertex_iter(verts_.end())};
     }
 
   // Return a range over the edge set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::edges() const -> edge_range
+    undirected_adjacency_list<V, E, N>::edges() const -> edge_range
     {
       return {edge_iter(edges_.begin()), edge_iter(edges_.end())};
     }
 
   // Return a range over the out edges of the vertex v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N>
     inline auto
-    undirected_adjacency_list<V, E>::edges(vertex v) const -> incidence_range
+    undirected_adjacency_list<V, E, N>::edges(vertex v) const -> incidence_range
     {
       const vertex_node& vn = node(v);
       return {incidence_iter(vn.begin()), incidence_iter(vn.end())};
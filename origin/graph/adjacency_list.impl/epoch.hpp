@@ -0,0 +1,283 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+namespace origin
+{
+  namespace adjacency_list_impl
+  {
+    // ---------------------------------------------------------------------- //
+    //                              Epoch Domain
+    //
+    // The epoch domain implements epoch-based reclamation for objects that
+    // are published by a single writer and read by any number of concurrent
+    // readers. A reader enters the domain by claiming a slot and pinning the
+    // current global epoch in that slot. Slots are allocated in blocks that
+    // are chained as needed, so any number of readers (or snapshots held by
+    // one thread) can be in the domain at once. The writer
+    // advances the global epoch whenever it retires an object, and an object
+    // retired in epoch r may be destroyed only when every pinned slot holds
+    // an epoch greater than r.
+    //
+    // All operations on the epoch counter and the slots are sequentially
+    // consistent. A reader that observes a published object must have pinned
+    // its slot before the writer retired that object, and so the writer will
+    // see the pin when it scans the slots.
+    //
+    // A pinned value of 0 denotes a free slot. Epochs start at 1. Blocks are
+    // only released with the domain.
+    class epoch_domain
+    {
+    public:
+      // The number of slots per block.
+      static constexpr std::size_t slots = 64;
+
+      epoch_domain();
+      ~epoch_domain();
+
+      epoch_domain(const epoch_domain&) = delete;
+      epoch_domain& operator=(const epoch_domain&) = delete;
+
+      // Reader operations
+      std::size_t enter();
+      void leave(std::size_t n);
+
+      // Writer operations
+      std::uint64_t advance();
+      std::uint64_t horizon() const;
+
+    private:
+      struct block
+      {
+        block() : next(nullptr)
+        {
+          for (auto& p : pinned)
+            p.store(0);
+        }
+
+        std::array<std::atomic<std::uint64_t>, slots> pinned;
+        std::atomic<block*> next;
+      };
+
+      std::atomic<std::uint64_t> epoch_;
+      block head_;
+    };
+
+    inline
+    epoch_domain::epoch_domain()
+      : epoch_(1)
+    { }
+
+    inline
+    epoch_domain::~epoch_domain()
+    {
+      block* b = head_.next.load();
+      while (b) {
+        block* n = b->next.load();
+        delete b;
+        b = n;
+      }
+    }
+
+    // Claim a free slot and pin the current epoch in it, returning the index
+    // of the claimed slot. If every slot is taken, a new block is appended
+    // to the chain with its first slot already pinned, so that the writer
+    // sees the pin as soon as it can reach the block.
+    inline std::size_t
+    epoch_domain::enter()
+    {
+      block* b = &head_;
+      for (std::size_t base = 0; ; base += slots) {
+        for (std::size_t n = 0; n < slots; ++n) {
+          std::uint64_t free = 0;
+          if (b->pinned[n].compare_exchange_strong(free, epoch_.load()))
+            return base + n;
+        }
+        block* next = b->next.load();
+        if (!next) {
+          block* x = new block();
+          x->pinned[0].store(epoch_.load());
+          if (b->next.compare_exchange_strong(next, x))
+            return base + slots;
+          delete x;
+        }
+        b = next;
+      }
+    }
+
+    // Release the nth slot.
+    inline void
+    epoch_domain::leave(std::size_t n)
+    {
+      block* b = &head_;
+      for (; n >= slots; n -= slots)
+        b = b->next.load();
+      assert(b);
+      b->pinned[n].store(0);
+    }
+
+    // Advance the global epoch, returning the epoch that just ended. Objects
+    // retired by the writer are tagged with this value.
+    inline std::uint64_t
+    epoch_domain::advance() { return epoch_.fetch_add(1); }
+
+    // Returns the least epoch pinned by any reader or, if no readers are in
+    // the domain, the current epoch. Objects retired before the horizon are
+    // no longer reachable by any reader.
+    inline std::uint64_t
+    epoch_domain::horizon() const
+    {
+      std::uint64_t h = epoch_.load();
+      for (const block* b = &head_; b; b = b->next.load())
+        for (const auto& p : b->pinned) {
+          std::uint64_t e = p.load();
+          if (e != 0 && e < h)
+            h = e;
+        }
+      return h;
+    }
+
+
+    // ---------------------------------------------------------------------- //
+    //                              Version Store
+    //
+    // The version store holds the versions of a data structure that have been
+    // published by its (single) writer. Readers pin the current version, and
+    // the writer publishes new versions and reclaims retired versions once no
+    // reader can still refer to them.
+    //
+    // Each version is owned by the store. A version is retired when it is
+    // replaced by a newer version, and it is destroyed by the first call to
+    // publish() or collect() after all readers that pinned it have left.
+    template<typename T>
+      class version_store
+      {
+      public:
+        version_store();
+        ~version_store();
+
+        version_store(const version_store&) = delete;
+        version_store& operator=(const version_store&) = delete;
+
+        // Returns the current version. This must only be called by the writer.
+        const T* current() const { return current_.load(); }
+
+        // Reader operations
+        std::pair<std::size_t, const T*> pin() const;
+        void unpin(std::size_t n) const;
+
+        // Writer operations
+        void publish(T* x);
+        void collect();
+
+        // Returns the number of retired versions that have not been reclaimed.
+        std::size_t retired() const { return retired_.size(); }
+
+      private:
+        mutable epoch_domain domain_;
+        std::atomic<const T*> current_;
+        std::vector<std::pair<std::uint64_t, const T*>> retired_;
+      };
+
+    template<typename T>
+      inline
+      version_store<T>::version_store()
+        : current_(nullptr)
+      { }
+
+    // Note that the store must outlive all of the readers that have pinned
+    // one of its versions.
+    template<typename T>
+      inline
+      version_store<T>::~version_store()
+      {
+        for (auto& r : retired_)
+          delete r.second;
+        delete current_.load();
+      }
+
+    // Enter the epoch domain and return the slot and current version. The
+    // current version is loaded after the slot has been pinned.
+    template<typename T>
+      inline std::pair<std::size_t, const T*>
+      version_store<T>::pin() const
+      {
+        std::size_t n = domain_.enter();
+        return {n, current_.load()};
+      }
+
+    template<typename T>
+      inline void
+      version_store<T>::unpin(std::size_t n) const { domain_.leave(n); }
+
+    // Make x the current version, retiring the previous version.
+    template<typename T>
+      inline void
+      version_store<T>::publish(T* x)
+      {
+        const T* p = current_.exchange(x);
+        if (p)
+          retired_.emplace_back(domain_.advance(), p);
+        collect();
+      }
+
+    // Destroy each retired version that can no longer be reached by a reader.
+    template<typename T>
+      inline void
+      version_store<T>::collect()
+      {
+        std::uint64_t h = domain_.horizon();
+        auto i = std::partition(retired_.begin(), retired_.end(),
+                                [h](const std::pair<std::uint64_t, const T*>& r) {
+                                  return r.first >= h;
+                                });
+        for (auto j = i; j != retired_.end(); ++j)
+          delete j->second;
+        retired_.erase(i, retired_.end());
+      }
+
+
+    // ---------------------------------------------------------------------- //
+    //                              Version Control
+    //
+    // The version control object holds the (lazily allocated) version store
+    // of a graph. Copying a graph does not copy its published versions: the
+    // copy starts without a store, and the first commit on the copy allocates
+    // a new one.
+    template<typename T>
+      class version_control
+      {
+      public:
+        version_control() : store_(nullptr) { }
+        version_control(const version_control&) : store_(nullptr) { }
+        version_control& operator=(const version_control&) { return *this; }
+        ~version_control() { delete store_.load(); }
+
+        // Returns the store, or nullptr if nothing has been committed.
+        const version_store<T>* get() const { return store_.load(); }
+
+        // Returns the store, allocating it if needed. Only the writer may
+        // call this function.
+        version_store<T>& writer();
+
+      private:
+        std::atomic<version_store<T>*> store_;
+      };
+
+    template<typename T>
+      inline version_store<T>&
+      version_control<T>::writer()
+      {
+        version_store<T>* s = store_.load();
+        if (!s) {
+          s = new version_store<T>();
+          store_.store(s);
+        }
+        return *s;
+      }
+
+  } // namespace adjacency_list_impl
+} // namespace origin
@@ -9,8 +9,26 @@ namespace origin
 {
   namespace adjacency_list_impl
   {
-    template<typename T> class pool_node;
-    template<typename T> class pool_iterator;
+    template<typename T, typename N = std::size_t> class pool_node;
+    template<typename T, typename N = std::size_t> class pool_iterator;
+    template<typename T> struct pool_version;
+
+    // The memory usage of a pool: its elements, the links between its live
+    // nodes, its free index queue, and its change tracking bits. Each dead
+    // node is reserved but not used. The free index queue does not expose its
+    // capacity, so its reserved bytes are the bytes it uses.
+    struct pool_memory
+    {
+      memory_block total() const
+      {
+        return elements + links + free_list + tracking;
+      }
+
+      memory_block elements;
+      memory_block links;
+      memory_block free_list;
+      memory_block tracking;
+    };
 
     // ---------------------------------------------------------------------- //
     //                                 Pool
@@ -52,24 +70,34 @@ namespace origin
     // requirements. In particular, it must maintain the correspondence between
     // indices and the objects that they are mapped to. We also have to
     // provide efficient iteration over elements in the pool.
-    template<typename T>
+    //
+    // A pool can also be versioned. A call to commit() produces an immutable
+    // copy of the pool's live elements (see pool_version). After the first
+    // commit, the pool records the indexes of the elements that are inserted,
+    // erased, or accessed through a non-const reference, and the next commit
+    // copies only those elements; every other element, and every chunk of 64
+    // elements with no recorded changes, is shared with the previous version.
+    //
+    // The unsigned integer type N is the type of the indexes stored in the
+    // pool's links and free list. A pool can hold at most N(-1) elements.
+    template<typename T, typename N = std::size_t>
       class pool
       {
-        friend class pool_iterator<T>;
-        friend class pool_iterator<const T>;
+        friend class pool_iterator<T, N>;
+        friend class pool_iterator<const T, N>;
       public:
         using value_type = T;
-        using node_type = pool_node<T>;
+        using node_type = pool_node<T, N>;
 
-        using iterator       = pool_iterator<T>;
-        using const_iterator = pool_iterator<const T>;
+        using iterator       = pool_iterator<T, N>;
+        using const_iterator = pool_iterator<const T, N>;
 
         using list_type = std::vector<node_type>;
-        using queue_type = std::priority_queue<std::size_t, 
-                                               std::vector<std::size_t>, 
-                                               std::greater<size_t>>;
+        using queue_type = std::priority_queue<N, std::vector<N>, std::greater<N>>;
+
+        using version_type = pool_version<T>;
 
-        static constexpr std::size_t npos = node_type::npos;
+        static constexpr N npos = node_type::npos;
 
         // Observers
         bool empty() const;
@@ -84,6 +112,9 @@ namespace origin
         // Capacity
         std::size_t capacity() const;
         void reserve(std::size_t n);
+        void shrink_to_fit();
+
+        pool_memory memory_usage() const;
 
         // Element access
         T&       operator[](std::size_t n);
@@ -98,8 +129,11 @@ namespace origin
         void erase(std::size_t x);
         void clear();
 
+        // Versioning
+        version_type commit(const version_type& prev);
+
         // Iterators
-        iterator begin() { return iterator(this, head_); }
+        iterator begin() { touch_all(); return iterator(this, head_); }
         iterator end()   { return iterator(this, npos); }
         
         const_iterator begin() const { return const_iterator(this, head_); }
@@ -128,6 +162,9 @@ namespace origin
         // Returns true if the node n is alive.
         bool alive(std::size_t n) const { return node(n).valid(); }
 
+        // Returns the element at the nth position without recording a change.
+        const T& elem(std::size_t n) const { return node(n).get(); }
+
         // Insertion functions
         // These functions have their arguments forwarded as parameter packs
         // so I don't have to implement different versions of the same logic
@@ -151,106 +188,147 @@ namespace origin
         void reset_middle(std::size_t n);
         void recycle(std::size_t n);
 
+        // Change tracking
+        void touch(std::size_t n);
+        void touch_all();
+
       private:
+        // The change tracker records the indexes modified since the last
+        // commit. Trackers are not copied: a copied pool has no versions,
+        // so its next commit must copy every element.
+        struct tracker
+        {
+          tracker() : on(false) { }
+          tracker(const tracker&) : on(false) { }
+          tracker& operator=(const tracker&) { on = false; return *this; }
+
+          std::vector<std::uint64_t> touched; // One bit per index
+          bool on;                            // True after the first commit
+        };
 
         list_type  nodes_; // The actual node vector
         queue_type free_;  // The free index list
-        std::size_t head_; // Head of the live node list
-        std::size_t tail_; // Tail of the live node list
+        N          head_;  // Head of the live node list
+        N          tail_;  // Tail of the live node list
+        tracker    track_; // Indexes changed since the last commit
       };
 
     // Returns true if the pool contains no nodes.
-    template<typename T>
+    template<typename T, typename N>
       inline bool
-      pool<T>::empty() const { return size() == 0; }
+      pool<T, N>::empty() const { return size() == 0; }
 
     // Returns the number of nodes contained in the pool.
-    template<typename T>
+    template<typename T, typename N>
       inline std::size_t
-      pool<T>::size() const { return nodes_.size() - free_.size(); }
+      pool<T, N>::size() const { return nodes_.size() - free_.size(); }
 
     // Returns the objects in the data pool.
-    template<typename T>
+    template<typename T, typename N>
       inline auto
-      pool<T>::data() const -> const list_type& { return nodes_; }
+      pool<T, N>::data() const -> const list_type& { return nodes_; }
 
     // Returns the free index list.
-    template<typename T>
+    template<typename T, typename N>
       inline auto
-      pool<T>::free() const -> const queue_type& { return free_; }
+      pool<T, N>::free() const -> const queue_type& { return free_; }
 
     // Returns the capacity allocated to the pool.
-    template<typename T>
+    template<typename T, typename N>
       inline std::size_t
-      pool<T>::capacity() const { return nodes_.capacity(); }
+      pool<T, N>::capacity() const { return nodes_.capacity(); }
 
     // Reserve at least n objects of capacity.
-    template<typename T>
+    template<typename T, typename N>
+      inline void
+      pool<T, N>::reserve(std::size_t n) { nodes_.reserve(n); }
+
+    // Release the capacity reserved beyond the last node. Dead nodes are
+    // kept, since their indexes are reused by later insertions.
+    template<typename T, typename N>
       inline void
-      pool<T>::reserve(std::size_t n) { nodes_.reserve(n); }
+      pool<T, N>::shrink_to_fit() { nodes_.shrink_to_fit(); }
+
+    template<typename T, typename N>
+      pool_memory
+      pool<T, N>::memory_usage() const
+      {
+        using memory_impl::block;
+        constexpr std::size_t links = sizeof(node_type) - sizeof(T);
+        pool_memory m;
+        m.elements = {size() * sizeof(T), capacity() * sizeof(T)};
+        m.links = block(nodes_, links);
+        m.free_list = {free_.size() * sizeof(N), free_.size() * sizeof(N)};
+        m.tracking = block(track_.touched);
+        return m;
+      }
 
     // Returns a reference to the element in the nth position. This function
     // results in undefined behavior if the element at the nth position has been
     // previously erased.
-    template<typename T>
+    //
+    // Note that non-const access to an element records it as changed.
+    template<typename T, typename N>
       inline T&
-      pool<T>::operator[](std::size_t n)
+      pool<T, N>::operator[](std::size_t n)
       {
         assert(alive(n));
+        touch(n);
         return nodes_[n].get();
       }
 
-    template<typename T>
+    template<typename T, typename N>
       inline const T&
-      pool<T>::operator[](std::size_t n) const
+      pool<T, N>::operator[](std::size_t n) const
       {
         assert(alive(n));
         return nodes_[n].get();
       }
 
     // Move inser the value x into the pool.
-    template<typename T>
+    template<typename T, typename N>
       inline std::size_t
-      pool<T>::insert(T&& x)
+      pool<T, N>::insert(T&& x)
       {
-        if (free_.empty())
-          return append(std::move(x));
-        else
-          return reuse(std::move(x));
+        std::size_t n = free_.empty() ? append(std::move(x)) 
+                                      : reuse(std::move(x));
+        touch(n);
+        return n;
       }
 
     // Copy the value x into the vector. If there are dead indices, reuse
     // one. Otherwise, append the vertex.
-    template<typename T>
+    template<typename T, typename N>
       inline std::size_t
-      pool<T>::insert(const T& x)
+      pool<T, N>::insert(const T& x)
       {
-        if (free_.empty())
-          return append(x);
-        else 
-          return reuse(x);
+        std::size_t n = free_.empty() ? append(x) : reuse(x);
+        touch(n);
+        return n;
       }
 
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
       inline std::size_t
-      pool<T>::emplace(Args&&... args)
+      pool<T, N>::emplace(Args&&... args)
       {
-        if (free_.empty())
-          return append(std::forward<Args>(args)...);
-        else
-          return reuse(std::forward<Args>(args)...);
+        std::size_t n = free_.empty() ? append(std::forward<Args>(args)...)
+                                      : reuse(std::forward<Args>(args)...);
+        touch(n);
+        return n;
       }
 
 
 
     // Insert the value x at the end of the node list, returning the index
     // at which the object was stored.
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
         inline std::size_t
-        pool<T>::append(Args&&... args)
+        pool<T, N>::append(Args&&... args)
         {
+          ORIGIN_GRAPH_COUNT(pool_append, 1);
+          ORIGIN_GRAPH_GROWTH(nodes_);
           std::size_t n = nodes_.size();
           if (nodes_.empty())
             append_empty(std::forward<Args>(args)...);
@@ -261,10 +339,10 @@ namespace origin
 
     // Insert the value x into the front of the node list. This happens only
     // when the pool is completely empty.
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
         inline void
-        pool<T>::append_empty(Args&&... args)
+        pool<T, N>::append_empty(Args&&... args)
         {
           nodes_.emplace_back(0, 0, std::forward<Args>(args)...);
           head_ = 0;
@@ -279,10 +357,10 @@ namespace origin
     // Here, h is followed by 0 or more live nodes, and we are inserting into
     // x. There are no free indexes in the pool. Note that n == nodes_.size(),
     // whichn is the index of x.
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
         inline void
-        pool<T>::append_nonempty(std::size_t n, Args&&... args)
+        pool<T, N>::append_nonempty(std::size_t n, Args&&... args)
         {
           nodes_.emplace_back(tail_, n, std::forward<Args>(args)...);
           tail().next = n;
@@ -291,11 +369,12 @@ namespace origin
 
 
     // Reuse a free index to store the object x.
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
         inline std::size_t
-        pool<T>::reuse(Args&&... args)
+        pool<T, N>::reuse(Args&&... args)
         {
+          ORIGIN_GRAPH_COUNT(pool_reuse, 1);
           std::size_t n = take();
           if (n == 0)
             reuse_front(std::forward<Args>(args)...);
@@ -317,10 +396,10 @@ namespace origin
     // There is a special case when there are no live nodes. Here, we simply
     // overwrite the initial element. Here, we make p the both the head and
     // the tail.
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
         inline void
-        pool<T>::reuse_front(Args&&... args)
+        pool<T, N>::reuse_front(Args&&... args)
         {
           node_type& p = node(0);
           if (head_ != npos) {
@@ -345,10 +424,10 @@ namespace origin
     // number of live objects. Note that the node at n - 1 is always a live
     // object, q. Otherwise, n would not be the least free index. The next
     // live object, r, is directly accessible from q.
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
         inline void
-        pool<T>::reuse_middle(std::size_t n, Args&&... args)
+        pool<T, N>::reuse_middle(std::size_t n, Args&&... args)
         {
           node_type& p = node(n);
           node_type& q = node(n - 1);
@@ -368,10 +447,10 @@ namespace origin
     // other words, there are no free indexes before t. The case where h == t is
     // also possible. Second, it is always the case that n == t + 1 (I'm not
     // sure what that knowledge buys me though).
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
         inline void
-        pool<T>::reuse_end(std::size_t n, Args&&... args)
+        pool<T, N>::reuse_end(std::size_t n, Args&&... args)
         {
           node_type& p = node(n);
           p.assign(tail_, n, std::forward<Args>(args)...);
@@ -380,9 +459,9 @@ namespace origin
         }
 
     // Take the next free index from the free list.
-    template<typename T>
+    template<typename T, typename N>
       inline std::size_t
-      pool<T>::take()
+      pool<T, N>::take()
       {
         std::size_t n = free_.top();
         free_.pop();
@@ -391,20 +470,21 @@ namespace origin
 
     // Erase the element at the nth position in the pool, returning the index
     // n to the free list. If that element is not alive, do nothing.
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool<T>::erase(std::size_t n)
+      pool<T, N>::erase(std::size_t n)
       {
         assert(n < nodes_.size());
         if (alive(n)) {
           reset(n);
+          touch(n);
         }
       }
 
     // Reset the node at the nth position, depending on the value of n.
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool<T>::reset(std::size_t n)
+      pool<T, N>::reset(std::size_t n)
       {
         if (n == head_)
           reset_head(n);
@@ -428,9 +508,9 @@ namespace origin
     //
     // There is a special case when h == t, corresponding to the erasure of
     // the last live node. Both h and t are set to npos.
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool<T>::reset_head(std::size_t n)
+      pool<T, N>::reset_head(std::size_t n)
       {
         if (head_ != tail_) {
           node_type& p = next(head());
@@ -450,9 +530,9 @@ namespace origin
     // Note that there must be a previous element. If there is not, then
     // we must be removing the head, which is handled by reset_head. The 
     // previous live node is made the new tail.
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool<T>::reset_tail(std::size_t n)
+      pool<T, N>::reset_tail(std::size_t n)
       {
         node_type& p = prev(tail());
         p.next = tail().prev;
@@ -464,9 +544,9 @@ namespace origin
     //
     // Note that both the next and previos nodes must be valid. If not, the
     // node at the nth position would be either the head or the tail.
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool<T>::reset_middle(std::size_t n)
+      pool<T, N>::reset_middle(std::size_t n)
       {
         node_type& p = node(n); 
         prev(p).next = p.next;
@@ -476,25 +556,156 @@ namespace origin
 
     // Finally destroy the node at the nth position and return its index to the
     // free index list.
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool<T>::recycle(std::size_t n)
+      pool<T, N>::recycle(std::size_t n)
       {
         node(n).reset();
         free_.push(n);
       }
 
     // Reset the pool to its initial state.
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool<T>::clear()
+      pool<T, N>::clear()
       {
         // std::priority_queue does not have clear() method, so we have to
         // reset it by brute force.
         free_ = std::move(queue_type());
+        touch_all();
         nodes_.clear();
       }
 
+    // Record the nth index as changed.
+    template<typename T, typename N>
+      inline void
+      pool<T, N>::touch(std::size_t n)
+      {
+        if (track_.on) {
+          std::size_t w = n / 64;
+          if (w >= track_.touched.size())
+            track_.touched.resize(w + 1, 0);
+          track_.touched[w] |= std::uint64_t(1) << (n % 64);
+        }
+      }
+
+    // Record every index as changed.
+    template<typename T, typename N>
+      inline void
+      pool<T, N>::touch_all()
+      {
+        if (track_.on) {
+          track_.touched.resize((nodes_.size() + 63) / 64);
+          std::fill(track_.touched.begin(), track_.touched.end(), ~std::uint64_t(0));
+        }
+      }
+
+    // Return a new version of the pool that shares unchanged elements and
+    // chunks with prev. The version prev must have been returned by the
+    // previous call to commit() on this pool; the first commit ignores it.
+    template<typename T, typename N>
+      auto
+      pool<T, N>::commit(const version_type& prev) -> version_type
+      {
+        using chunk_type = typename version_type::chunk_type;
+        constexpr std::size_t k = version_type::chunk_size;
+
+        std::size_t n = nodes_.size();
+        std::size_t m = (n + k - 1) / k;
+
+        version_type v;
+        v.extent = n;
+        v.count = size();
+        v.chunks.reserve(m);
+        for (std::size_t c = 0; c < m; ++c) {
+          bool shared = track_.on && c < prev.chunks.size();
+          std::uint64_t t = ~std::uint64_t(0);
+          if (track_.on && c < track_.touched.size())
+            t = track_.touched[c];
+          else if (shared)
+            t = 0;
+
+          // Share the entire chunk if nothing in it has changed.
+          if (shared && t == 0) {
+            v.chunks.push_back(prev.chunks[c]);
+            continue;
+          }
+
+          // Otherwise, build a new chunk, copying only the changed elements.
+          std::shared_ptr<chunk_type> p = std::make_shared<chunk_type>();
+          for (std::size_t i = 0; i < k && c * k + i < n; ++i) {
+            std::size_t x = c * k + i;
+            if (!alive(x))
+              continue;
+            if (shared && !(t & (std::uint64_t(1) << i)))
+              (*p)[i] = (*prev.chunks[c])[i];
+            else
+              (*p)[i] = std::make_shared<const T>(elem(x));
+          }
+          v.chunks.push_back(std::move(p));
+        }
+
+        track_.touched.assign(m, 0);
+        track_.on = true;
+        return v;
+      }
+
+
+    // ---------------------------------------------------------------------- //
+    //                              Pool Version
+    //
+    // A pool version is an immutable copy of the live elements of a pool at
+    // the time of a commit. Elements are grouped into chunks of 64 indexes,
+    // and both chunks and elements are reference counted so that successive
+    // versions can share the parts of the pool that did not change. A dead
+    // index is represented by a null element.
+    template<typename T>
+      struct pool_version
+      {
+        static constexpr std::size_t chunk_size = 64;
+
+        using element_type = std::shared_ptr<const T>;
+        using chunk_type = std::array<element_type, chunk_size>;
+
+        pool_version() : extent(0), count(0) { }
+
+        // Returns true if the version contains no elements.
+        bool empty() const { return count == 0; }
+
+        // Returns the number of elements in the version.
+        std::size_t size() const { return count; }
+
+        // Returns a pointer to the element at the nth index or nullptr if
+        // that element was not alive when the version was committed.
+        const T* get(std::size_t n) const;
+
+        // Returns the least live index not less than n, or extent if there
+        // is no such index.
+        std::size_t next(std::size_t n) const;
+
+        std::vector<std::shared_ptr<const chunk_type>> chunks;
+        std::size_t extent; // One past the greatest index in the pool
+        std::size_t count;  // The number of live elements
+      };
+
+    template<typename T>
+      inline const T*
+      pool_version<T>::get(std::size_t n) const
+      {
+        if (n >= extent)
+          return nullptr;
+        return (*chunks[n / chunk_size])[n % chunk_size].get();
+      }
+
+    template<typename T>
+      inline std::size_t
+      pool_version<T>::next(std::size_t n) const
+      {
+        while (n < extent && !get(n))
+          ++n;
+        return n;
+      }
+
 
     // ---------------------------------------------------------------------- //
     //                                Pool Node
@@ -504,12 +715,12 @@ namespace origin
     // pool. The data buffer stores a possibly initialized value.
     //
     // A node is uninitialized when either of prev or next is the same as
-    // limit (i.e., size_t(-1)).
-    template<typename T>
+    // limit (i.e., N(-1)). The links have the index type N of the pool.
+    template<typename T, typename N>
       class pool_node
       {
       public:
-        static constexpr std::size_t npos = -1;
+        static constexpr N npos = -1;
 
         pool_node();
 
@@ -517,6 +728,14 @@ namespace origin
         template<typename... Args>
           pool_node(std::size_t p, std::size_t n, Args&&... args);
 
+        // Copy and move semantics
+        // The stored object (if any) is copied or moved, not its bytes.
+        pool_node(const pool_node& x);
+        pool_node(pool_node&& x)
+          noexcept(std::is_nothrow_move_constructible<T>::value);
+
+        pool_node& operator=(const pool_node& x);
+        pool_node& operator=(pool_node&& x);
 
         ~pool_node();
 
@@ -540,76 +759,123 @@ namespace origin
         void reset();
         void destroy();
 
-        std::size_t prev;
-        std::size_t next;
+        N prev;
+        N next;
         Aligned_storage<sizeof(T), alignof(T)> data;
       };
 
-    template<typename T>
-      pool_node<T>::pool_node() : prev(npos), next(npos) { }
+    template<typename T, typename N>
+      pool_node<T, N>::pool_node() : prev(npos), next(npos) { }
 
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
-        pool_node<T>::pool_node(std::size_t p, std::size_t n, Args&&... args)
+        pool_node<T, N>::pool_node(std::size_t p, std::size_t n, Args&&... args)
           : prev(p), next(n)
         {
           new (&data) T(std::forward<Args>(args)...);
         }
 
-    template<typename T>
-      pool_node<T>::~pool_node() { destroy(); }
+    template<typename T, typename N>
+      pool_node<T, N>::pool_node(const pool_node& x)
+        : prev(x.prev), next(x.next)
+      {
+        if (x.valid())
+          new (&data) T(x.get());
+      }
 
-    template<typename T>
+    template<typename T, typename N>
+      pool_node<T, N>::pool_node(pool_node&& x)
+        noexcept(std::is_nothrow_move_constructible<T>::value)
+        : prev(x.prev), next(x.next)
+      {
+        if (x.valid())
+          new (&data) T(std::move(x.get()));
+      }
+
+    template<typename T, typename N>
+      auto
+      pool_node<T, N>::operator=(const pool_node& x) -> pool_node&
+      {
+        if (this != &x) {
+          destroy();
+          prev = next = npos;
+          if (x.valid())
+            new (&data) T(x.get());
+          prev = x.prev;
+          next = x.next;
+        }
+        return *this;
+      }
+
+    template<typename T, typename N>
+      auto
+      pool_node<T, N>::operator=(pool_node&& x) -> pool_node&
+      {
+        if (this != &x) {
+          destroy();
+          prev = next = npos;
+          if (x.valid())
+            new (&data) T(std::move(x.get()));
+          prev = x.prev;
+          next = x.next;
+        }
+        return *this;
+      }
+
+    template<typename T, typename N>
+      pool_node<T, N>::~pool_node() { destroy(); }
+
+    template<typename T, typename N>
       inline bool
-      pool_node<T>::valid() const { return next != npos; }
+      pool_node<T, N>::valid() const { return next != npos; }
 
-    template<typename T>
+    template<typename T, typename N>
       inline T*
-      pool_node<T>::ptr() 
+      pool_node<T, N>::ptr() 
       { 
         assert(valid());
         return reinterpret_cast<T*>(&data); 
       }
 
-    template<typename T>
+    template<typename T, typename N>
       inline const T*
-      pool_node<T>::ptr() const 
+      pool_node<T, N>::ptr() const 
       { 
         assert(valid());
         return reinterpret_cast<const T*>(&data); 
       }
 
-    template<typename T>
+    template<typename T, typename N>
       inline T&
-      pool_node<T>::get() { return *ptr(); }
+      pool_node<T, N>::get() { return *ptr(); }
 
-    template<typename T>
+    template<typename T, typename N>
       inline const T&
-      pool_node<T>::get() const { return *ptr(); }
+      pool_node<T, N>::get() const { return *ptr(); }
 
-    template<typename T>
+    template<typename T, typename N>
       template<typename... Args>
         inline void
-        pool_node<T>::assign(std::size_t p, std::size_t n, Args&&... args)
+        pool_node<T, N>::assign(std::size_t p, std::size_t n, Args&&... args)
         {
-          prev = p;
-          next = n;
           destroy();
           new (&data) T(std::forward<Args>(args)...);
+          prev = p;
+          next = n;
         }
 
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool_node<T>::reset()
+      pool_node<T, N>::reset()
       {
         assert(valid());
         get().~T();
         prev = next = npos;
       }
 
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool_node<T>::destroy()
+      pool_node<T, N>::destroy()
       {
         if (valid())
           get().~T();
@@ -627,20 +893,20 @@ namespace origin
     // so that we can decrement it to reach the last element. Because the
     // current implementation uses a self-looped link to terminate the live
     // node list, we can't effectively define an "end" position.
-    template<typename T>
+    template<typename T, typename N>
       class pool_iterator
       {
       public:
         using value_type = Remove_const<T>;
-        using pool_type = If<Const<T>(), const pool<value_type>, pool<value_type>>;
-        using node_type = If<Const<T>(), const pool_node<value_type>, pool_node<value_type>>;
+        using pool_type = If<Const<T>(), const pool<value_type, N>, pool<value_type, N>>;
+        using node_type = If<Const<T>(), const pool_node<value_type, N>, pool_node<value_type, N>>;
 
         pool_iterator();
         pool_iterator(pool_type* p, std::size_t i);
 
         // Const conversion.
         template<typename U>
-          pool_iterator(const pool_iterator<U>& x)
+          pool_iterator(const pool_iterator<U, N>& x)
             : p_(x.container()), i_(x.index())
           { }
 
@@ -663,74 +929,74 @@ namespace origin
         void incr();
       
       public:
-        pool_type*  p_; // The pool
-        std::size_t i_; // The current index
+        pool_type* p_; // The pool
+        N          i_; // The current index
       };
 
-    template<typename T>
+    template<typename T, typename N>
       inline
-      pool_iterator<T>::pool_iterator()
+      pool_iterator<T, N>::pool_iterator()
         : p_(nullptr), i_(-1)
       { }
 
-    template<typename T>
+    template<typename T, typename N>
       inline
-      pool_iterator<T>::pool_iterator(pool_type* p, std::size_t i)
+      pool_iterator<T, N>::pool_iterator(pool_type* p, std::size_t i)
         : p_(p), i_(i)
       { }
 
-    template<typename T>
+    template<typename T, typename N>
       inline T&
-      pool_iterator<T>::operator*() const
+      pool_iterator<T, N>::operator*() const
       {
         return p_->node(i_).get();
       }
 
-    template<typename T>
+    template<typename T, typename N>
       inline T*
-      pool_iterator<T>::operator->() const
+      pool_iterator<T, N>::operator->() const
       {
         return p_->node(i_).get();
       }
 
-    template<typename T>
+    template<typename T, typename N>
       inline bool
-      pool_iterator<T>::operator==(const pool_iterator& x) const
+      pool_iterator<T, N>::operator==(const pool_iterator& x) const
       {
         assert(p_ == x.p_);
         return i_ == x.i_;
       }
 
-    template<typename T>
+    template<typename T, typename N>
       inline bool
-      pool_iterator<T>::operator!=(const pool_iterator& x) const
+      pool_iterator<T, N>::operator!=(const pool_iterator& x) const
       {
         return !operator==(x);
       }
 
-    template<typename T>
-      inline pool_iterator<T>&
-      pool_iterator<T>::operator++()
+    template<typename T, typename N>
+      inline pool_iterator<T, N>&
+      pool_iterator<T, N>::operator++()
       {
         incr();
         return *this;
       }
 
-    template<typename T>
-      inline pool_iterator<T>
-      pool_iterator<T>::operator++(int)
+    template<typename T, typename N>
+      inline pool_iterator<T, N>
+      pool_iterator<T, N>::operator++(int)
       {
         pool_iterator tmp = *this;
         incr();
         return tmp;
       }
 
-    template<typename T>
+    template<typename T, typename N>
       inline void
-      pool_iterator<T>::incr() 
+      pool_iterator<T, N>::incr() 
       {
         const node_type& n = p_->node(i_);
-        i_ = (n.next == i_ ? pool_node<T>::npos : n.next);
+        i_ = (n.next == i_ ? pool_node<T, N>::npos : n.next);
       }
 
   } // namespace adjacency_list_impl
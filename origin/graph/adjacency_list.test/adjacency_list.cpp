@@ -72,4 +72,22 @@ int main()
   check_remove_multi_edge<D>();
   check_remove_vertex_edges<D>();
   check_remove_all_edges<G>();
+
+  // 32 bit handles.
+  using G32 = undirected_adjacency_list<char, int, uint32_t>;
+  static_assert(sizeof(Vertex<G32>) == 4, "");
+  static_assert(sizeof(Edge<G32>) == 4, "");
+  check_default_init<G32>();
+  check_add_vertices<G32>();
+  check_add_edges<G32>();
+  check_remove_specific_edge<G32>();
+  check_remove_first_multi_edge<G32>();
+  check_remove_vertex_edges<G32>();
+
+  using D32 = directed_adjacency_list<char, int, uint32_t>;
+  check_default_init<D32>();
+  check_add_vertices<D32>();
+  check_add_edges<D32>();
+  check_remove_multi_edge<D32>();
+  check_remove_all_edges<D32>();
 }
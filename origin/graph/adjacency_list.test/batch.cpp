@@ -0,0 +1,65 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_list.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using G = directed_adjacency_list<empty_t, int>;
+using G32 = directed_adjacency_list<empty_t, int, uint32_t>;
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  G g;
+  for (int i = 0; i < 3; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1, 10);
+  G::edge b = g.add_edge(0, 1, 11);
+  G::edge c = g.add_edge(1, 2, 12);
+  g.add_edge(2, 2, 13);
+  g.commit();
+
+  // Replacing an edge deletes the old one and adds the new one, and a
+  // deletion of a missing edge has no effect. Other edges keep their
+  // handles.
+  g.apply_batch({G::edge_insertion(0, 1, 20), G::edge_insertion(2, 0, 21)},
+                {{0, 1}, {2, 2}, {1, 0}});
+  assert(g.size() == 4);
+  assert(g(b) == 11 && g(c) == 12);
+  assert(g(*g.out_edges(2).begin()) == 21);
+  assert(g.out_degree(0) == 2 && g.in_degree(1) == 2);
+  assert(g.out_degree(2) == 1 && g.in_degree(2) == 1);
+
+  // The snapshot taken before the batch is unchanged, and a commit
+  // publishes the batch.
+  auto s0 = g.snapshot();
+  g.commit();
+  auto s1 = g.snapshot();
+  assert(s0.size() == 4 && s0.out_degree(2) == 1 && s0.in_degree(2) == 2);
+  assert(s1.size() == 4 && s1.out_degree(0) == 2 && s1.in_degree(0) == 1);
+
+  g.apply_batch({}, {});
+  assert(g.size() == 4);
+}
+
+int main()
+{
+  check_small();
+  cout << "*** random ***\n";
+  check_random_batches<G>(1);
+  check_random_batches<G>(4);
+  check_random_batches<G32>(3);
+}
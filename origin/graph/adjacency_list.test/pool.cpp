@@ -6,6 +6,7 @@
 // and conditions.
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
 #include <origin/graph/adjacency_list.hpp>
@@ -191,6 +192,49 @@ check_pool_yoyo_rl()
   debug_pool(p);
 }
 
+// Copies of a pool must not share the resources of their elements.
+void
+check_pool_copy()
+{
+  std::cout << "*** copy ***\n";
+  pool<vector<int>> p;
+  for (int i = 0; i < 10; ++i)
+    p.insert(vector<int>(100, i));
+  pool<vector<int>> q = p;
+  for (int i = 0; i < 10; i += 2)
+    q.erase(i);
+  for (int i = 0; i < 10; ++i)
+    q.insert(vector<int>(200, -i));
+  for (int i = 0; i < 10; ++i)
+    assert(p[i] == vector<int>(100, i));
+
+  p = q;
+  q.clear();
+  assert(p.size() == 15);
+}
+
+// A pool with 32 bit indexes has smaller nodes, but otherwise behaves the
+// same way.
+void
+check_pool_narrow()
+{
+  std::cout << "*** narrow ***\n";
+  static_assert(sizeof(pool_node<int, uint32_t>) < sizeof(pool_node<int>), "");
+  pool<int, uint32_t> p;
+  for (int i = 0; i < 10; ++i)
+    p.insert(i);
+  for (int i = 0; i < 10; i += 3)
+    p.erase(i);
+  assert(p.size() == 6);
+  assert(p.insert(100) == 0);
+  vector<int> live;
+  for (int x : p)
+    live.push_back(x);
+  assert((live == vector<int> {100, 1, 2, 4, 5, 7, 8}));
+  for (int i = 0; i < 10; ++i)
+    p.erase(i);
+  assert(p.empty() && p.begin() == p.end());
+}
 
 int main()
 {
@@ -201,4 +245,6 @@ int main()
   check_pool_reuse();
   check_pool_yoyo_lr();
   check_pool_yoyo_rl();
+  check_pool_copy();
+  check_pool_narrow();
 }
@@ -0,0 +1,213 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+
+#include <origin/graph/adjacency_list.hpp>
+
+using namespace std;
+using namespace origin;
+
+using G = directed_adjacency_list<char, int>;
+
+// Returns the sum of out degrees in g. In a consistent graph this is the
+// same as the number of edges.
+template<typename S>
+  size_t
+  out_degree_sum(const S& g)
+  {
+    size_t n = 0;
+    for (auto v : g.vertices())
+      n += g.out_degree(v);
+    return n;
+  }
+
+// Returns the sum of in degrees in g.
+template<typename S>
+  size_t
+  in_degree_sum(const S& g)
+  {
+    size_t n = 0;
+    for (auto v : g.vertices())
+      n += g.in_degree(v);
+    return n;
+  }
+
+void
+check_uncommitted()
+{
+  cout << "*** uncommitted ***\n";
+  G g;
+  g.add_vertex('a');
+  auto s = g.snapshot();
+  assert(s.null());
+  assert(s.empty());
+}
+
+void
+check_isolation()
+{
+  cout << "*** isolation ***\n";
+  G g;
+  for (int i = 0; i < 4; ++i)
+    g.add_vertex('a' + i);
+  g.add_edge(0, 1, 10);
+  g.add_edge(1, 2, 20);
+  g.commit();
+
+  auto s1 = g.snapshot();
+  assert(s1.order() == 4);
+  assert(s1.size() == 2);
+
+  // Modify the graph. The snapshot does not change.
+  g.remove_edge(0, 1);
+  g.add_edge(2, 3, 30);
+  g(Vertex<G>(0)) = 'z';
+  g.remove_vertex(3);
+  assert(s1.order() == 4);
+  assert(s1.size() == 2);
+  assert(s1(Vertex<G>(0)) == 'a');
+  assert(s1(Vertex<G>(0), Vertex<G>(1)));
+  assert(s1(s1(Vertex<G>(0), Vertex<G>(1))) == 10);
+  assert(s1.out_degree(0) == 1);
+
+  // The new version reflects the modifications.
+  g.commit();
+  auto s2 = g.snapshot();
+  assert(s2.order() == 3);
+  assert(s2.size() == 1);
+  assert(s2(Vertex<G>(0)) == 'z');
+  assert(!s2(Vertex<G>(0), Vertex<G>(1)));
+  assert(s2(Vertex<G>(1), Vertex<G>(2)));
+  assert(out_degree_sum(s2) == 1);
+  assert(in_degree_sum(s2) == 1);
+
+  // And the old snapshot is still intact.
+  assert(out_degree_sum(s1) == 2);
+  assert(in_degree_sum(s1) == 2);
+}
+
+// Check that snapshots share the elements that were not modified.
+void
+check_sharing()
+{
+  cout << "*** sharing ***\n";
+  G g;
+  for (int i = 0; i < 200; ++i)
+    g.add_vertex('a');
+  for (int i = 0; i < 199; ++i)
+    g.add_edge(i, i + 1, i);
+  g.commit();
+  auto s1 = g.snapshot();
+  const char* p = &s1(Vertex<G>(150));
+
+  g.add_edge(0, 1, 1000);
+  g.commit();
+  auto s2 = g.snapshot();
+  assert(&s2(Vertex<G>(150)) == p);
+  assert(&s2(Vertex<G>(0)) != &s1(Vertex<G>(0)));
+  assert(s2.out_degree(0) == 2);
+  assert(s1.out_degree(0) == 1);
+}
+
+// Check that unpinned versions are reclaimed, and pinned versions are not.
+void
+check_reclamation()
+{
+  cout << "*** reclamation ***\n";
+  G g;
+  g.add_vertex('a');
+  g.commit();
+  {
+    auto s = g.snapshot();
+    for (int i = 0; i < 10; ++i) {
+      g.add_edge(0, 0, i);
+      g.commit();
+    }
+    assert(s.size() == 0);
+  }
+  g.add_edge(0, 0, 10);
+  g.commit();
+  auto s = g.snapshot();
+  assert(s.size() == 11);
+}
+
+// A thread may hold more snapshots than fit in one block of epoch slots,
+// and versions pinned by any of them are kept.
+void
+check_many_snapshots()
+{
+  cout << "*** many snapshots ***\n";
+  G g;
+  g.add_vertex('a');
+  g.commit();
+  vector<G::snapshot_type> held;
+  for (int i = 0; i < 200; ++i) {
+    held.push_back(g.snapshot());
+    g.add_edge(0, 0, i);
+    g.commit();
+  }
+  for (size_t i = 0; i < held.size(); ++i)
+    assert(held[i].size() == i);
+  held.clear();
+  g.add_edge(0, 0, 200);
+  g.commit();
+  assert(g.snapshot().size() == 201);
+}
+
+// A single writer modifies the graph while readers repeatedly take and
+// traverse snapshots. Every snapshot must be internally consistent.
+void
+check_concurrent_readers()
+{
+  cout << "*** concurrent readers ***\n";
+  G g;
+  for (int i = 0; i < 64; ++i)
+    g.add_vertex('a');
+  g.commit();
+
+  std::atomic<bool> done(false);
+  auto reader = [&]() {
+    while (!done) {
+      auto s = g.snapshot();
+      size_t m = 0;
+      for (auto e : s.edges()) {
+        assert(size_t(s.source(e)) < 64);
+        assert(s(e) >= 0);
+        ++m;
+      }
+      assert(m == s.size());
+      assert(out_degree_sum(s) == s.size());
+      assert(in_degree_sum(s) == s.size());
+    }
+  };
+
+  std::thread r1(reader);
+  std::thread r2(reader);
+  for (int i = 0; i < 2000; ++i) {
+    g.add_edge(i % 64, (i * 7) % 64, i);
+    if (i % 3 == 0)
+      g.remove_edge((i * 5) % 64, (i * 11) % 64);
+    if (i % 10 == 0)
+      g.commit();
+  }
+  done = true;
+  r1.join();
+  r2.join();
+}
+
+int main()
+{
+  check_uncommitted();
+  check_isolation();
+  check_sharing();
+  check_reclamation();
+  check_many_snapshots();
+  check_concurrent_readers();
+}
@@ -11,6 +11,7 @@
 #include <cassert>
 
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <vector>
@@ -25,8 +26,10 @@
 #include <origin/graph/handle.hpp>
 #include <origin/graph/graph.hpp>
 #include <origin/graph/io.hpp>
+#include <origin/graph/batch.hpp>
+#include <origin/graph/memory.hpp>
+#include <origin/graph/instrument.hpp>
 
-#include <origin/graph/adjacency_list.impl/pool.hpp>
 
 namespace origin
 {
@@ -34,8 +37,8 @@ namespace origin
   namespace adjacency_vector_impl
   {
 
-    // The handle iterator wraps a constant iterator of the container type C and
-    // returns handles of type H when dereferenced.
+    // The handle counter counts through a sequence of integer values of type
+    // T and returns handles of type H when dereferenced.
     //
     // TODO: Make this a random access iterator.
     template<typename T, typename H>
@@ -44,11 +47,17 @@ namespace origin
         using handle_type = H;
         using counter_type = T;
 
+        using iterator_category = std::input_iterator_tag;
+        using value_type = H;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const H*;
+        using reference = H;
+
         handle_counter(counter_type n)
           : count(n)
         { }
 
-        handle_type operator*() const { H(count); }
+        handle_type operator*() const { return H(count); }
 
         handle_counter& operator++();
         handle_counter  operator++(int);
@@ -100,7 +109,7 @@ namespace origin
     // In an undirected adjacency list, the source and target vertices refer to
     // the vertices in the order they were specified on addition. There is no
     // other meaning attributed to them.
-    template<typename E>
+    template<typename E, typename N>
       struct edge
       {
         using value_type = E;
@@ -109,47 +118,69 @@ namespace origin
           : data(-1, -1, E{})
         { }
 
-        edge(vertex_handle s, vertex_handle t)
+        edge(basic_vertex_handle<N> s, basic_vertex_handle<N> t)
           : data(s, t, E{})
         { }
 
         template<typename... Args>
-          edge(vertex_handle s, vertex_handle t, Args&&... args)
+          edge(basic_vertex_handle<N> s, basic_vertex_handle<N> t, Args&&... args)
             : data(s, t, std::forward<Args>(args)...)
           { }
 
-        vertex_handle& source()       { return std::get<0>(data); }
-        vertex_handle  source() const { return std::get<0>(data); }
+        basic_vertex_handle<N>& source()       { return std::get<0>(data); }
+        basic_vertex_handle<N>  source() const { return std::get<0>(data); }
 
-        vertex_handle& target()       { return std::get<1>(data); }
-        vertex_handle  target() const { return std::get<1>(data); }
+        basic_vertex_handle<N>& target()       { return std::get<1>(data); }
+        basic_vertex_handle<N>  target() const { return std::get<1>(data); }
 
         E&       value()       { return std::get<2>(data); }
         const E& value() const { return std::get<2>(data); }
 
-        std::tuple<vertex_handle, vertex_handle,  E> data;
+        std::tuple<basic_vertex_handle<N>, basic_vertex_handle<N>,  E> data;
       };
 
     // An (incident) edge list is a vector of indexes.
-    using edge_list = std::vector<edge_handle>;
+    template<typename N>
+      using edge_list = std::vector<basic_edge_handle<N>>;
   
+    // An alias for a vector of T allocated by the rebinding of A.
+    template<typename T, typename A>
+      using array = std::vector<
+        T, typename std::allocator_traits<A>::template rebind_alloc<T>
+      >;
+
     // An alias for the edge pool.
-    template<typename E>
-      using edge_set = std::vector<edge<E>>;
+    template<typename E, typename N, typename A>
+      using edge_set = array<edge<E, N>, A>;
+
+    // Move the elements of v into an array allocated by a, rebound to T.
+    template<typename T, typename B, typename A>
+      void
+      move_array(std::vector<T, B>& v, const A& a)
+      {
+        B b(a);
+        std::vector<T, B> r(b);
+        r.reserve(v.size());
+        for (T& x : v)
+          r.push_back(std::move(x));
+        v = std::move(r);
+      }
 
     // An alias for the edge iterator.
-    template<typename E>
-      using edge_iterator = handle_counter<std::size_t, edge_handle>;
+    template<typename E, typename N>
+      using edge_iterator = handle_counter<N, basic_edge_handle<N>>;
 
     // An alias for the edge range.
-    template<typename E>
-      using edge_range = bounded_range<edge_iterator<E>>;
+    template<typename E, typename N>
+      using edge_range = bounded_range<edge_iterator<E, N>>;
 
     // An alias for the incident edge iterator.
-    using incidence_iterator = typename edge_list::const_iterator;
+    template<typename N>
+      using incidence_iterator = typename edge_list<N>::const_iterator;
 
     // An alias for the icident edge range.
-    using incidence_range = bounded_range<incidence_iterator>;
+    template<typename N>
+      using incidence_range = bounded_range<incidence_iterator<N>>;
 
   } // namespace adjacency_vector_impl
 
@@ -159,12 +190,24 @@ namespace origin
   //                                                         [graph.adj_vec.dir]
   //                        Directed Adjacency Vector
   //
-  // A directed adjacency vector is a kind of adjacency list that supports only
-  // incremental algorithms. That is, the data structure allows for the efficent
-  // insertion insertion of vertices and edges, but removal is not supported.
-  // Like any [Adjacency_list], the data structure also provides efficient
-  // access to all vertices, all edges, and the successors and predecessors
-  // of each vertex.
+  // A directed adjacency vector is a kind of adjacency list that is optimized
+  // for incremental algorithms. That is, the data structure allows for the
+  // efficent insertion of vertices and edges. Vertices cannot be removed, and
+  // edges are removed only in batches by apply_batch. Like any
+  // [Adjacency_list], the data structure also provides efficient access to all
+  // vertices, all edges, and the successors and predecessors of each vertex.
+  //
+  // Edge handles are indexes into the edge set. A batch that removes edges
+  // renumbers the remaining ones, invalidating every edge handle held across
+  // it; vertex handles are not affected.
+  //
+  // The unsigned integer type N is the index type of the vertex and edge
+  // handles. Graphs with fewer than 2^32 - 1 vertices and edges can use 32 bit
+  // indexes, which halves the size of the incidence lists.
+  //
+  // The vertex and edge arrays are allocated by the allocator A, rebound to
+  // their elements. A graph allocated by a numa_allocator can be placed across
+  // the nodes of a NUMA machine by numa_place (see [graph.numa]).
 
   namespace directed_adjacency_vector_impl
   {
@@ -181,12 +224,12 @@ namespace origin
     // separate edge container.
     //
     // Note that the class will compress the value type if it is empty.
-    template<typename V>
+    template<typename V, typename N>
       struct vertex
       {
         using value_type = V;
-        using iterator = typename edge_list::iterator;
-        using const_iterator = typename edge_list::const_iterator;
+        using iterator = typename edge_list<N>::iterator;
+        using const_iterator = typename edge_list<N>::const_iterator;
     
         vertex()
           : data()
@@ -194,24 +237,24 @@ namespace origin
 
         template<typename... Args>
           vertex(Args&&... args) 
-            : data(edge_list{}, edge_list{}, std::forward<Args>(args)...)
+            : data(edge_list<N>{}, edge_list<N>{}, std::forward<Args>(args)...)
           { }
 
         // Returns the out ege list
-        edge_list&       out()       { return std::get<0>(data); }
-        const edge_list& out() const { return std::get<0>(data); }
+        edge_list<N>&       out()       { return std::get<0>(data); }
+        const edge_list<N>& out() const { return std::get<0>(data); }
         
         // Returns the in edge list
-        edge_list&       in()       { return std::get<1>(data); }
-        const edge_list& in() const { return std::get<1>(data); }
+        edge_list<N>&       in()       { return std::get<1>(data); }
+        const edge_list<N>& in() const { return std::get<1>(data); }
 
         // Returns the user-supplied data object.
         V&       value()       { return std::get<2>(data); }
         const V& value() const { return std::get<2>(data); }
 
         // Edge insertion
-        void insert_out(edge_handle e) { insert_edge(out(), e); }
-        void insert_in(edge_handle e) { insert_edge(in(), e); }
+        void insert_out(basic_edge_handle<N> e) { insert_edge(out(), e); }
+        void insert_in(basic_edge_handle<N> e) { insert_edge(in(), e); }
 
         // Out edges
         std::size_t out_degree() const { return out().size(); }
@@ -231,30 +274,31 @@ namespace origin
 
 
         // Helper functions
-        void insert_edge(edge_list& l, edge_handle e);
+        void insert_edge(edge_list<N>& l, basic_edge_handle<N> e);
 
       public:
-        std::tuple<edge_list, edge_list, V> data;
+        std::tuple<edge_list<N>, edge_list<N>, V> data;
       };
 
-    template<typename V>
+    template<typename V, typename N>
       inline void
-      vertex<V>::insert_edge(edge_list& l, edge_handle e)
+      vertex<V, N>::insert_edge(edge_list<N>& l, basic_edge_handle<N> e)
       {
+        ORIGIN_GRAPH_GROWTH(l);
         l.push_back(e);
       }
 
     // A vertex set simply a vector of vertices.
-    template<typename V>
-      using vertex_set = std::vector<vertex<V>>;
+    template<typename V, typename N, typename A>
+      using vertex_set = adjacency_vector_impl::array<vertex<V, N>, A>;
 
     // An alias for the vertex iterator.
-    template<typename V>
-      using vertex_iterator = handle_counter<std::size_t, vertex_handle>;
+    template<typename V, typename N>
+      using vertex_iterator = handle_counter<N, basic_vertex_handle<N>>;
 
     // An alias for the vertex range.
-    template<typename V>
-      using vertex_range = bounded_range<vertex_iterator<V>>;
+    template<typename V, typename N>
+      using vertex_range = bounded_range<vertex_iterator<V, N>>;
 
 
   } // namespace directed_adjacency_vector_impl
@@ -262,29 +306,34 @@ namespace origin
 
 
   // Implementation of a diretected adjacency list.
-  template<typename V = empty_t, typename E = empty_t>
+  template<typename V = empty_t, typename E = empty_t, typename N = std::size_t,
+           typename A = std::allocator<V>>
     class directed_adjacency_vector
     {
-      using this_type = directed_adjacency_vector<V, E>;
+      using this_type = directed_adjacency_vector<V, E, N, A>;
 
-      using vertex_node = directed_adjacency_vector_impl::vertex<V>;
-      using vertex_set = directed_adjacency_vector_impl::vertex_set<V>;
-      using vertex_iter = directed_adjacency_vector_impl::vertex_iterator<V>;
+      using vertex_node = directed_adjacency_vector_impl::vertex<V, N>;
+      using vertex_set = directed_adjacency_vector_impl::vertex_set<V, N, A>;
+      using vertex_iter = directed_adjacency_vector_impl::vertex_iterator<V, N>;
 
-      using edge_node = adjacency_vector_impl::edge<E>;
-      using edge_set = adjacency_vector_impl::edge_set<E>;
-      using edge_iter = adjacency_vector_impl::edge_iterator<E>;
+      using edge_node = adjacency_vector_impl::edge<E, N>;
+      using edge_set = adjacency_vector_impl::edge_set<E, N, A>;
+      using edge_iter = adjacency_vector_impl::edge_iterator<E, N>;
 
-      using incidence_iter = adjacency_vector_impl::incidence_iterator;
+      using incidence_iter = adjacency_vector_impl::incidence_iterator<N>;
     public:
-      using vertex = vertex_handle;
-      using vertex_range = directed_adjacency_vector_impl::vertex_range<V>;
+      using vertex = basic_vertex_handle<N>;
+      using vertex_range = directed_adjacency_vector_impl::vertex_range<V, N>;
+
+      using edge = basic_edge_handle<N>;
+      using edge_range = adjacency_vector_impl::edge_range<E, N>;
 
-      using edge = edge_handle;
-      using edge_range = adjacency_vector_impl::edge_range<E>;
+      using incidence_range = adjacency_vector_impl::incidence_range<N>;
 
-      using incidence_range = adjacency_vector_impl::incidence_range;
+      using allocator_type = A;
 
+      directed_adjacency_vector() = default;
+      explicit directed_adjacency_vector(const A& a) : verts_(a), edges_(a) { }
 
       // Observers
       bool        null() const  { return verts_.empty(); }
@@ -328,6 +377,21 @@ namespace origin
       template<typename... Args>
         edge emplace_edge(vertex u, vertex v, Args&&...);
 
+      // Edge batches
+      using edge_insertion = std::tuple<vertex, vertex, E>;
+      using edge_deletion = std::pair<vertex, vertex>;
+
+      void apply_batch(const std::vector<edge_insertion>& insertions,
+                       const std::vector<edge_deletion>& deletions,
+                       std::size_t threads = 0);
+
+      // Memory
+      graph_memory memory_usage() const;
+      void         shrink_to_fit();
+      void         relocate(const A& vertices, const A& edges);
+      void         relocate_incidence(std::size_t first, std::size_t last);
+      A            get_allocator() const { return A(verts_.get_allocator()); }
+
       // Iterators
       vertex_range    vertices() const;
       edge_range      edges() const;
@@ -346,18 +410,19 @@ namespace origin
       edge find_in_edge(vertex u, vertex v) const;
 
       template<typename S, typename P>
-        edge find_edge(const S& seq, P pred) const;
+        edge find_edge(vertex x, const S& seq, P pred) const;
 
       void link_edge(vertex u, vertex v, edge e);
+      void erase_edges(const std::vector<edge>& removed, std::size_t threads);
 
     private:
       vertex_set verts_;
       edge_set   edges_;
     };
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::operator()(vertex u, vertex v) const -> edge
+    directed_adjacency_vector<V, E, N, A>::operator()(vertex u, vertex v) const -> edge
     {
       if (out_degree(u) <= in_degree(v))
         return find_out_edge(u, v);
@@ -365,107 +430,112 @@ namespace origin
         return find_in_edge(u, v);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::find_out_edge(vertex u, vertex v) const -> edge
+    directed_adjacency_vector<V, E, N, A>::find_out_edge(vertex u, vertex v) const -> edge
     {
       using P = has_target<this_type>;
       const vertex_node& n = node(u);
-      return find_edge(n.out(), P(*this, v));
+      return find_edge(u, n.out(), P(*this, v));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::find_in_edge(vertex u, vertex v) const -> edge
+    directed_adjacency_vector<V, E, N, A>::find_in_edge(vertex u, vertex v) const -> edge
     {
       using P = has_source<this_type>;
       const vertex_node& n = node(v);
-      return find_edge(n.in(), P(*this, u));
+      return find_edge(v, n.in(), P(*this, u));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     template<typename S, typename P>
     inline auto
-    directed_adjacency_vector<V, E>::find_edge(const S& seq, P pred) const -> edge
+    directed_adjacency_vector<V, E, N, A>::
+      find_edge(vertex x, const S& seq, P pred) const -> edge
     {
       auto i = find_if(seq, pred);
+      ORIGIN_GRAPH_SEARCH(x, instrument_impl::probes(seq, i));
       return i == seq.end() ? edge() : *i;
     }
 
   // Add a vertex to the graph, returning a handle to the new object. If
   // V is a user-supplied type, its value is default constructed.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::add_vertex() -> vertex
+    directed_adjacency_vector<V, E, N, A>::add_vertex() -> vertex
     {
       return emplace_vertex();
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::add_vertex(V&& x) -> vertex
+    directed_adjacency_vector<V, E, N, A>::add_vertex(V&& x) -> vertex
     {
       return emplace_vertex(std::move(x));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::add_vertex(const V& x) -> vertex
+    directed_adjacency_vector<V, E, N, A>::add_vertex(const V& x) -> vertex
     {
       return emplace_vertex(x);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     template<typename... Args>
       inline auto
-      directed_adjacency_vector<V, E>::emplace_vertex(Args&&... args) -> vertex
+      directed_adjacency_vector<V, E, N, A>::emplace_vertex(Args&&... args) -> vertex
       {
         vertex n = verts_.size();
+        ORIGIN_GRAPH_GROWTH(verts_);
         verts_.emplace_back(std::forward<Args>(args)...);
         return n;
       }
 
 
   // Add a defaul edge from u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::add_edge(vertex u, vertex v) -> edge
+    directed_adjacency_vector<V, E, N, A>::add_edge(vertex u, vertex v) -> edge
     {
       return emplace_edge(u, v);
     }
 
   // Move x into an edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::add_edge(vertex u, vertex v, E&& x) -> edge
+    directed_adjacency_vector<V, E, N, A>::add_edge(vertex u, vertex v, E&& x) -> edge
     {
       return emplace_edge(u, v, std::move(x));
     }
 
   // Copy x into an edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::
+    directed_adjacency_vector<V, E, N, A>::
       add_edge(vertex u, vertex v, const E& x) -> edge
     {
       return emplace_edge(u, v, x);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     template<typename... Args>
       inline auto
-      directed_adjacency_vector<V, E>::
+      directed_adjacency_vector<V, E, N, A>::
         emplace_edge(vertex u, vertex v, Args&&... args) -> edge
       {
         edge e = edges_.size();
+        ORIGIN_GRAPH_COUNT(add_edge, 1);
+        ORIGIN_GRAPH_GROWTH(edges_);
         edges_.emplace_back(u, v, std::forward<Args>(args)...);
         link_edge(u, v, e);
         return e;
       }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline void
-    directed_adjacency_vector<V, E>::link_edge(vertex u, vertex v, edge e)
+    directed_adjacency_vector<V, E, N, A>::link_edge(vertex u, vertex v, edge e)
     {
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
@@ -473,35 +543,168 @@ namespace origin
       vn.insert_in(e);
     }
 
+  // Apply a batch of edge updates: add an edge from u to v with the value x
+  // for each insertion (u, v, x), and remove one edge from u to v, if any,
+  // for each deletion (u, v). Deletions apply only to the edges in the graph
+  // before the batch. The updates are grouped by vertex, and the incidence
+  // lists of the affected vertices are rewritten in parallel (see
+  // [graph.batch]).
+  //
+  // Because edge handles are indexes into the edge set, removing edges
+  // renumbers the remaining ones, which keep their relative order. The
+  // inserted edges follow the existing ones, in the order of insertion.
+  template<typename V, typename E, typename N, typename A>
+    void
+    directed_adjacency_vector<V, E, N, A>::
+      apply_batch(const std::vector<edge_insertion>& insertions,
+                  const std::vector<edge_deletion>& deletions,
+                  std::size_t threads)
+    {
+      std::size_t base = edges_.size();
+      std::size_t k = insertions.size();
+      std::vector<std::size_t> source(k), target(k);
+      std::vector<edge> added(k);
+      ORIGIN_GRAPH_COUNT(add_edge, k);
+      if (edges_.capacity() < base + k)
+        ORIGIN_GRAPH_COUNT(reallocation, 1);
+      edges_.reserve(base + k);
+      for (std::size_t i = 0; i < k; ++i) {
+        const edge_insertion& x = insertions[i];
+        source[i] = std::get<0>(x);
+        target[i] = std::get<1>(x);
+        edges_.emplace_back(std::get<0>(x), std::get<1>(x), std::get<2>(x));
+        added[i] = base + i;
+      }
+
+      const edge_set& es = edges_;
+      std::vector<edge> removed = batch_impl::apply(
+        source, target, added, deletions,
+        [this](std::size_t v) -> vertex_node& { return verts_[v]; },
+        [&es](edge e) -> std::size_t { return es[e].target(); },
+        threads);
+      ORIGIN_GRAPH_COUNT(remove_edge, removed.size());
+      if (!removed.empty())
+        erase_edges(removed, threads);
+    }
+
+  // Erase the removed edges, which are no longer in any incidence list, from
+  // the edge set, and renumber the remaining edges in the incidence lists.
+  template<typename V, typename E, typename N, typename A>
+    void
+    directed_adjacency_vector<V, E, N, A>::
+      erase_edges(const std::vector<edge>& removed, std::size_t threads)
+    {
+      std::vector<bool> dead(edges_.size(), false);
+      for (edge e : removed)
+        dead[e] = true;
+      std::vector<N> index(edges_.size());
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < edges_.size(); ++i)
+        if (!dead[i]) {
+          if (n != i)
+            edges_[n] = std::move(edges_[i]);
+          index[i] = n++;
+        }
+      edges_.erase(edges_.begin() + n, edges_.end());
+
+      parallel_blocks(verts_.size(), [&](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t v = b; v != e; ++v) {
+          for (edge& x : verts_[v].out())
+            x = index[x];
+          for (edge& x : verts_[v].in())
+            x = index[x];
+        }
+      }, threads);
+    }
+
+
+  // Returns the memory used by the graph, as described in [graph.memory].
+  template<typename V, typename E, typename N, typename A>
+    graph_memory
+    directed_adjacency_vector<V, E, N, A>::memory_usage() const
+    {
+      using namespace memory_impl;
+      constexpr std::size_t pv = payload_size<V>();
+      constexpr std::size_t pe = payload_size<E>();
+      graph_memory m {};
+      m.vertices = block(verts_, sizeof(vertex_node) - pv);
+      m.edges = block(edges_, sizeof(edge_node) - pe);
+      m.payload = block(verts_, pv) + block(edges_, pe);
+      for (const vertex_node& n : verts_)
+        m.incidence += block(n.out()) + block(n.in());
+      return m;
+    }
+
+  // Release the capacity reserved beyond the size of the vertex set, the
+  // edge set, and each incidence list.
+  template<typename V, typename E, typename N, typename A>
+    void
+    directed_adjacency_vector<V, E, N, A>::shrink_to_fit()
+    {
+      verts_.shrink_to_fit();
+      edges_.shrink_to_fit();
+      for (vertex_node& n : verts_) {
+        n.out().shrink_to_fit();
+        n.in().shrink_to_fit();
+      }
+    }
+
+  // Move the vertex and edge arrays into arrays allocated by the given
+  // allocators, which keep allocating them as the graph grows.
+  template<typename V, typename E, typename N, typename A>
+    void
+    directed_adjacency_vector<V, E, N, A>::relocate(const A& vertices,
+                                                    const A& edges)
+    {
+      adjacency_vector_impl::move_array(verts_, vertices);
+      adjacency_vector_impl::move_array(edges_, edges);
+    }
+
+  // Reallocate the incidence lists of the vertices in [first, last), so that
+  // their pages are first written by the calling thread. Calls for disjoint
+  // ranges may run concurrently.
+  template<typename V, typename E, typename N, typename A>
+    void
+    directed_adjacency_vector<V, E, N, A>::relocate_incidence(std::size_t first,
+                                                              std::size_t last)
+    {
+      for (std::size_t i = first; i != last; ++i) {
+        vertex_node& n = verts_[i];
+        auto out = n.out();
+        auto in = n.in();
+        n.out().swap(out);
+        n.in().swap(in);
+      }
+    }
 
   // Retrun a range over the vertex set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::vertices() const -> vertex_range
+    directed_adjacency_vector<V, E, N, A>::vertices() const -> vertex_range
     {
-      return {vertex_iter(verts_.begin()), vertex_iter(verts_.end())};
+      return {vertex_iter(0), vertex_iter(verts_.size())};
     }
 
   // Return a range over the edge set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::edges() const -> edge_range
+    directed_adjacency_vector<V, E, N, A>::edges() const -> edge_range
     {
-      return {edge_iter(edges_.begin()), edge_iter(edges_.end())};
+      return {edge_iter(0), edge_iter(edges_.size())};
     }
 
   // Return a range over the out edges of the vertex v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::out_edges(vertex v) const -> incidence_range
+    directed_adjacency_vector<V, E, N, A>::out_edges(vertex v) const -> incidence_range
     {
       const vertex_node& vn = node(v);
       return {incidence_iter(vn.begin_out()), incidence_iter(vn.end_out())};
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    directed_adjacency_vector<V, E>::in_edges(vertex v) const -> incidence_range
+    directed_adjacency_vector<V, E, N, A>::in_edges(vertex v) const -> incidence_range
     {
       const vertex_node& vn = node(v);
       return {incidence_iter(vn.begin_in()), incidence_iter(vn.end_in())};
@@ -525,12 +728,12 @@ namespace origin
     
     // A vertex in an undirected adjacency list is simply a list of incident
     // edges. No distinction is made between in or out edges.
-    template<typename V>
+    template<typename V, typename N>
       struct vertex
       {
         using value_type = V;
-        using iterator = typename edge_list::iterator;
-        using const_iterator = typename edge_list::const_iterator;
+        using iterator = typename edge_list<N>::iterator;
+        using const_iterator = typename edge_list<N>::const_iterator;
     
         vertex()
           : data()
@@ -538,12 +741,12 @@ namespace origin
 
         template<typename... Args>
           vertex(Args&&... args) 
-            : data(edge_list{}, std::forward<Args>(args)...)
+            : data(edge_list<N>{}, std::forward<Args>(args)...)
           { }
 
         // Returns the out ege list
-        edge_list&       edges()       { return std::get<0>(data); }
-        const edge_list& edges() const { return std::get<0>(data); }
+        edge_list<N>&       edges()       { return std::get<0>(data); }
+        const edge_list<N>& edges() const { return std::get<0>(data); }
         
         // Returns the user-supplied data object.
         V&       value()       { return std::get<1>(data); }
@@ -552,7 +755,7 @@ namespace origin
         // Out edges
         std::size_t degree() const { return edges().size(); }
 
-        void insert(edge_handle e);
+        void insert(basic_edge_handle<N> e);
 
         iterator begin() { return edges().begin(); }
         iterator end()   { return edges().end(); }
@@ -560,55 +763,61 @@ namespace origin
         const_iterator end() const   { return edges().end(); }
 
       public:
-        std::tuple<edge_list, V> data;
+        std::tuple<edge_list<N>, V> data;
       };
 
-    template<typename V>
+    template<typename V, typename N>
       inline void
-      vertex<V>::insert(edge_handle e)
+      vertex<V, N>::insert(basic_edge_handle<N> e)
       {
+        ORIGIN_GRAPH_GROWTH(edges());
         edges().push_back(e);
       }
 
     // A vertex set is a vector of vertices.
-    template<typename V>
-      using vertex_set = std::vector<vertex<V>>;
+    template<typename V, typename N, typename A>
+      using vertex_set = adjacency_vector_impl::array<vertex<V, N>, A>;
 
     // An alias for the vertex iterator.
-    template<typename V>
-      using vertex_iterator = handle_counter<vertex_set<V>, vertex_handle>;
+    template<typename V, typename N>
+      using vertex_iterator = handle_counter<N, basic_vertex_handle<N>>;
 
     // An alias for the vertex range.
-    template<typename V>
-      using vertex_range = bounded_range<vertex_iterator<V>>;
+    template<typename V, typename N>
+      using vertex_range = bounded_range<vertex_iterator<V, N>>;
 
   } // namespace undirected_adjacency_vector_impl
 
 
   // Implementation of the undirected adjacency list.
-  template<typename V = empty_t, typename E = empty_t>
+  template<typename V = empty_t, typename E = empty_t, typename N = std::size_t,
+           typename A = std::allocator<V>>
     class undirected_adjacency_vector
     {
-      using this_type = undirected_adjacency_vector<V, E>;
+      using this_type = undirected_adjacency_vector<V, E, N, A>;
 
-      using vertex_node = undirected_adjacency_vector_impl::vertex<V>;
-      using vertex_set = undirected_adjacency_vector_impl::vertex_set<V>;
-      using vertex_iter = undirected_adjacency_vector_impl::vertex_iterator<V>;
+      using vertex_node = undirected_adjacency_vector_impl::vertex<V, N>;
+      using vertex_set = undirected_adjacency_vector_impl::vertex_set<V, N, A>;
+      using vertex_iter = undirected_adjacency_vector_impl::vertex_iterator<V, N>;
 
-      using edge_node = adjacency_vector_impl::edge<E>;
-      using edge_set = adjacency_vector_impl::edge_set<E>;
-      using edge_iter = adjacency_vector_impl::edge_iterator<E>;
+      using edge_node = adjacency_vector_impl::edge<E, N>;
+      using edge_set = adjacency_vector_impl::edge_set<E, N, A>;
+      using edge_iter = adjacency_vector_impl::edge_iterator<E, N>;
 
-      using incidence_iter = adjacency_vector_impl::incidence_iterator;
+      using incidence_iter = adjacency_vector_impl::incidence_iterator<N>;
     public:
-      using vertex = vertex_handle;
-      using vertex_range = undirected_adjacency_vector_impl::vertex_range<V>;
+      using vertex = basic_vertex_handle<N>;
+      using vertex_range = undirected_adjacency_vector_impl::vertex_range<V, N>;
 
-      using edge = edge_handle;
-      using edge_range = adjacency_vector_impl::edge_range<E>;
+      using edge = basic_edge_handle<N>;
+      using edge_range = adjacency_vector_impl::edge_range<E, N>;
 
-      using incidence_range = adjacency_vector_impl::incidence_range;
+      using incidence_range = adjacency_vector_impl::incidence_range<N>;
 
+      using allocator_type = A;
+
+      undirected_adjacency_vector() = default;
+      explicit undirected_adjacency_vector(const A& a) : verts_(a), edges_(a) { }
 
       // Observers
       bool        null() const  { return verts_.empty(); }
@@ -654,6 +863,13 @@ namespace origin
       template<typename... Args>
         edge emplace_edge(vertex u, vertex v, Args&&... args);
 
+      // Memory
+      graph_memory memory_usage() const;
+      void         shrink_to_fit();
+      void         relocate(const A& vertices, const A& edges);
+      void         relocate_incidence(std::size_t first, std::size_t last);
+      A            get_allocator() const { return A(verts_.get_allocator()); }
+
       // Iterators
       vertex_range    vertices() const;
       edge_range      edges() const;
@@ -670,7 +886,7 @@ namespace origin
       edge find_edge(vertex u, vertex v) const;
 
       template<typename S, typename P>
-        edge find_endpoints(const S& seq, P pred) const;
+        edge find_endpoints(vertex x, const S& seq, P pred) const;
 
       void link_edge(vertex u, vertex v, edge e);
     
@@ -680,9 +896,9 @@ namespace origin
     };
 
   // Returns true if the an edge {u, v} is in the graph.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::operator()(vertex u, vertex v) const -> edge
+    undirected_adjacency_vector<V, E, N, A>::operator()(vertex u, vertex v) const -> edge
     {
       if (degree(u) <= degree(v))
         return find_edge(u, v);
@@ -696,100 +912,104 @@ namespace origin
   // Note that, if u and v are connected, then the edge was added as either
   // (u, v) or (v, u). We prefer to search the vertex with the smaller degree
   // for evidence of either construction.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::find_edge(vertex u, vertex v) const -> edge
+    undirected_adjacency_vector<V, E, N, A>::find_edge(vertex u, vertex v) const -> edge
     {
       using P = has_endpoints<this_type>;
       const vertex_node& n = node(v);
-      return find_endpoints(n.edges(), P(*this, u, v));
+      return find_endpoints(v, n.edges(), P(*this, u, v));
     }
 
   // Return an edge whose endpoints satisfy the given predicate. The primary
   // function of this operation is to find endpoints with source/target pairs.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     template<typename S, typename P>
       inline auto
-      undirected_adjacency_vector<V, E>::
-        find_endpoints(const S& seq, P pred) const -> edge
+      undirected_adjacency_vector<V, E, N, A>::
+        find_endpoints(vertex x, const S& seq, P pred) const -> edge
         {
           auto i = find_if(seq, pred);
+          ORIGIN_GRAPH_SEARCH(x, instrument_impl::probes(seq, i));
           return i == seq.end() ? edge() : *i;
         }
 
 
   // Add a vertex to the graph, returning a handle to the new object. If
   // V is a user-supplied type, its value is default constructed.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::add_vertex() -> vertex
+    undirected_adjacency_vector<V, E, N, A>::add_vertex() -> vertex
     {
       return emplace_vertex();
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::add_vertex(V&& x) -> vertex
+    undirected_adjacency_vector<V, E, N, A>::add_vertex(V&& x) -> vertex
     {
       return emplace_vertex(std::move(x));
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::add_vertex(const V& x) -> vertex
+    undirected_adjacency_vector<V, E, N, A>::add_vertex(const V& x) -> vertex
     {
       return emplace_vertex(x);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     template<typename... Args>
       inline auto
-      undirected_adjacency_vector<V, E>::emplace_vertex(Args&&... args) -> vertex
+      undirected_adjacency_vector<V, E, N, A>::emplace_vertex(Args&&... args) -> vertex
       {
         vertex v = verts_.size();
+        ORIGIN_GRAPH_GROWTH(verts_);
         verts_.emplace_back(std::forward<Args>(args)...);
         return v;
       }
 
   // Add a defaul edge from u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::add_edge(vertex u, vertex v) -> edge
+    undirected_adjacency_vector<V, E, N, A>::add_edge(vertex u, vertex v) -> edge
     {
       return emplace_edge(u, v);
     }
 
   // Move x into an edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::add_edge(vertex u, vertex v, E&& x) -> edge
+    undirected_adjacency_vector<V, E, N, A>::add_edge(vertex u, vertex v, E&& x) -> edge
     {
       return emplace_edge(u, v, std::move(x));
     }
 
   // Copy x into an edge connecting u to v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::add_edge(vertex u, vertex v, const E& x) -> edge
+    undirected_adjacency_vector<V, E, N, A>::add_edge(vertex u, vertex v, const E& x) -> edge
     {
       return emplace_edge(u, v, x);
     }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     template<typename... Args>
       inline auto
-      undirected_adjacency_vector<V, E>::
+      undirected_adjacency_vector<V, E, N, A>::
         emplace_edge(vertex u, vertex v, Args&&... args) -> edge
       {
         edge e = edges_.size();
+        ORIGIN_GRAPH_COUNT(add_edge, 1);
+        ORIGIN_GRAPH_GROWTH(edges_);
         edges_.emplace_back(u, v, std::forward<Args>(args)...);
         link_edge(u, v, e);
         return e;
       }
 
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline void
-    undirected_adjacency_vector<V, E>::link_edge(vertex u, vertex v, edge e)
+    undirected_adjacency_vector<V, E, N, A>::link_edge(vertex u, vertex v, edge e)
     {
       vertex_node& un = node(u);
       vertex_node& vn = node(v);
@@ -797,26 +1017,81 @@ namespace origin
       vn.insert(e);
     }
 
+  // Returns the memory used by the graph, as described in [graph.memory].
+  template<typename V, typename E, typename N, typename A>
+    graph_memory
+    undirected_adjacency_vector<V, E, N, A>::memory_usage() const
+    {
+      using namespace memory_impl;
+      constexpr std::size_t pv = payload_size<V>();
+      constexpr std::size_t pe = payload_size<E>();
+      graph_memory m {};
+      m.vertices = block(verts_, sizeof(vertex_node) - pv);
+      m.edges = block(edges_, sizeof(edge_node) - pe);
+      m.payload = block(verts_, pv) + block(edges_, pe);
+      for (const vertex_node& n : verts_)
+        m.incidence += block(n.edges());
+      return m;
+    }
+
+  // Release the capacity reserved beyond the size of the vertex set, the
+  // edge set, and each incidence list.
+  template<typename V, typename E, typename N, typename A>
+    void
+    undirected_adjacency_vector<V, E, N, A>::shrink_to_fit()
+    {
+      verts_.shrink_to_fit();
+      edges_.shrink_to_fit();
+      for (vertex_node& n : verts_) {
+        n.edges().shrink_to_fit();
+      }
+    }
+
+  // Move the vertex and edge arrays into arrays allocated by the given
+  // allocators, as for the directed adjacency vector.
+  template<typename V, typename E, typename N, typename A>
+    void
+    undirected_adjacency_vector<V, E, N, A>::relocate(const A& vertices,
+                                                      const A& edges)
+    {
+      adjacency_vector_impl::move_array(verts_, vertices);
+      adjacency_vector_impl::move_array(edges_, edges);
+    }
+
+  // Reallocate the incidence lists of the vertices in [first, last), as for
+  // the directed adjacency vector.
+  template<typename V, typename E, typename N, typename A>
+    void
+    undirected_adjacency_vector<V, E, N, A>::relocate_incidence(std::size_t first,
+                                                                std::size_t last)
+    {
+      for (std::size_t i = first; i != last; ++i) {
+        vertex_node& n = verts_[i];
+        auto edges = n.edges();
+        n.edges().swap(edges);
+      }
+    }
+
   // Retrun a range over the vertex set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::vertices() const -> vertex_range
+    undirected_adjacency_vector<V, E, N, A>::vertices() const -> vertex_range
     {
-      return {vertex_iter(verts_.begin()), vertex_iter(verts_.end())};
+      return {vertex_iter(0), vertex_iter(verts_.size())};
     }
 
   // Return a range over the edge set.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::edges() const -> edge_range
+    undirected_adjacency_vector<V, E, N, A>::edges() const -> edge_range
     {
-      return {edge_iter(edges_.begin()), edge_iter(edges_.end())};
+      return {edge_iter(0), edge_iter(edges_.size())};
     }
 
   // Return a range over the out edges of the vertex v.
-  template<typename V, typename E>
+  template<typename V, typename E, typename N, typename A>
     inline auto
-    undirected_adjacency_vector<V, E>::edges(vertex v) const -> incidence_range
+    undirected_adjacency_vector<V, E, N, A>::edges(vertex v) const -> incidence_range
     {
       const vertex_node& vn = node(v);
       return {incidence_iter(vn.begin()), incidence_iter(vn.end())};
@@ -6,6 +6,7 @@
 // and conditions.
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
 #include <origin/graph/adjacency_vector.hpp>
@@ -27,4 +28,17 @@ int main()
   check_default_init<D>();
   check_add_vertices<D>();
   check_add_edges<D>();
+
+  // 32 bit handles.
+  using G32 = undirected_adjacency_vector<char, int, uint32_t>;
+  static_assert(sizeof(Vertex<G32>) == 4, "");
+  static_assert(sizeof(Edge<G32>) == 4, "");
+  check_default_init<G32>();
+  check_add_vertices<G32>();
+  check_add_edges<G32>();
+
+  using D32 = directed_adjacency_vector<char, int, uint32_t>;
+  check_default_init<D32>();
+  check_add_vertices<D32>();
+  check_add_edges<D32>();
 }
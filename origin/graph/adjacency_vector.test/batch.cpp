@@ -0,0 +1,57 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_vector.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using G = directed_adjacency_vector<empty_t, int>;
+using G32 = directed_adjacency_vector<empty_t, int, uint32_t>;
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  G g;
+  for (int i = 0; i < 3; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1, 10);
+  g.add_edge(0, 1, 11);
+  g.add_edge(1, 2, 12);
+  g.add_edge(2, 2, 13);
+
+  // Replacing an edge deletes the old one and adds the new one, and a
+  // deletion of a missing edge has no effect. The remaining edges are
+  // renumbered in order.
+  g.apply_batch({G::edge_insertion(0, 1, 20), G::edge_insertion(2, 0, 21)},
+                {{0, 1}, {2, 2}, {1, 0}});
+  assert(g.size() == 4);
+  assert(g(G::edge(0)) == 11 && g(G::edge(1)) == 12);
+  assert(g(G::edge(2)) == 20 && g(G::edge(3)) == 21);
+  assert(g.out_degree(0) == 2 && g.in_degree(1) == 2);
+  assert(g.out_degree(2) == 1 && g.in_degree(2) == 1);
+  assert(g(0, 1) == 0 && g(2, 0) == 3);
+
+  g.apply_batch({}, {});
+  assert(g.size() == 4);
+}
+
+int main()
+{
+  check_small();
+  cout << "*** random ***\n";
+  check_random_batches<G>(1);
+  check_random_batches<G>(4);
+  check_random_batches<G32>(3);
+}
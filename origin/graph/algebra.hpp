@@ -0,0 +1,533 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_ALGEBRA_HPP
+#define ORIGIN_GRAPH_ALGEBRA_HPP
+
+#include <cassert>
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <origin/math/matrix/matrix.hpp>
+
+#include <origin/graph/graph.hpp>
+#include <origin/graph/parallel.hpp>
+#include <origin/graph/shortest_paths.hpp>
+#include <origin/graph/traversal.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                             [graph.algebra]
+  //                            Sparse Matrix
+  //
+  // A sparse matrix stores the non-zero entries of a matrix in compressed
+  // sparse row form: the entries of row i are the positions [first(i),
+  // last(i)), each with a column and a value, in increasing column order.
+  // A column may repeat within a row; repeated entries are combined by the
+  // addition of whatever semiring the matrix is used with.
+  template<typename T>
+    class sparse_matrix
+    {
+    public:
+      using value_type = T;
+
+      sparse_matrix()
+        : rows_(0), cols_(0), offset_(1, 0)
+      { }
+
+      // Initialize the matrix from its row offsets, columns, and values. The
+      // offsets have rows + 1 elements, and the columns of each row must be
+      // sorted.
+      sparse_matrix(std::size_t rows, std::size_t cols,
+                    std::vector<std::size_t> offset,
+                    std::vector<std::size_t> column,
+                    std::vector<T> value);
+
+      std::size_t rows() const { return rows_; }
+      std::size_t cols() const { return cols_; }
+
+      // Returns the number of stored entries.
+      std::size_t nonzeros() const { return column_.size(); }
+
+      // Entry access
+      std::size_t first(std::size_t i) const { return offset_[i]; }
+      std::size_t last(std::size_t i) const  { return offset_[i + 1]; }
+
+      std::size_t column(std::size_t a) const { return column_[a]; }
+      T           value(std::size_t a) const  { return value_[a]; }
+
+      // Returns the transpose of the matrix.
+      sparse_matrix transpose() const;
+
+      // Returns the matrix as a dense matrix, where absent entries are z.
+      matrix<T, 2> dense(T z = T()) const;
+
+    private:
+      std::size_t rows_;
+      std::size_t cols_;
+      std::vector<std::size_t> offset_;
+      std::vector<std::size_t> column_;
+      std::vector<T> value_;
+    };
+
+  template<typename T>
+    sparse_matrix<T>::sparse_matrix(std::size_t rows, std::size_t cols,
+                                    std::vector<std::size_t> offset,
+                                    std::vector<std::size_t> column,
+                                    std::vector<T> value)
+      : rows_(rows), cols_(cols), offset_(std::move(offset)),
+        column_(std::move(column)), value_(std::move(value))
+    {
+      assert(offset_.size() == rows_ + 1);
+      assert(column_.size() == offset_.back());
+      assert(value_.size() == column_.size());
+    }
+
+  // Transpose by counting the entries of each column. Scanning the rows in
+  // order leaves the columns of the result sorted.
+  template<typename T>
+    auto
+    sparse_matrix<T>::transpose() const -> sparse_matrix
+    {
+      std::vector<std::size_t> offset(cols_ + 1, 0);
+      for (std::size_t c : column_)
+        ++offset[c + 1];
+      for (std::size_t j = 0; j < cols_; ++j)
+        offset[j + 1] += offset[j];
+      std::vector<std::size_t> column(nonzeros());
+      std::vector<T> value(nonzeros());
+      std::vector<std::size_t> pos(offset.begin(), offset.end() - 1);
+      for (std::size_t i = 0; i < rows_; ++i)
+        for (std::size_t a = first(i); a != last(i); ++a) {
+          std::size_t p = pos[column_[a]]++;
+          column[p] = i;
+          value[p] = value_[a];
+        }
+      return {cols_, rows_, std::move(offset), std::move(column), std::move(value)};
+    }
+
+  template<typename T>
+    matrix<T, 2>
+    sparse_matrix<T>::dense(T z) const
+    {
+      matrix<T, 2> m(rows_, cols_);
+      std::fill(m.data(), m.data() + rows_ * cols_, z);
+      for (std::size_t i = 0; i < rows_; ++i)
+        for (std::size_t a = first(i); a != last(i); ++a)
+          m(i, column_[a]) = value_[a];
+      return m;
+    }
+
+
+  // ------------------------------------------------------------------------ //
+  //                          Adjacency Matrices
+  //
+  // The adjacency matrix of g has an entry (u, v) for each edge from u to
+  // v: each out edge of a directed graph, or each incident edge of an
+  // undirected graph, so that an undirected edge has entries (u, v) and
+  // (v, u), and a loop has one entry. The value of the entry for the edge e
+  // is weight(e), the edge's value g(e), or 1 in a pattern matrix. Parallel
+  // edges give repeated entries.
+  //
+  //    adjacency_matrix(g)
+  //    adjacency_matrix(g, weight)
+  //    pattern_matrix<T>(g)
+  //
+  // These functions require the vertex handles of g to be the integers in
+  // [0, g.order()).
+  template<typename G, typename W>
+    sparse_matrix<apsp_impl::Distance_type<G, W>>
+    adjacency_matrix(const G& g, W weight)
+    {
+      using T = apsp_impl::Distance_type<G, W>;
+      std::size_t n = g.order();
+      std::vector<std::size_t> offset(n + 1, 0);
+      std::vector<std::size_t> column;
+      std::vector<T> value;
+      std::vector<std::pair<std::size_t, T>> row;
+      std::vector<Edge<G>> loops;
+      for (std::size_t v = 0; v < n; ++v) {
+        Vertex<G> u(v);
+        row.clear();
+        loops.clear();
+        for (auto e : traversal_impl::leaving(g, u)) {
+          Vertex<G> w = traversal_impl::head(g, e, u);
+          // A loop appears twice in the incidence list of an undirected
+          // graph; keep the first copy.
+          if (Undirected_graph<G>() && w == u) {
+            auto i = std::find(loops.begin(), loops.end(), e);
+            if (i != loops.end()) {
+              loops.erase(i);
+              continue;
+            }
+            loops.push_back(e);
+          }
+          row.emplace_back(w, weight(e));
+        }
+        std::stable_sort(row.begin(), row.end(), [](const std::pair<std::size_t, T>& a,
+                                                    const std::pair<std::size_t, T>& b) {
+          return a.first < b.first;
+        });
+        for (auto& x : row) {
+          column.push_back(x.first);
+          value.push_back(x.second);
+        }
+        offset[v + 1] = column.size();
+      }
+      return {n, n, std::move(offset), std::move(column), std::move(value)};
+    }
+
+  template<typename G>
+    inline sparse_matrix<apsp_impl::Distance_type<G, edge_value<G>>>
+    adjacency_matrix(const G& g)
+    {
+      return adjacency_matrix(g, edge_value<G>(g));
+    }
+
+  template<typename T, typename G>
+    inline sparse_matrix<T>
+    pattern_matrix(const G& g)
+    {
+      return adjacency_matrix(g, [](Edge<G>) { return T(1); });
+    }
+
+
+  // ------------------------------------------------------------------------ //
+  //                              Semirings
+  //
+  // A semiring gives the operations of a matrix-vector product: add, an
+  // associative and commutative operation whose identity is zero(), and
+  // multiply. Replacing the arithmetic semiring with another turns the
+  // product into a step of a graph algorithm:
+  //
+  //    plus_times<T>   arithmetic, for PageRank and other linear iterations
+  //    min_plus<T>     tropical, for shortest paths
+  //    or_and          boolean, for reachability
+  //    or_first        boolean, ignoring the matrix entries, for breadth-first
+  //                    search over the pattern of a matrix
+  template<typename T>
+    struct plus_times
+    {
+      using value_type = T;
+
+      static T zero() { return T(0); }
+      static T add(T a, T b) { return a + b; }
+      static T multiply(T a, T b) { return a * b; }
+    };
+
+  // The zero of min_plus is infinite_distance<T>(), which multiplication
+  // preserves.
+  template<typename T>
+    struct min_plus
+    {
+      using value_type = T;
+
+      static T zero() { return infinite_distance<T>(); }
+      static T add(T a, T b) { return b < a ? b : a; }
+      static T multiply(T a, T b)
+      {
+        return (a == zero() || b == zero()) ? zero() : T(a + b);
+      }
+    };
+
+  struct or_and
+  {
+    using value_type = bool;
+
+    static bool zero() { return false; }
+    static bool add(bool a, bool b) { return a || b; }
+    static bool multiply(bool a, bool b) { return a && b; }
+  };
+
+  // The product of x and a is x, so that every stored entry of a matrix
+  // counts as an edge, whatever its value. This semiring is for products
+  // of a vector with a matrix.
+  struct or_first
+  {
+    using value_type = bool;
+
+    static bool zero() { return false; }
+    static bool add(bool a, bool b) { return a || b; }
+    static bool multiply(bool a, bool) { return a; }
+  };
+
+
+  // A sparse vector stores the indexes of its non-zero elements, in
+  // increasing order, and their values.
+  template<typename T>
+    struct sparse_vector
+    {
+      std::size_t nonzeros() const { return index.size(); }
+
+      std::size_t size;
+      std::vector<std::size_t> index;
+      std::vector<T> value;
+    };
+
+
+  // ------------------------------------------------------------------------ //
+  //                        Matrix-Vector Products
+  //
+  //    mxv<S>(a, x, threads)     y(i) = sum of a(i, j) * x(j), over j
+  //    vxm<S>(x, a)              y(j) = sum of x(i) * a(i, j), over i
+  //    vxm<S>(x, a, mask)        the same, keeping the j for which mask(j)
+  //    vxm<S>(x, a, mask, w)     the same, accumulating in the workspace w
+  //
+  // where the sum and product are those of the semiring S. The first is a
+  // product with a dense vector, in which each row of a is reduced by one
+  // thread, and is efficient when most of x is non-zero. The second is a
+  // product of a sparse vector with a sparse matrix, which touches only the
+  // rows of a selected by x, and is efficient for small frontiers. Zero
+  // elements are not stored in its result.
+  //
+  // The sparse product accumulates into a dense workspace, which is left
+  // cleared by resetting only the entries it touched. A workspace kept
+  // across products, as by a sequence of frontiers, is allocated once, and
+  // each product then costs only the entries of a in the rows selected by
+  // x (plus sorting the result).
+
+  namespace algebra_impl
+  {
+    // The storage of a dense result. A vector of bool packs its elements
+    // into words, which threads could not write concurrently, so boolean
+    // results are stored as chars and converted.
+    template<typename R>
+      struct dense_store
+      {
+        using type = R;
+
+        static std::vector<R> release(std::vector<R>& y) { return std::move(y); }
+      };
+
+    template<>
+      struct dense_store<bool>
+      {
+        using type = char;
+
+        static std::vector<bool> release(std::vector<char>& y)
+        {
+          return {y.begin(), y.end()};
+        }
+      };
+
+  } // namespace algebra_impl
+
+  // The dense accumulator of a sparse product, which grows to the number
+  // of columns of the matrices it is used with.
+  template<typename R>
+    struct sparse_workspace
+    {
+      // Make the workspace large enough for n columns.
+      void fit(std::size_t n)
+      {
+        if (hit.size() < n) {
+          acc.resize(n);
+          hit.resize(n, 0);
+        }
+      }
+
+      std::vector<R> acc;
+      std::vector<char> hit;
+      std::vector<std::size_t> touched;
+    };
+
+  // The mask that keeps every element.
+  struct keep_all_indexes
+  {
+    bool operator()(std::size_t) const { return true; }
+  };
+
+  template<typename S, typename T, typename U>
+    std::vector<typename S::value_type>
+    mxv(const sparse_matrix<T>& a, const std::vector<U>& x, std::size_t threads = 0)
+    {
+      using R = typename S::value_type;
+      using Store = algebra_impl::dense_store<R>;
+      assert(x.size() == a.cols());
+      std::vector<typename Store::type> y(a.rows());
+      parallel_blocks(a.rows(), [&](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i != e; ++i) {
+          R sum = S::zero();
+          for (std::size_t k = a.first(i); k != a.last(i); ++k)
+            sum = S::add(sum, S::multiply(R(a.value(k)), R(x[a.column(k)])));
+          y[i] = sum;
+        }
+      }, threads);
+      return Store::release(y);
+    }
+
+  template<typename S, typename T, typename U, typename M>
+    sparse_vector<typename S::value_type>
+    vxm(const sparse_vector<U>& x, const sparse_matrix<T>& a, M mask,
+        sparse_workspace<typename S::value_type>& w)
+    {
+      using R = typename S::value_type;
+      assert(x.size == a.rows());
+      w.fit(a.cols());
+      auto& acc = w.acc;
+      auto& hit = w.hit;
+      auto& touched = w.touched;
+      touched.clear();
+      for (std::size_t p = 0; p < x.nonzeros(); ++p) {
+        std::size_t i = x.index[p];
+        R xi = R(x.value[p]);
+        for (std::size_t k = a.first(i); k != a.last(i); ++k) {
+          std::size_t j = a.column(k);
+          if (!mask(j))
+            continue;
+          if (!hit[j]) {
+            hit[j] = 1;
+            acc[j] = S::zero();
+            touched.push_back(j);
+          }
+          acc[j] = S::add(acc[j], S::multiply(xi, R(a.value(k))));
+        }
+      }
+      std::sort(touched.begin(), touched.end());
+      sparse_vector<R> y {a.cols(), {}, {}};
+      for (std::size_t j : touched) {
+        if (!(acc[j] == S::zero())) {
+          y.index.push_back(j);
+          y.value.push_back(acc[j]);
+        }
+        hit[j] = 0;
+      }
+      return y;
+    }
+
+  template<typename S, typename T, typename U, typename M>
+    inline sparse_vector<typename S::value_type>
+    vxm(const sparse_vector<U>& x, const sparse_matrix<T>& a, M mask)
+    {
+      sparse_workspace<typename S::value_type> w;
+      return vxm<S>(x, a, mask, w);
+    }
+
+  template<typename S, typename T, typename U>
+    inline sparse_vector<typename S::value_type>
+    vxm(const sparse_vector<U>& x, const sparse_matrix<T>& a)
+    {
+      return vxm<S>(x, a, keep_all_indexes{});
+    }
+
+
+  // ------------------------------------------------------------------------ //
+  //                         Algebraic Algorithms
+  //
+  // The following algorithms are written as sequences of semiring products
+  // over an adjacency matrix a, in which a(u, v) is the edge from u to v.
+  //
+  //    algebraic_bfs(a, s)
+  //    algebraic_shortest_paths(a, s, threads)
+  //    pagerank(a, damping, tol, threads)
+
+  // Returns the number of edges on a shortest path from s to each vertex,
+  // or npos for vertices not reachable from s. Each level is the product of
+  // the frontier with a over the or_first semiring, masked by the vertices
+  // not yet reached. The levels share one workspace.
+  template<typename T>
+    std::vector<std::size_t>
+    algebraic_bfs(const sparse_matrix<T>& a, std::size_t s)
+    {
+      constexpr std::size_t npos = -1;
+      std::vector<std::size_t> level(a.rows(), npos);
+      sparse_vector<bool> f {a.rows(), {s}, {true}};
+      sparse_workspace<bool> w;
+      level[s] = 0;
+      for (std::size_t d = 1; f.nonzeros(); ++d) {
+        auto unreached = [&](std::size_t j) { return level[j] == npos; };
+        f = vxm<or_first>(f, a, unreached, w);
+        for (std::size_t j : f.index)
+          level[j] = d;
+      }
+      return level;
+    }
+
+  // Returns the distance from s to each vertex, where the length of an edge
+  // is its entry in a, by the Bellman-Ford algorithm: the distances are
+  // repeatedly relaxed by a min-plus product with the transpose of a, until
+  // they no longer change. There must be no negative cycles.
+  template<typename T>
+    std::vector<T>
+    algebraic_shortest_paths(const sparse_matrix<T>& a, std::size_t s,
+                             std::size_t threads = 0)
+    {
+      using S = min_plus<T>;
+      sparse_matrix<T> at = a.transpose();
+      std::vector<T> d(a.rows(), S::zero());
+      d[s] = T(0);
+      for (std::size_t i = 0; i < a.rows(); ++i) {
+        std::vector<T> y = mxv<S>(at, d, threads);
+        bool changed = false;
+        for (std::size_t v = 0; v < d.size(); ++v)
+          if (y[v] < d[v]) {
+            d[v] = y[v];
+            changed = true;
+          }
+        if (!changed)
+          break;
+      }
+      return d;
+    }
+
+  // Returns the PageRank of each vertex: the stationary distribution of a
+  // walk that follows a uniformly chosen out edge with probability damping,
+  // and otherwise jumps to a uniformly chosen vertex. The walk jumps from
+  // vertices without out edges. The entries of a are ignored. Each iteration
+  // is a product with the transpose of a, scaled by the reciprocals of the
+  // out degrees, and iteration stops when the ranks change by less than tol
+  // in total, or after 1000 iterations.
+  template<typename T>
+    std::vector<double>
+    pagerank(const sparse_matrix<T>& a, double damping = 0.85,
+             double tol = 1e-10, std::size_t threads = 0)
+    {
+      std::size_t n = a.rows();
+      if (n == 0)
+        return {};
+
+      // The transition matrix, with an entry 1 / outdegree(u) for each edge
+      // from u to v, at (v, u).
+      std::vector<double> value(a.nonzeros());
+      for (std::size_t u = 0; u < n; ++u)
+        for (std::size_t k = a.first(u); k != a.last(u); ++k)
+          value[k] = 1.0 / (a.last(u) - a.first(u));
+      std::vector<std::size_t> offset(n + 1), column(a.nonzeros());
+      for (std::size_t u = 0; u <= n; ++u)
+        offset[u] = u < n ? a.first(u) : a.nonzeros();
+      for (std::size_t k = 0; k < a.nonzeros(); ++k)
+        column[k] = a.column(k);
+      sparse_matrix<double> p =
+        sparse_matrix<double>(n, n, offset, column, value).transpose();
+
+      std::vector<double> r(n, 1.0 / n);
+      for (std::size_t iter = 0; iter < 1000; ++iter) {
+        double dangling = 0;
+        for (std::size_t u = 0; u < n; ++u)
+          if (a.first(u) == a.last(u))
+            dangling += r[u];
+        std::vector<double> y = mxv<plus_times<double>>(p, r, threads);
+        double base = (1 - damping + damping * dangling) / n;
+        double delta = 0;
+        for (std::size_t v = 0; v < n; ++v) {
+          y[v] = base + damping * y[v];
+          delta += std::abs(y[v] - r[v]);
+        }
+        r.swap(y);
+        if (delta < tol)
+          break;
+      }
+      return r;
+    }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,180 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/algebra.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using D = directed_adjacency_vector<empty_t, int>;
+using U = undirected_adjacency_vector<empty_t, int>;
+
+// Returns the number of edges from s to each vertex by a breadth-first
+// search.
+template<typename G>
+  vector<size_t>
+  bfs_levels(const G& g, size_t s)
+  {
+    vector<size_t> level(g.order(), size_t(-1));
+    vector<size_t> q {s};
+    level[s] = 0;
+    for (size_t i = 0; i < q.size(); ++i) {
+      Vertex<G> u(q[i]);
+      for (auto e : traversal_impl::leaving(g, u)) {
+        size_t w = traversal_impl::head(g, e, u);
+        if (level[w] == size_t(-1)) {
+          level[w] = level[q[i]] + 1;
+          q.push_back(w);
+        }
+      }
+    }
+    return level;
+  }
+
+void
+check_matrix()
+{
+  cout << "*** matrix ***\n";
+  D d;
+  for (int i = 0; i < 3; ++i)
+    d.add_vertex();
+  d.add_edge(0, 2, 5);
+  d.add_edge(0, 1, 3);
+  d.add_edge(2, 0, 7);
+  auto a = adjacency_matrix(d);
+  assert(a.rows() == 3 && a.cols() == 3 && a.nonzeros() == 3);
+  assert(a.first(0) == 0 && a.last(0) == 2 && a.last(1) == 2);
+  assert(a.column(0) == 1 && a.value(0) == 3);
+  assert(a.column(1) == 2 && a.value(1) == 5);
+  auto m = a.dense();
+  assert(m(0, 1) == 3 && m(0, 2) == 5 && m(2, 0) == 7 && m(1, 0) == 0);
+  auto p = mxv<or_and>(pattern_matrix<bool>(d), vector<bool>({false, false, true}));
+  assert(p == vector<bool>({true, false, false}));
+  auto t = a.transpose().dense();
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      assert(t(i, j) == m(j, i));
+
+  // Undirected edges give symmetric entries, a loop gives one, and parallel
+  // edges give repeated entries.
+  U u;
+  for (int i = 0; i < 3; ++i)
+    u.add_vertex();
+  u.add_edge(0, 1, 4);
+  u.add_edge(1, 1, 2);
+  u.add_edge(1, 2, 1);
+  u.add_edge(2, 1, 6);
+  auto b = pattern_matrix<int>(u);
+  assert(b.nonzeros() == 7);
+  auto s = mxv<plus_times<int>>(b, vector<int>(3, 1));
+  assert(s == vector<int>({1, 4, 2}));
+  auto c = adjacency_matrix(u);
+  auto x = mxv<min_plus<int>>(c, vector<int>(3, 0));
+  assert(x == vector<int>({4, 1, 1}));
+
+  sparse_vector<int> f {3, {1}, {1}};
+  auto y = vxm<plus_times<int>>(f, b);
+  assert(y.index == vector<size_t>({0, 1, 2}));
+  assert(y.value == vector<int>({1, 1, 2}));
+
+  // A workspace is left cleared, and gives the same products when reused.
+  sparse_workspace<int> w;
+  auto odd = [](size_t j) { return j % 2 == 1; };
+  for (int i = 0; i < 2; ++i) {
+    auto z = vxm<plus_times<int>>(f, b, keep_all_indexes{}, w);
+    assert(z.index == y.index && z.value == y.value);
+    z = vxm<plus_times<int>>(f, b, odd, w);
+    assert(z.index == vector<size_t>({1}) && z.value == vector<int>({1}));
+    for (char h : w.hit)
+      assert(!h);
+  }
+}
+
+template<typename G>
+  void
+  check_graph(const G& g)
+  {
+    auto a = adjacency_matrix(g);
+    auto d = johnson_shortest_paths(g);
+    for (size_t s = 0; s < g.order(); s += 7) {
+      assert(algebraic_bfs(a, s) == bfs_levels(g, s));
+      auto x = algebraic_shortest_paths(a, s, 4);
+      for (size_t v = 0; v < g.order(); ++v)
+        assert(x[v] == d(s, v));
+    }
+    vector<int> x(g.order());
+    for (size_t i = 0; i < x.size(); ++i)
+      x[i] = int(i % 5);
+    assert(mxv<plus_times<int>>(a, x, 1) == mxv<plus_times<int>>(a, x, 4));
+  }
+
+void
+check_random()
+{
+  cout << "*** random ***\n";
+  for (unsigned seed = 1; seed <= 3; ++seed) {
+    check_graph(random_graph<D>(200, 600, seed, uniform_values(0, 20)));
+    check_graph(random_graph<U>(200, 300, seed, uniform_values(0, 20)));
+  }
+}
+
+void
+check_pagerank()
+{
+  cout << "*** pagerank ***\n";
+  // A directed cycle has uniform rank.
+  D c;
+  for (int i = 0; i < 5; ++i)
+    c.add_vertex();
+  for (int i = 0; i < 5; ++i)
+    c.add_edge(i, (i + 1) % 5, 1);
+  for (double r : pagerank(adjacency_matrix(c)))
+    assert(abs(r - 0.2) < 1e-9);
+
+  // A star pointing to its center, which has no out edges. The leaves
+  // each receive only the jumps, which total 1 - damping of the leaves'
+  // mass and all of the center's.
+  D s;
+  for (int i = 0; i < 4; ++i)
+    s.add_vertex();
+  for (int i = 1; i < 4; ++i)
+    s.add_edge(i, 0, 1);
+  auto r = pagerank(adjacency_matrix(s), 0.85, 1e-12, 2);
+  double sum = r[0] + r[1] + r[2] + r[3];
+  assert(abs(sum - 1) < 1e-9);
+  double leaf = (1 - 0.85 * (1 - r[0])) / 4;
+  for (int i = 1; i < 4; ++i)
+    assert(abs(r[i] - leaf) < 1e-9);
+  assert(r[0] > r[1]);
+
+  // Ranks sum to 1 on a random graph, whatever the number of threads.
+  auto a = adjacency_matrix(random_graph<D>(300, 900, 1, uniform_values(0, 20)));
+  auto r1 = pagerank(a, 0.85, 1e-10, 1);
+  auto r4 = pagerank(a, 0.85, 1e-10, 4);
+  double total = 0;
+  for (size_t i = 0; i < r1.size(); ++i) {
+    total += r1[i];
+    assert(r1[i] == r4[i]);
+  }
+  assert(abs(total - 1) < 1e-9);
+  assert(pagerank(adjacency_matrix(D())).empty());
+}
+
+int main()
+{
+  check_matrix();
+  check_random();
+  check_pagerank();
+}
@@ -0,0 +1,222 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_BATCH_HPP
+#define ORIGIN_GRAPH_BATCH_HPP
+
+#include <cassert>
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <origin/graph/parallel.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                               [graph.batch]
+  //                            Edge Batches
+  //
+  // A batch of edge updates is applied to a directed graph by grouping the
+  // updates by vertex and rewriting the incidence lists of the affected
+  // vertices, each in one pass, in parallel across vertices. The out lists
+  // are rewritten first, grouped by source, and then the in lists, grouped
+  // by target.
+  //
+  // These functions are the shared implementation of apply_batch for the
+  // directed adjacency vector and list.
+  namespace batch_impl
+  {
+    // The updates to the incidence list of one vertex: the sorted deletion
+    // keys [del_first, del_last), and the inserted edges [ins_first,
+    // ins_last).
+    struct vertex_updates
+    {
+      std::size_t vertex;
+      std::size_t del_first, del_last;
+      std::size_t ins_first, ins_last;
+    };
+
+    // The number of vertices updated by one thread, at least.
+    constexpr std::size_t grain = 256;
+
+    // Given the vertices of the deletions and insertions, each sorted, return
+    // the updates of each vertex that appears in either.
+    inline std::vector<vertex_updates>
+    group_updates(const std::vector<std::size_t>& del,
+                  const std::vector<std::size_t>& ins)
+    {
+      std::vector<vertex_updates> r;
+      std::size_t i = 0, j = 0;
+      while (i != del.size() || j != ins.size()) {
+        std::size_t v;
+        if (j == ins.size() || (i != del.size() && del[i] < ins[j]))
+          v = del[i];
+        else
+          v = ins[j];
+        vertex_updates u {v, i, i, j, j};
+        while (i != del.size() && del[i] == v)
+          ++i;
+        while (j != ins.size() && ins[j] == v)
+          ++j;
+        u.del_last = i;
+        u.ins_last = j;
+        r.push_back(u);
+      }
+      return r;
+    }
+
+    // Rewrite the incidence list l, removing, for each key in the sorted
+    // sequence [del, del + m), the first remaining element whose key is the
+    // same, and then appending [ins, ins + k). The removed elements are
+    // appended to removed.
+    template<typename L, typename Key>
+      void
+      merge_list(L& l, const std::size_t* del, std::size_t m,
+                 const typename L::value_type* ins, std::size_t k, Key key,
+                 L& removed)
+      {
+        if (m) {
+          // The number of times each run of equal keys has matched, indexed
+          // by the start of the run.
+          std::vector<std::size_t> used(m, 0);
+          auto out = l.begin();
+          for (auto i = l.begin(); i != l.end(); ++i) {
+            std::size_t x = key(*i);
+            const std::size_t* p = std::lower_bound(del, del + m, x);
+            if (p != del + m && *p == x) {
+              std::size_t& n = used[p - del];
+              if (p + n != del + m && p[n] == x) {
+                ++n;
+                removed.push_back(*i);
+                continue;
+              }
+            }
+            *out++ = *i;
+          }
+          l.erase(out, l.end());
+        }
+        l.insert(l.end(), ins, ins + k);
+      }
+
+    // Apply a batch to the incidence lists of a directed graph. The new
+    // edges have already been added to the edge set, and edge i, added[i],
+    // connects ins_source[i] to ins_target[i]. Each deletion (u, v) removes
+    // one edge from u to v that was in the graph before the batch, if any.
+    //
+    // The function node(v) returns the vertex node of v, which has out() and
+    // in() incidence lists. It is called by this thread only, before the
+    // lists are rewritten. The function target(e) returns the target of e,
+    // and may be called concurrently.
+    //
+    // Returns the removed edges, which are still in the edge set.
+    template<typename L, typename D, typename Node, typename Target>
+      L
+      apply(const std::vector<std::size_t>& ins_source,
+            const std::vector<std::size_t>& ins_target,
+            const L& added, const std::vector<D>& deletions,
+            Node node, Target target, std::size_t threads)
+      {
+        using Edge = typename L::value_type;
+        using Pair = std::pair<std::size_t, std::size_t>;
+        assert(added.size() == ins_source.size());
+        assert(added.size() == ins_target.size());
+        using Vertex_node = typename std::remove_reference<
+          decltype(node(std::size_t()))
+        >::type;
+
+        // Sort the deletions by source and target, and the insertions by
+        // source, preserving their order.
+        std::vector<Pair> del(deletions.size());
+        for (std::size_t i = 0; i < del.size(); ++i)
+          del[i] = {deletions[i].first, deletions[i].second};
+        parallel_sort(del.begin(), del.end(), std::less<Pair>(), threads);
+        std::vector<Pair> ins(added.size());
+        for (std::size_t i = 0; i < ins.size(); ++i)
+          ins[i] = {ins_source[i], i};
+        parallel_sort(ins.begin(), ins.end(), std::less<Pair>(), threads);
+
+        std::vector<std::size_t> del_vertex(del.size()), del_key(del.size());
+        for (std::size_t i = 0; i < del.size(); ++i) {
+          del_vertex[i] = del[i].first;
+          del_key[i] = del[i].second;
+        }
+        std::vector<std::size_t> ins_vertex(ins.size());
+        L ins_edge(ins.size());
+        for (std::size_t i = 0; i < ins.size(); ++i) {
+          ins_vertex[i] = ins[i].first;
+          ins_edge[i] = added[ins[i].second];
+        }
+
+        // Rewrite the out lists.
+        std::vector<vertex_updates> groups = group_updates(del_vertex, ins_vertex);
+        std::vector<Vertex_node*> nodes(groups.size());
+        for (std::size_t i = 0; i < groups.size(); ++i)
+          nodes[i] = &node(groups[i].vertex);
+        std::vector<L> parts(groups.size());
+        auto out_key = [&](Edge e) -> std::size_t { return target(e); };
+        parallel_blocks(groups.size(), [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t i = b; i != e; ++i) {
+            const vertex_updates& u = groups[i];
+            merge_list(nodes[i]->out(),
+                       del_key.data() + u.del_first, u.del_last - u.del_first,
+                       ins_edge.data() + u.ins_first, u.ins_last - u.ins_first,
+                       out_key, parts[i]);
+          }
+        }, threads, grain);
+
+        L removed;
+        for (auto& p : parts)
+          removed.insert(removed.end(), p.begin(), p.end());
+
+        // Rewrite the in lists, where the deletions are the removed edges.
+        del.resize(removed.size());
+        for (std::size_t i = 0; i < removed.size(); ++i)
+          del[i] = {target(removed[i]), removed[i]};
+        parallel_sort(del.begin(), del.end(), std::less<Pair>(), threads);
+        for (std::size_t i = 0; i < ins.size(); ++i)
+          ins[i] = {ins_target[i], i};
+        parallel_sort(ins.begin(), ins.end(), std::less<Pair>(), threads);
+
+        del_vertex.resize(del.size());
+        del_key.resize(del.size());
+        for (std::size_t i = 0; i < del.size(); ++i) {
+          del_vertex[i] = del[i].first;
+          del_key[i] = del[i].second;
+        }
+        for (std::size_t i = 0; i < ins.size(); ++i) {
+          ins_vertex[i] = ins[i].first;
+          ins_edge[i] = added[ins[i].second];
+        }
+
+        groups = group_updates(del_vertex, ins_vertex);
+        nodes.resize(groups.size());
+        for (std::size_t i = 0; i < groups.size(); ++i)
+          nodes[i] = &node(groups[i].vertex);
+        parts.assign(groups.size(), L());
+        auto in_key = [](Edge e) -> std::size_t { return e; };
+        parallel_blocks(groups.size(), [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t i = b; i != e; ++i) {
+            const vertex_updates& u = groups[i];
+            merge_list(nodes[i]->in(),
+                       del_key.data() + u.del_first, u.del_last - u.del_first,
+                       ins_edge.data() + u.ins_first, u.ins_last - u.ins_first,
+                       in_key, parts[i]);
+          }
+        }, threads, grain);
+
+        return removed;
+      }
+
+  } // namespace batch_impl
+
+} // namespace origin
+
+#endif
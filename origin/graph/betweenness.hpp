@@ -0,0 +1,387 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_BETWEENNESS_HPP
+#define ORIGIN_GRAPH_BETWEENNESS_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <origin/graph/graph.hpp>
+#include <origin/graph/parallel.hpp>
+
+namespace origin
+{
+  namespace betweenness_impl
+  {
+    // The distance type of a weight map W over the edges of G.
+    template<typename G, typename W>
+      using Distance_type = typename std::decay<
+        decltype(std::declval<const W&>()(std::declval<Edge<G>>()))
+      >::type;
+
+    // A unit weight for breadth-first search.
+    struct unit_weight
+    {
+      template<typename E>
+        int operator()(E) const { return 1; }
+    };
+
+
+    // ---------------------------------------------------------------------- //
+    //                            Successor Lists
+    //
+    // The successor lists of a graph are stored contiguously: the successors
+    // of v are head[first[v]] through head[first[v + 1] - 1], and the weight
+    // of the arc to each successor is the corresponding element of weight.
+    // Loops cannot lie on a shortest path and are omitted.
+    template<typename D>
+      struct successors
+      {
+        std::size_t order() const { return first.size() - 1; }
+
+        std::vector<std::size_t> first;
+        std::vector<std::size_t> head;
+        std::vector<D> weight;
+      };
+
+    template<typename G, typename W, typename D>
+      inline Requires<Directed_graph<G>(), void>
+      build(const G& g, W w, successors<D>& s)
+      {
+        s.first.assign(g.order() + 1, 0);
+        for (auto v : g.vertices()) {
+          s.first[v] = s.head.size();
+          for (auto e : g.out_edges(v)) {
+            if (g.target(e) != v) {
+              s.head.push_back(g.target(e));
+              s.weight.push_back(w(e));
+            }
+          }
+        }
+        s.first[g.order()] = s.head.size();
+      }
+
+    template<typename G, typename W, typename D>
+      inline Requires<Undirected_graph<G>(), void>
+      build(const G& g, W w, successors<D>& s)
+      {
+        s.first.assign(g.order() + 1, 0);
+        for (auto v : g.vertices()) {
+          s.first[v] = s.head.size();
+          for (auto e : g.edges(v)) {
+            Vertex<G> u = opposite(g, e, v);
+            if (u != v) {
+              s.head.push_back(u);
+              s.weight.push_back(w(e));
+            }
+          }
+        }
+        s.first[g.order()] = s.head.size();
+      }
+
+
+    // ---------------------------------------------------------------------- //
+    //                              Brandes
+    //
+    // The Brandes workspace holds the state of a single-source shortest path
+    // computation and the dependency accumulation that follows it. Each
+    // thread owns one workspace, and adds the dependencies of each of its
+    // sources to its own centrality array.
+    //
+    // The predecessors of each vertex are not stored. Instead, the backward
+    // pass visits the successors w of each vertex v, and w depends on v if
+    // dist[w] == dist[v] + weight. The distance computations are repeated
+    // exactly, so the comparison is exact even for floating point weights.
+    template<typename D>
+      class brandes
+      {
+      public:
+        brandes(const successors<D>& s);
+
+        void bfs(std::size_t s);
+        void dijkstra(std::size_t s);
+        void accumulate(std::size_t s);
+
+        std::vector<double> centrality;
+
+      private:
+        const successors<D>& net;
+        std::vector<D> dist;
+        std::vector<bool> reached;
+        std::vector<double> sigma;
+        std::vector<double> delta;
+        std::vector<std::size_t> order; // Vertices by non-decreasing distance
+      };
+
+    template<typename D>
+      brandes<D>::brandes(const successors<D>& s)
+        : centrality(s.order(), 0.0), net(s),
+          dist(s.order()), reached(s.order(), false),
+          sigma(s.order(), 0.0), delta(s.order(), 0.0)
+      {
+        order.reserve(s.order());
+      }
+
+    // Count the shortest paths from s in an unweighted graph.
+    template<typename D>
+      void
+      brandes<D>::bfs(std::size_t s)
+      {
+        order.assign(1, s);
+        reached[s] = true;
+        dist[s] = D(0);
+        sigma[s] = 1.0;
+        for (std::size_t i = 0; i < order.size(); ++i) {
+          std::size_t v = order[i];
+          for (std::size_t j = net.first[v]; j < net.first[v + 1]; ++j) {
+            std::size_t w = net.head[j];
+            if (!reached[w]) {
+              reached[w] = true;
+              dist[w] = dist[v] + D(1);
+              order.push_back(w);
+            }
+            if (dist[w] == dist[v] + D(1))
+              sigma[w] += sigma[v];
+          }
+        }
+      }
+
+    // Count the shortest paths from s in a graph with positive weights.
+    // Vertices are appended to the order when they are settled, and delta
+    // marks the settled vertices until the backward pass resets it.
+    template<typename D>
+      void
+      brandes<D>::dijkstra(std::size_t s)
+      {
+        using entry = std::pair<D, std::size_t>;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> q;
+        order.clear();
+        reached[s] = true;
+        dist[s] = D(0);
+        sigma[s] = 1.0;
+        q.emplace(D(0), s);
+        while (!q.empty()) {
+          entry x = q.top();
+          q.pop();
+          std::size_t v = x.second;
+          if (x.first > dist[v] || delta[v] != 0.0)
+            continue;
+          delta[v] = -1.0;
+          order.push_back(v);
+          for (std::size_t j = net.first[v]; j < net.first[v + 1]; ++j) {
+            std::size_t w = net.head[j];
+            D d = dist[v] + net.weight[j];
+            if (!reached[w] || d < dist[w]) {
+              reached[w] = true;
+              dist[w] = d;
+              sigma[w] = sigma[v];
+              q.emplace(d, w);
+            } else if (d == dist[w]) {
+              sigma[w] += sigma[v];
+            }
+          }
+        }
+      }
+
+    // Accumulate the dependencies of s on every vertex that it reaches, in
+    // order of decreasing distance, and reset the workspace.
+    template<typename D>
+      void
+      brandes<D>::accumulate(std::size_t s)
+      {
+        for (std::size_t i = order.size(); i-- > 0; ) {
+          std::size_t v = order[i];
+          double dv = 0.0;
+          for (std::size_t j = net.first[v]; j < net.first[v + 1]; ++j) {
+            std::size_t w = net.head[j];
+            if (reached[w] && dist[w] == dist[v] + net.weight[j])
+              dv += sigma[v] / sigma[w] * (1.0 + delta[w]);
+          }
+          delta[v] = dv;
+          if (v != s)
+            centrality[v] += dv;
+        }
+        for (std::size_t v : order) {
+          reached[v] = false;
+          sigma[v] = 0.0;
+          delta[v] = 0.0;
+        }
+      }
+
+    // Compute the betweenness centrality from each of the given sources and
+    // sum it, scaled by factor. Sources are claimed dynamically from a shared
+    // counter, since the cost of each search varies widely.
+    template<typename D>
+      std::vector<double>
+      compute(const successors<D>& net, const std::vector<std::size_t>& sources,
+              bool weighted, double factor, std::size_t threads)
+      {
+        std::size_t n = net.order();
+        std::size_t t = thread_count(sources.size(), threads, 1);
+        std::vector<std::vector<double>> partial(t);
+        std::atomic<std::size_t> next(0);
+        parallel_blocks(t, [&](std::size_t i, std::size_t, std::size_t) {
+          brandes<D> b(net);
+          std::size_t k;
+          while ((k = next.fetch_add(1)) < sources.size()) {
+            std::size_t s = sources[k];
+            if (weighted)
+              b.dijkstra(s);
+            else
+              b.bfs(s);
+            b.accumulate(s);
+          }
+          partial[i] = std::move(b.centrality);
+        }, t, 1);
+
+        // Merge the per-thread centralities.
+        std::vector<double> c(n, 0.0);
+        parallel_for(0, n, [&](std::size_t v) {
+          double x = 0.0;
+          for (const auto& p : partial)
+            x += p[v];
+          c[v] = x * factor;
+        }, threads);
+        return c;
+      }
+
+    // Returns k distinct vertices of an n-vertex graph, chosen uniformly at
+    // random, in increasing order.
+    inline std::vector<std::size_t>
+    sample(std::size_t n, std::size_t k, std::uint64_t seed)
+    {
+      std::mt19937_64 prng(seed);
+      std::vector<std::size_t> v(n);
+      std::iota(v.begin(), v.end(), std::size_t(0));
+      k = std::min(k, n);
+      for (std::size_t i = 0; i < k; ++i) {
+        std::uniform_int_distribution<std::size_t> dist(i, n - 1);
+        std::swap(v[i], v[dist(prng)]);
+      }
+      v.resize(k);
+      std::sort(v.begin(), v.end());
+      return v;
+    }
+
+    // Returns 1/2 for undirected graphs, where each path is found from both
+    // of its ends, and 1 for directed graphs.
+    template<typename G>
+      constexpr double
+      pair_factor() { return Undirected_graph<G>() ? 0.5 : 1.0; }
+
+    template<typename G, typename W, typename D>
+      std::vector<double>
+      run(const G& g, W w, bool weighted, const std::vector<std::size_t>& src,
+          std::size_t threads)
+      {
+        successors<D> net;
+        build(g, w, net);
+        double scale = src.empty() ? 0.0 : double(g.order()) / src.size();
+        return compute(net, src, weighted, pair_factor<G>() * scale, threads);
+      }
+
+    inline std::vector<std::size_t>
+    all(std::size_t n)
+    {
+      std::vector<std::size_t> v(n);
+      std::iota(v.begin(), v.end(), std::size_t(0));
+      return v;
+    }
+
+  } // namespace betweenness_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                                                         [graph.betweenness]
+  //                         Betweenness Centrality
+  //
+  // The betweenness centrality of a vertex v is the sum, over all pairs of
+  // distinct vertices s and t other than v, of the fraction of shortest paths
+  // from s to t that pass through v. In an undirected graph, each unordered
+  // pair is counted once. The values are not normalized.
+  //
+  //    betweenness_centrality(g, threads)
+  //    approximate_betweenness_centrality(g, k, seed, threads)
+  //    weighted_betweenness_centrality(g, weight, threads)
+  //    approximate_weighted_betweenness_centrality(g, weight, k, seed, threads)
+  //
+  // The algorithms use Brandes' algorithm, running one breadth-first search
+  // (or, with weights, one Dijkstra search) per source. Sources are processed
+  // concurrently, each thread accumulating into its own centrality array, and
+  // the arrays are summed at the end. Each thread uses O(n) space.
+  //
+  // The approximate algorithms run from k sources sampled uniformly without
+  // replacement, using the given seed, and scale the result by n / k to
+  // estimate the exact centrality.
+  //
+  // These algorithms require the vertex handles of g to be the integers in
+  // [0, g.order()). Weights must be positive.
+
+
+  // Compute the betweenness centrality of the vertices of g, counting each
+  // edge as a path of length 1.
+  template<typename G>
+    std::vector<double>
+    betweenness_centrality(const G& g, std::size_t threads = 0)
+    {
+      using namespace betweenness_impl;
+      return run<G, unit_weight, int>(g, unit_weight{}, false, all(g.order()),
+                                      threads);
+    }
+
+  // Estimate the betweenness centrality of the vertices of g from k sampled
+  // sources.
+  template<typename G>
+    std::vector<double>
+    approximate_betweenness_centrality(const G& g, std::size_t k,
+                                       std::uint64_t seed = 0,
+                                       std::size_t threads = 0)
+    {
+      using namespace betweenness_impl;
+      return run<G, unit_weight, int>(g, unit_weight{}, false,
+                                      sample(g.order(), k, seed), threads);
+    }
+
+  // Compute the betweenness centrality of the vertices of g, where the
+  // length of each edge e is weight(e).
+  template<typename G, typename W>
+    std::vector<double>
+    weighted_betweenness_centrality(const G& g, W weight,
+                                    std::size_t threads = 0)
+    {
+      using namespace betweenness_impl;
+      using D = Distance_type<G, W>;
+      return run<G, W, D>(g, weight, true, all(g.order()), threads);
+    }
+
+  // Estimate the weighted betweenness centrality of the vertices of g from
+  // k sampled sources.
+  template<typename G, typename W>
+    std::vector<double>
+    approximate_weighted_betweenness_centrality(const G& g, W weight,
+                                                std::size_t k,
+                                                std::uint64_t seed = 0,
+                                                std::size_t threads = 0)
+    {
+      using namespace betweenness_impl;
+      using D = Distance_type<G, W>;
+      return run<G, W, D>(g, weight, true, sample(g.order(), k, seed), threads);
+    }
+
+} // namespace origin
+
+#endif
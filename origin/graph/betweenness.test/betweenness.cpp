@@ -0,0 +1,160 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/betweenness.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using D = directed_adjacency_vector<empty_t, int>;
+using U = undirected_adjacency_vector<empty_t, int>;
+
+// Compute betweenness from its definition, using all-pairs distances and
+// path counts from the Floyd-Warshall algorithm.
+template<typename G, typename W>
+  vector<double>
+  simple_betweenness(const G& g, W weight, bool directed)
+  {
+    size_t n = g.order();
+    const long inf = 1L << 40;
+    vector<vector<long>> d(n, vector<long>(n, inf));
+    vector<vector<double>> c(n, vector<double>(n, 0.0));
+    for (size_t v = 0; v < n; ++v) {
+      d[v][v] = 0;
+      c[v][v] = 1;
+    }
+    for (auto e : g.edges()) {
+      size_t u = g.source(e), v = g.target(e);
+      if (u == v)
+        continue;
+      long w = weight(e);
+      for (int i = 0; i < (directed ? 1 : 2); ++i) {
+        if (w < d[u][v]) {
+          d[u][v] = w;
+          c[u][v] = 1;
+        } else if (w == d[u][v]) {
+          c[u][v] += 1;
+        }
+        swap(u, v);
+      }
+    }
+
+    // Count paths with increasing sets of intermediate vertices. Paths
+    // through the new vertex k are only combined with counts that avoid it.
+    for (size_t k = 0; k < n; ++k)
+      for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) {
+          if (i == k || j == k || i == j)
+            continue;
+          long x = d[i][k] + d[k][j];
+          if (x < d[i][j]) {
+            d[i][j] = x;
+            c[i][j] = c[i][k] * c[k][j];
+          } else if (x == d[i][j] && x < inf) {
+            c[i][j] += c[i][k] * c[k][j];
+          }
+        }
+
+    vector<double> b(n, 0.0);
+    for (size_t s = 0; s < n; ++s)
+      for (size_t t = 0; t < n; ++t)
+        for (size_t v = 0; v < n; ++v) {
+          if (s == t || v == s || v == t || d[s][t] >= inf)
+            continue;
+          if (d[s][v] + d[v][t] == d[s][t])
+            b[v] += c[s][v] * c[v][t] / c[s][t];
+        }
+    if (!directed)
+      for (auto& x : b)
+        x /= 2;
+    return b;
+  }
+
+bool
+close(const vector<double>& a, const vector<double>& b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); ++i)
+    if (abs(a[i] - b[i]) > 1e-6 * (1 + abs(b[i])))
+      return false;
+  return true;
+}
+
+void
+check_path()
+{
+  cout << "*** path ***\n";
+  // On the path 0 - 1 - 2 - 3, vertex 1 lies between {0, 2} and {0, 3}.
+  U g;
+  for (int i = 0; i < 4; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1, 1);
+  g.add_edge(1, 2, 1);
+  g.add_edge(2, 3, 1);
+  auto b = betweenness_centrality(g);
+  assert(close(b, {0, 2, 2, 0}));
+}
+
+template<typename G>
+  void
+  check_random(bool directed)
+  {
+    cout << "*** random " << (directed ? "directed" : "undirected") << " ***\n";
+    auto unit = [](Edge<G>) { return 1; };
+    for (unsigned seed = 1; seed <= 10; ++seed) {
+      G g = random_graph<G>(40, 100, seed, uniform_values(1, 5));
+      auto b = simple_betweenness(g, unit, directed);
+      assert(close(betweenness_centrality(g, 1), b));
+      assert(close(betweenness_centrality(g, 4), b));
+      assert(close(approximate_betweenness_centrality(g, 40, seed, 3), b));
+
+      auto w = simple_betweenness(g, edge_value<G>(g), directed);
+      assert(close(weighted_betweenness_centrality(g, edge_value<G>(g), 1), w));
+      assert(close(weighted_betweenness_centrality(g, edge_value<G>(g), 4), w));
+    }
+  }
+
+void
+check_sampled()
+{
+  cout << "*** sampled ***\n";
+  // Sampling is deterministic for a given seed, and the estimate is
+  // unbiased; on a large graph it is close to the exact value in total.
+  U g = random_graph<U>(400, 1600, 7, uniform_values(1, 2));
+  auto a1 = approximate_betweenness_centrality(g, 100, 3, 4);
+  auto a2 = approximate_betweenness_centrality(g, 100, 3, 1);
+  assert(close(a1, a2));
+
+  auto b = betweenness_centrality(g);
+  double sa = 0, sb = 0;
+  for (size_t i = 0; i < b.size(); ++i) {
+    sa += a1[i];
+    sb += b[i];
+  }
+  assert(abs(sa - sb) < 0.1 * sb);
+
+  auto w = approximate_weighted_betweenness_centrality(g, edge_value<U>(g), 0);
+  for (double x : w)
+    assert(x == 0);
+}
+
+int main()
+{
+  check_path();
+  check_random<D>(true);
+  check_random<U>(false);
+  check_sampled();
+}
@@ -0,0 +1,234 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_BULK_HPP
+#define ORIGIN_GRAPH_BULK_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <origin/graph/concepts.hpp>
+#include <origin/graph/edge_pair.hpp>
+#include <origin/graph/parallel.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                                [graph.bulk]
+  //                              Bulk Loading
+  //
+  // Raw edge lists often repeat edges. Checking g(u, v) before each add_edge
+  // searches an incidence list per insertion; it is far cheaper to clean the
+  // whole list first. Normalizing an edge list:
+  //
+  //    1. canonicalizes each undirected edge to (min, max),
+  //    2. drops self loops, if requested, and
+  //    3. merges duplicate edges, if requested.
+  //
+  // Duplicates are found by a parallel radix sort of the endpoints packed
+  // into one 64 bit key (or a comparison sort when they do not fit), after
+  // which the surviving edges are in increasing (source, target) order. The
+  // values of merged edges are combined by a reducer, in input order.
+  // Without merging, the edges keep their input order.
+  struct bulk_options
+  {
+    bool drop_loops;
+    bool drop_duplicates;
+  };
+
+  namespace bulk_impl
+  {
+    // Returns the greatest endpoint in edges, or 0 if there are none.
+    inline std::size_t
+    max_vertex(const std::vector<edge_pair>& edges, std::size_t t)
+    {
+      std::vector<std::size_t> m(t);
+      parallel_blocks(edges.size(), [&](std::size_t i, std::size_t b, std::size_t e) {
+        for (std::size_t j = b; j != e; ++j)
+          m[i] = std::max({m[i], edges[j].first, edges[j].second});
+      }, t);
+      return m.empty() ? 0 : *std::max_element(m.begin(), m.end());
+    }
+
+    // Canonicalize the edges, if undirected, and return the order in which
+    // they are visited: sorted by endpoints, stably, if duplicates are
+    // dropped, and the input order otherwise.
+    inline std::vector<std::size_t>
+    arrange(std::vector<edge_pair>& edges, bool undirected, bulk_options opt,
+            std::size_t t)
+    {
+      std::size_t n = edges.size();
+      if (undirected)
+        parallel_blocks(n, [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t j = b; j != e; ++j)
+            if (edges[j].second < edges[j].first)
+              std::swap(edges[j].first, edges[j].second);
+        }, t);
+
+      std::vector<std::size_t> idx(n);
+      std::iota(idx.begin(), idx.end(), 0);
+      if (!opt.drop_duplicates)
+        return idx;
+
+      unsigned bits = 0;
+      for (std::size_t m = max_vertex(edges, t); m != 0; m >>= 1)
+        ++bits;
+      if (2 * bits <= 64) {
+        std::vector<std::uint64_t> keys(n);
+        parallel_blocks(n, [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t j = b; j != e; ++j)
+            keys[j] = std::uint64_t(edges[j].first) << bits | edges[j].second;
+        }, t);
+        parallel_radix_sort(keys, idx, 2 * bits, t);
+      } else {
+        parallel_sort(idx.begin(), idx.end(), [&](std::size_t a, std::size_t b) {
+          return edges[a] < edges[b] || (edges[a] == edges[b] && a < b);
+        }, t);
+      }
+      return idx;
+    }
+
+    // Returns true if position j of the arrangement starts an output edge.
+    inline bool
+    is_head(const std::vector<edge_pair>& edges,
+            const std::vector<std::size_t>& idx, bulk_options opt,
+            std::size_t j)
+    {
+      const edge_pair& e = edges[idx[j]];
+      if (opt.drop_loops && e.first == e.second)
+        return false;
+      return !opt.drop_duplicates || j == 0 || edges[idx[j - 1]] != e;
+    }
+
+    // Count the output edges, m, and call f = prepare(m). Then call f(k, b,
+    // e) for each output edge k, where [b, e) are the positions of the
+    // arrangement merged into it. Both passes use the same blocks, so each
+    // block writes its output edges after those of the blocks before it.
+    template<typename F>
+      std::size_t
+      for_each_run(const std::vector<edge_pair>& edges,
+                   const std::vector<std::size_t>& idx, bulk_options opt,
+                   std::size_t t, F prepare)
+      {
+        std::size_t n = idx.size();
+        std::vector<std::size_t> offset(t + 1);
+        parallel_blocks(n, [&](std::size_t i, std::size_t b, std::size_t e) {
+          for (std::size_t j = b; j != e; ++j)
+            offset[i + 1] += is_head(edges, idx, opt, j);
+        }, t);
+        std::partial_sum(offset.begin(), offset.end(), offset.begin());
+
+        auto f = prepare(offset[t]);
+        parallel_blocks(n, [&](std::size_t i, std::size_t b, std::size_t e) {
+          std::size_t k = offset[i];
+          for (std::size_t j = b; j != e; ++j) {
+            if (!is_head(edges, idx, opt, j))
+              continue;
+            std::size_t last = j + 1;
+            if (opt.drop_duplicates)
+              while (last != n && edges[idx[last]] == edges[idx[j]])
+                ++last;
+            f(k++, j, last);
+          }
+        }, t);
+        return offset[t];
+      }
+
+  } // namespace bulk_impl
+
+
+  // Normalize the edge list in place. Edges are canonicalized if undirected.
+  inline void
+  normalize_edges(std::vector<edge_pair>& edges, bool undirected,
+                  bulk_options opt, std::size_t threads = 0)
+  {
+    std::size_t t = thread_count(edges.size(), threads);
+    std::vector<std::size_t> idx = bulk_impl::arrange(edges, undirected, opt, t);
+    std::vector<edge_pair> out;
+    bulk_impl::for_each_run(edges, idx, opt, t, [&](std::size_t m) {
+      out.resize(m);
+      return [&](std::size_t k, std::size_t b, std::size_t) {
+        out[k] = edges[idx[b]];
+      };
+    });
+    edges.swap(out);
+  }
+
+  // Normalize the edge list and its parallel list of values in place. The
+  // values of duplicate edges are combined, in input order, by reduce(x, y).
+  template<typename T, typename R>
+    void
+    normalize_edges(std::vector<edge_pair>& edges, std::vector<T>& values,
+                    bool undirected, bulk_options opt, R reduce,
+                    std::size_t threads = 0)
+    {
+      assert(edges.size() == values.size());
+      std::size_t t = thread_count(edges.size(), threads);
+      std::vector<std::size_t> idx = bulk_impl::arrange(edges, undirected, opt, t);
+      std::vector<edge_pair> out;
+      std::vector<T> vals;
+      bulk_impl::for_each_run(edges, idx, opt, t, [&](std::size_t m) {
+        out.resize(m);
+        vals.resize(m);
+        return [&](std::size_t k, std::size_t b, std::size_t e) {
+          out[k] = edges[idx[b]];
+          T x = values[idx[b]];
+          for (++b; b != e; ++b)
+            x = reduce(x, values[idx[b]]);
+          vals[k] = std::move(x);
+        };
+      });
+      edges.swap(out);
+      values.swap(vals);
+    }
+
+  // Normalize the edges and add them to g, adding vertices until every
+  // endpoint in the original list is a vertex, even one whose only edges are
+  // dropped loops. The vertices of g are assumed to be [0, order()).
+  // Edges are canonicalized if G is undirected. Duplicates are only merged
+  // within the list; an edge already in g is not checked. Returns the
+  // number of edges added.
+  template<typename G>
+    std::size_t
+    bulk_load(G& g, std::vector<edge_pair> edges, bulk_options opt = {},
+              std::size_t threads = 0)
+    {
+      std::size_t t = thread_count(edges.size(), threads);
+      std::size_t n = edges.empty() ? 0 : bulk_impl::max_vertex(edges, t) + 1;
+      normalize_edges(edges, Undirected_graph<G>(), opt, threads);
+      while (std::size_t(g.order()) < n)
+        g.add_vertex();
+      for (const edge_pair& e : edges)
+        g.add_edge(e.first, e.second);
+      return edges.size();
+    }
+
+  // Normalize the edges and values, combining the values of duplicates by
+  // reduce(x, y), and add them to g.
+  template<typename G, typename T, typename R>
+    std::size_t
+    bulk_load(G& g, std::vector<edge_pair> edges, std::vector<T> values,
+              bulk_options opt, R reduce, std::size_t threads = 0)
+    {
+      std::size_t t = thread_count(edges.size(), threads);
+      std::size_t n = edges.empty() ? 0 : bulk_impl::max_vertex(edges, t) + 1;
+      normalize_edges(edges, values, Undirected_graph<G>(), opt, reduce, threads);
+      while (std::size_t(g.order()) < n)
+        g.add_vertex();
+      for (std::size_t i = 0; i < edges.size(); ++i)
+        g.add_edge(edges[i].first, edges[i].second, std::move(values[i]));
+      return edges.size();
+    }
+
+} // namespace origin
+
+#endif
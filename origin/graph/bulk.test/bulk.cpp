@@ -0,0 +1,144 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include <origin/graph/adjacency_list.hpp>
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/bulk.hpp>
+#include <origin/graph/random.hpp>
+
+using namespace std;
+using namespace origin;
+
+void
+check_normalize()
+{
+  cout << "*** normalize ***\n";
+  vector<edge_pair> e {{3, 1}, {1, 3}, {2, 2}, {0, 4}, {3, 1}, {4, 0}};
+
+  // Without options, only undirected edges change.
+  vector<edge_pair> a = e;
+  normalize_edges(a, false, {false, false});
+  assert(a == e);
+  normalize_edges(a, true, {false, false});
+  assert(a == (vector<edge_pair> {{1, 3}, {1, 3}, {2, 2}, {0, 4}, {1, 3}, {0, 4}}));
+
+  // Dropping loops keeps the input order.
+  a = e;
+  normalize_edges(a, false, {true, false});
+  assert(a == (vector<edge_pair> {{3, 1}, {1, 3}, {0, 4}, {3, 1}, {4, 0}}));
+
+  // Merged edges are sorted.
+  a = e;
+  normalize_edges(a, false, {false, true});
+  assert(a == (vector<edge_pair> {{0, 4}, {1, 3}, {2, 2}, {3, 1}, {4, 0}}));
+  a = e;
+  normalize_edges(a, true, {true, true});
+  assert(a == (vector<edge_pair> {{0, 4}, {1, 3}}));
+
+  // Values of duplicates are reduced in input order.
+  a = e;
+  vector<string> v {"a", "b", "c", "d", "e", "f"};
+  auto cat = [](const string& x, const string& y) { return x + y; };
+  normalize_edges(a, v, true, {true, true}, cat);
+  assert(a == (vector<edge_pair> {{0, 4}, {1, 3}}));
+  assert(v == (vector<string> {"df", "abe"}));
+
+  // Endpoints too wide to pack into one key.
+  size_t big = size_t(1) << 40;
+  a = {{big, 1}, {2, big}, {1, big}, {big, 2}};
+  normalize_edges(a, true, {true, true});
+  assert(a == (vector<edge_pair> {{1, big}, {2, big}}));
+
+  vector<edge_pair> none;
+  normalize_edges(none, true, {true, true});
+  assert(none.empty());
+}
+
+void
+check_parallel()
+{
+  cout << "*** parallel ***\n";
+  // About a third of the edges are duplicates. The result does not depend on
+  // the number of threads.
+  counter_rng rng(7, 0);
+  vector<edge_pair> e;
+  vector<size_t> w;
+  for (size_t i = 0; i < 200000; ++i) {
+    e.emplace_back(rng.below(1000), rng.below(200));
+    w.push_back(1);
+  }
+  map<edge_pair, size_t> expect;
+  for (edge_pair p : e) {
+    if (p.first > p.second)
+      swap(p.first, p.second);
+    if (p.first != p.second)
+      ++expect[p];
+  }
+
+  auto plus = [](size_t x, size_t y) { return x + y; };
+  for (size_t t : {1, 2, 5}) {
+    vector<edge_pair> a = e;
+    vector<size_t> v = w;
+    normalize_edges(a, v, true, {true, true}, plus, t);
+    assert(a.size() == expect.size());
+    size_t i = 0;
+    for (auto& x : expect) {
+      assert(a[i] == x.first && v[i] == x.second);
+      ++i;
+    }
+  }
+}
+
+void
+check_load()
+{
+  cout << "*** load ***\n";
+  vector<edge_pair> e {{0, 1}, {1, 0}, {0, 1}, {2, 2}, {1, 5}};
+
+  // A directed graph keeps both directions, and gains the missing vertices.
+  using D = directed_adjacency_list<>;
+  D d;
+  assert(bulk_load(d, e, {true, true}) == 3);
+  assert(d.order() == 6 && d.size() == 3);
+  assert(d(0, 1) && d(1, 0) && d(1, 5) && !d(2, 2));
+
+  // An undirected graph merges them, and summing the values counts the
+  // copies of each edge.
+  using U = undirected_adjacency_vector<empty_t, int>;
+  U u;
+  u.add_vertex();
+  assert(bulk_load(u, e, vector<int>(e.size(), 1), {false, true},
+                   [](int x, int y) { return x + y; }, 2) == 3);
+  assert(u.order() == 6 && u.size() == 3);
+  assert(u(u(1, 0)) == 3 && u(u(2, 2)) == 1 && u(u(5, 1)) == 1);
+
+  // Without options, every edge is added.
+  U all;
+  assert(bulk_load(all, e) == 5 && all.size() == 5);
+
+  // A vertex whose only edge is a dropped loop is still added.
+  D loop;
+  assert(bulk_load(loop, {{1, 0}, {0, 1}, {2, 2}, {1, 0}}, {true, true}) == 2);
+  assert(loop.order() == 3 && loop.size() == 2);
+  U uloop;
+  assert(bulk_load(uloop, {{1, 0}, {0, 1}, {2, 2}, {1, 0}},
+                   vector<int>(4, 1), {true, true},
+                   [](int x, int y) { return x + y; }) == 1);
+  assert(uloop.order() == 3 && uloop(uloop(0, 1)) == 3);
+}
+
+int main()
+{
+  check_normalize();
+  check_parallel();
+  check_load();
+}
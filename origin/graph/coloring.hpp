@@ -0,0 +1,225 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_COLORING_HPP
+#define ORIGIN_GRAPH_COLORING_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+#include <origin/graph/core.hpp>
+#include <origin/graph/graph.hpp>
+#include <origin/graph/parallel.hpp>
+#include <origin/graph/random.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                            [graph.coloring]
+  //                            Vertex Coloring
+  //
+  // A coloring of an undirected graph assigns each vertex a color, numbered
+  // from 0, so that adjacent vertices have different colors. The vertices of
+  // each color (the color classes) are independent sets: no two of them are
+  // adjacent, so work on the vertices of one class can proceed in parallel
+  // without conflicts.
+  //
+  //    greedy_coloring(g)
+  //    greedy_coloring(g, order)
+  //    smallest_last_coloring(g)
+  //    parallel_coloring(g, threads)
+  //
+  // Every algorithm returns the color of each vertex, indexed by vertex
+  // handle, and the number of colors used. The color array is sized by
+  // vertex_bound(g), and the entries for handles that do not denote vertices
+  // of g are no_color. Loops are ignored: a vertex is never its own neighbor.
+  constexpr std::size_t no_color = -1;
+
+  struct vertex_coloring
+  {
+    std::vector<std::size_t> color;
+    std::size_t colors;
+  };
+
+
+  namespace coloring_impl
+  {
+    // The smallest color not used by a neighbor of v. The mark array holds,
+    // for each color, the stamp of the last vertex that saw it; the stamp of
+    // v must differ from all earlier stamps.
+    template<typename G>
+      std::size_t
+      first_free(const G& g, Vertex<G> v, const std::vector<std::size_t>& color,
+                 std::vector<std::size_t>& mark, std::size_t stamp)
+      {
+        for (auto e : g.edges(v)) {
+          Vertex<G> u = opposite(g, e, v);
+          std::size_t c = color[u];
+          if (u == v || c == no_color)
+            continue;
+          if (c >= mark.size())
+            mark.resize(2 * c + 2, std::size_t(-1));
+          mark[c] = stamp;
+        }
+        std::size_t c = 0;
+        while (c < mark.size() && mark[c] == stamp)
+          ++c;
+        return c;
+      }
+
+  } // namespace coloring_impl
+
+
+  // Color the vertices of g greedily in the given order: each vertex gets
+  // the smallest color not used by its neighbors that are already colored.
+  // The number of colors is at most one more than the greatest degree. The
+  // order must contain every vertex of g exactly once.
+  template<typename G>
+    vertex_coloring
+    greedy_coloring(const G& g, const std::vector<Vertex<G>>& order)
+    {
+      vertex_coloring r {
+        std::vector<std::size_t>(vertex_bound(g), no_color), 0
+      };
+      std::vector<std::size_t> mark;
+      for (std::size_t i = 0; i < order.size(); ++i) {
+        Vertex<G> v = order[i];
+        std::size_t c = coloring_impl::first_free(g, v, r.color, mark, i);
+        r.color[v] = c;
+        r.colors = std::max(r.colors, c + 1);
+      }
+      return r;
+    }
+
+  // Color the vertices of g greedily in the order of g.vertices().
+  template<typename G>
+    vertex_coloring
+    greedy_coloring(const G& g)
+    {
+      std::vector<Vertex<G>> order;
+      order.reserve(g.order());
+      for (auto v : g.vertices())
+        order.push_back(v);
+      return greedy_coloring(g, order);
+    }
+
+  // Color the vertices of g greedily in smallest-last order: the reverse of
+  // a degeneracy ordering, in which each vertex has at most degeneracy
+  // neighbors that precede it. The coloring uses at most degeneracy + 1
+  // colors, which is far fewer than the greatest degree in sparse graphs
+  // with a few hubs. Loops count toward degeneracy, so graphs with loops
+  // may not meet the bound.
+  template<typename G>
+    vertex_coloring
+    smallest_last_coloring(const G& g)
+    {
+      std::vector<Vertex<G>> order = core_decomposition(g).order;
+      std::reverse(order.begin(), order.end());
+      return greedy_coloring(g, order);
+    }
+
+
+  // Color the vertices of g using the parallel algorithm of Jones and
+  // Plassmann. Each vertex is given a pseudo-random priority, a hash of its
+  // handle. In each round, every uncolored vertex whose priority exceeds
+  // that of all its uncolored neighbors is selected; the selected vertices
+  // form an independent set, so they are colored concurrently, each with the
+  // smallest color not used by its neighbors. The expected number of rounds
+  // is O(log n / log log n) for graphs of bounded degree.
+  //
+  // The priorities, and hence the coloring, do not depend on the number of
+  // threads. The number of colors is at most one more than the greatest
+  // degree, and is typically close to that of greedy_coloring.
+  template<typename G>
+    vertex_coloring
+    parallel_coloring(const G& g, std::size_t threads = 0)
+    {
+      std::size_t n = vertex_bound(g);
+      vertex_coloring r {std::vector<std::size_t>(n, no_color), 0};
+      std::vector<std::uint64_t> prio(n);
+      std::vector<Vertex<G>> rest;
+      rest.reserve(g.order());
+      for (auto v : g.vertices()) {
+        prio[v] = counter_rng::mix(std::size_t(v));
+        rest.push_back(v);
+      }
+
+      // Compare priorities, breaking ties by handle.
+      auto before = [&](Vertex<G> u, Vertex<G> v) {
+        return prio[u] < prio[v] || (prio[u] == prio[v] && u < v);
+      };
+
+      std::size_t t = thread_count(n, threads);
+      std::vector<std::vector<std::size_t>> mark(t);
+      std::vector<std::size_t> most(t, 0);
+      while (!rest.empty()) {
+        // Select the local maxima among the uncolored vertices.
+        std::vector<Vertex<G>> sel = parallel_filter(rest, [&](Vertex<G> v) {
+          for (auto e : g.edges(v)) {
+            Vertex<G> u = opposite(g, e, v);
+            if (u != v && r.color[u] == no_color && before(v, u))
+              return false;
+          }
+          return true;
+        }, t);
+
+        // Color them. No two selected vertices are adjacent, so each one
+        // reads only the colors of vertices that are not being written.
+        parallel_blocks(sel.size(), [&](std::size_t i, std::size_t b, std::size_t e) {
+          for (std::size_t j = b; j != e; ++j) {
+            Vertex<G> v = sel[j];
+            std::size_t c = coloring_impl::first_free(g, v, r.color, mark[i], v);
+            r.color[v] = c;
+            most[i] = std::max(most[i], c + 1);
+          }
+        }, t, 64);
+
+        rest = parallel_filter(rest, [&](Vertex<G> v) {
+          return r.color[v] == no_color;
+        }, t);
+      }
+      r.colors = *std::max_element(most.begin(), most.end());
+      return r;
+    }
+
+
+  // Returns true if c is a proper coloring of g: every vertex has a color
+  // less than c.colors, and no edge joins two vertices of the same color.
+  template<typename G>
+    bool
+    is_proper_coloring(const G& g, const vertex_coloring& c)
+    {
+      for (auto v : g.vertices()) {
+        if (c.color[v] >= c.colors)
+          return false;
+        for (auto e : g.edges(v)) {
+          Vertex<G> u = opposite(g, e, v);
+          if (u != v && c.color[u] == c.color[v])
+            return false;
+        }
+      }
+      return true;
+    }
+
+  // Returns the color classes of c: the vertices of each color, in the
+  // order of g.vertices().
+  template<typename G>
+    std::vector<std::vector<Vertex<G>>>
+    color_classes(const G& g, const vertex_coloring& c)
+    {
+      std::vector<std::vector<Vertex<G>>> r(c.colors);
+      for (auto v : g.vertices())
+        r[c.color[v]].push_back(v);
+      return r;
+    }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,176 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_list.hpp>
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/coloring.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using L = undirected_adjacency_list<>;
+using V = undirected_adjacency_vector<>;
+
+// Returns the greatest degree in g, not counting loops.
+template<typename G>
+  size_t
+  max_degree(const G& g)
+  {
+    size_t d = 0;
+    for (auto v : g.vertices()) {
+      size_t k = 0;
+      for (auto e : g.edges(v))
+        if (opposite(g, e, v) != v)
+          ++k;
+      d = max(d, k);
+    }
+    return d;
+  }
+
+// Check that c is a proper coloring that uses every color and does not
+// exceed the degree bound.
+template<typename G>
+  void
+  check_coloring(const G& g, const vertex_coloring& c)
+  {
+    assert(is_proper_coloring(g, c));
+    assert(c.colors <= max_degree(g) + 1);
+    auto cls = color_classes(g, c);
+    size_t n = 0;
+    for (auto& x : cls) {
+      assert(!x.empty());
+      n += x.size();
+    }
+    assert(n == g.order());
+  }
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // A 4-clique with a pendant path, and an isolated vertex.
+  V g;
+  for (int i = 0; i < 7; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1);
+  g.add_edge(0, 2);
+  g.add_edge(0, 3);
+  g.add_edge(1, 2);
+  g.add_edge(1, 3);
+  g.add_edge(2, 3);
+  g.add_edge(3, 4);
+  g.add_edge(4, 5);
+
+  auto c1 = greedy_coloring(g);
+  auto c2 = smallest_last_coloring(g);
+  auto c3 = parallel_coloring(g, 4);
+  assert(c1.colors == 4 && c2.colors == 4 && c3.colors == 4);
+  check_coloring(g, c1);
+  check_coloring(g, c2);
+  check_coloring(g, c3);
+  assert(c1.color[6] == 0);
+
+  V e;
+  assert(greedy_coloring(e).colors == 0);
+  assert(parallel_coloring(e).colors == 0);
+}
+
+void
+check_crown()
+{
+  cout << "*** crown ***\n";
+  // The crown graph on 2n vertices is bipartite, but greedy coloring in the
+  // order u0, v0, u1, v1, ... uses n colors. Coloring one side first uses 2.
+  V g;
+  size_t n = 10;
+  for (size_t i = 0; i < 2 * n; ++i)
+    g.add_vertex();
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j)
+      if (i != j)
+        g.add_edge(2 * i, 2 * j + 1);
+  assert(greedy_coloring(g).colors == n);
+
+  vector<Vertex<V>> order;
+  for (size_t i = 0; i < 2 * n; i += 2)
+    order.push_back(i);
+  for (size_t i = 1; i < 2 * n; i += 2)
+    order.push_back(i);
+  auto c = greedy_coloring(g, order);
+  assert(c.colors == 2);
+  check_coloring(g, c);
+  check_coloring(g, smallest_last_coloring(g));
+}
+
+void
+check_vector()
+{
+  cout << "*** vector ***\n";
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    V g = random_graph<V>(500, 500 * (seed % 7 + 1), seed);
+    auto c1 = greedy_coloring(g);
+    auto c2 = smallest_last_coloring(g);
+    auto c3 = parallel_coloring(g, 4);
+    check_coloring(g, c1);
+    check_coloring(g, c2);
+    check_coloring(g, c3);
+    assert(c3.color == parallel_coloring(g, 1).color);
+
+    // Smallest-last coloring is bounded by the degeneracy, less loops.
+    V h;
+    for (size_t i = 0; i < g.order(); ++i)
+      h.add_vertex();
+    for (auto e : g.edges())
+      if (g.source(e) != g.target(e))
+        h.add_edge(g.source(e), g.target(e));
+    assert(smallest_last_coloring(h).colors <= core_decomposition(h).degeneracy + 1);
+  }
+}
+
+void
+check_list()
+{
+  cout << "*** list ***\n";
+  // Removing vertices leaves holes in the handle space.
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    L g = random_graph<L>(300, 1500, seed);
+    for (size_t v = 0; v < 300; v += 7)
+      g.remove_vertex(v);
+    auto c1 = greedy_coloring(g);
+    auto c2 = parallel_coloring(g, 4);
+    check_coloring(g, c1);
+    check_coloring(g, c2);
+    assert(c1.color[0] == no_color);
+    assert(c2.color[7] == no_color);
+  }
+}
+
+void
+check_large()
+{
+  cout << "*** large ***\n";
+  V g = random_graph<V>(50000, 500000, 1);
+  auto c1 = parallel_coloring(g);
+  auto c2 = parallel_coloring(g, 1);
+  assert(c1.color == c2.color);
+  check_coloring(g, c1);
+}
+
+int main()
+{
+  check_small();
+  check_crown();
+  check_vector();
+  check_list();
+  check_large();
+}
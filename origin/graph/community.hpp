@@ -0,0 +1,512 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_COMMUNITY_HPP
+#define ORIGIN_GRAPH_COMMUNITY_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+#include <origin/graph/graph.hpp>
+#include <origin/graph/parallel.hpp>
+#include <origin/graph/random.hpp>
+
+namespace origin
+{
+  namespace community_impl
+  {
+    constexpr std::size_t npos = -1;
+
+    // ---------------------------------------------------------------------- //
+    //                             Weight Map
+    //
+    // The weight map accumulates weights by community in an open addressing
+    // hash table. Each thread owns one map, which is sized for the degree of
+    // the vertex being examined, so its size does not grow with the graph.
+    class weight_map
+    {
+    public:
+      // Clear the map, and make room for n keys.
+      void reset(std::size_t n);
+
+      // Returns the weight of key k, inserting it with weight 0 if needed.
+      double& operator[](std::size_t k);
+
+      // The slots that hold keys, in order of insertion.
+      const std::vector<std::size_t>& slots() const { return used_; }
+
+      std::size_t key(std::size_t s) const { return keys_[s]; }
+      double value(std::size_t s) const    { return vals_[s]; }
+
+    private:
+      std::vector<std::size_t> keys_;
+      std::vector<double> vals_;
+      std::vector<std::size_t> used_;
+      std::size_t mask_ = 0;
+    };
+
+    inline void
+    weight_map::reset(std::size_t n)
+    {
+      std::size_t c = 16;
+      while (c < 2 * n)
+        c *= 2;
+      if (c > keys_.size()) {
+        keys_.assign(c, npos);
+        vals_.resize(c);
+        mask_ = c - 1;
+      } else {
+        for (std::size_t s : used_)
+          keys_[s] = npos;
+      }
+      used_.clear();
+    }
+
+    inline double&
+    weight_map::operator[](std::size_t k)
+    {
+      std::size_t s = counter_rng::mix(k) & mask_;
+      while (keys_[s] != k) {
+        if (keys_[s] == npos) {
+          keys_[s] = k;
+          vals_[s] = 0;
+          used_.push_back(s);
+          break;
+        }
+        s = (s + 1) & mask_;
+      }
+      return vals_[s];
+    }
+
+
+    // ---------------------------------------------------------------------- //
+    //                            Level Graph
+    //
+    // A level graph is a weighted undirected graph in compressed sparse row
+    // form. Each edge {u, v} of weight w is stored as the arcs (u, v) and
+    // (v, u), each of weight w, and loops are stored separately as the total
+    // loop weight of each vertex. The strength of a vertex is the sum of the
+    // weights of its arcs plus twice its loop weight, and total is the sum
+    // of all strengths, or twice the total edge weight.
+    struct level_graph
+    {
+      std::size_t order() const { return offset.size() - 1; }
+
+      std::vector<std::size_t> offset;
+      std::vector<std::size_t> target;
+      std::vector<double> weight;
+      std::vector<double> loop;
+      std::vector<double> strength;
+      double total;
+    };
+
+    // Compute the strength of each vertex, and the total.
+    inline void
+    measure(level_graph& l, std::size_t threads)
+    {
+      std::size_t n = l.order();
+      l.strength.assign(n, 0);
+      parallel_for(0, n, [&](std::size_t v) {
+        double s = 2 * l.loop[v];
+        for (std::size_t a = l.offset[v]; a != l.offset[v + 1]; ++a)
+          s += l.weight[a];
+        l.strength[v] = s;
+      }, threads);
+      l.total = 0;
+      for (double s : l.strength)
+        l.total += s;
+    }
+
+    // Build the level graph of g, where the weight of e is weight(e). The
+    // arcs of each vertex are in the order of g.edges().
+    template<typename G, typename W>
+      level_graph
+      make_level(const G& g, W weight, std::size_t threads)
+      {
+        std::size_t n = g.order();
+        level_graph l;
+        l.offset.assign(n + 1, 0);
+        l.loop.assign(n, 0);
+        for (auto e : g.edges()) {
+          std::size_t s = g.source(e), t = g.target(e);
+          if (s != t) {
+            ++l.offset[s + 1];
+            ++l.offset[t + 1];
+          }
+        }
+        for (std::size_t v = 0; v < n; ++v)
+          l.offset[v + 1] += l.offset[v];
+        l.target.resize(l.offset[n]);
+        l.weight.resize(l.offset[n]);
+        std::vector<std::size_t> pos(l.offset.begin(), l.offset.end() - 1);
+        for (auto e : g.edges()) {
+          std::size_t s = g.source(e), t = g.target(e);
+          double w = weight(e);
+          if (s == t) {
+            l.loop[s] += w;
+            continue;
+          }
+          l.target[pos[s]] = t;
+          l.weight[pos[s]++] = w;
+          l.target[pos[t]] = s;
+          l.weight[pos[t]++] = w;
+        }
+        measure(l, threads);
+        return l;
+      }
+
+    // Returns the modularity of the partition of l into the communities
+    // given by comm. The sum is taken in vertex order, so the result does not
+    // depend on the number of threads.
+    inline double
+    modularity(const level_graph& l, const std::vector<std::size_t>& comm,
+               std::size_t threads)
+    {
+      std::size_t n = l.order();
+      if (l.total == 0)
+        return 0;
+      std::vector<double> inside(n);
+      std::vector<double> tot(n, 0);
+      parallel_for(0, n, [&](std::size_t v) {
+        double s = 2 * l.loop[v];
+        for (std::size_t a = l.offset[v]; a != l.offset[v + 1]; ++a)
+          if (comm[l.target[a]] == comm[v])
+            s += l.weight[a];
+        inside[v] = s;
+      }, threads);
+      double in = 0;
+      for (std::size_t v = 0; v < n; ++v) {
+        in += inside[v];
+        tot[comm[v]] += l.strength[v];
+      }
+      double sq = 0;
+      for (double t : tot)
+        sq += t * t;
+      return in / l.total - sq / (l.total * l.total);
+    }
+
+    // Partition the vertices of l into color classes: sets of vertices no
+    // two of which are adjacent. The classes are built greedily in vertex
+    // order.
+    inline std::vector<std::vector<std::size_t>>
+    color_classes(const level_graph& l)
+    {
+      std::size_t n = l.order();
+      std::vector<std::size_t> color(n, npos);
+      std::vector<std::size_t> mark;
+      std::vector<std::vector<std::size_t>> classes;
+      for (std::size_t v = 0; v < n; ++v) {
+        for (std::size_t a = l.offset[v]; a != l.offset[v + 1]; ++a) {
+          std::size_t c = color[l.target[a]];
+          if (c == npos)
+            continue;
+          if (c >= mark.size())
+            mark.resize(2 * c + 2, npos);
+          mark[c] = v;
+        }
+        std::size_t c = 0;
+        while (c < mark.size() && mark[c] == v)
+          ++c;
+        color[v] = c;
+        if (c == classes.size())
+          classes.emplace_back();
+        classes[c].push_back(v);
+      }
+      return classes;
+    }
+
+
+    // ---------------------------------------------------------------------- //
+    //                           Local Moving
+    //
+    // Move the vertices of l between communities while modularity improves
+    // by more than tol in a sweep. The vertices of one color class are not
+    // adjacent, so each class is processed concurrently: every vertex of the
+    // class chooses the neighboring community of greatest gain, using the
+    // community weights from before the class was processed, and the moves
+    // are then applied in order. Returns the number of vertices moved.
+    //
+    // Moving v out of its community a and into b changes modularity by
+    //
+    //    2 / M * ((w(v, b) - k(v) * T(b) / M) - (w(v, a) - k(v) * T'(a) / M))
+    //
+    // where w(v, c) is the weight of the arcs from v into c, k(v) is the
+    // strength of v, T(c) is the total strength of c, T'(a) = T(a) - k(v),
+    // and M is the total strength of the graph.
+    inline std::size_t
+    move_vertices(const level_graph& l, std::vector<std::size_t>& comm,
+                  double tol, std::size_t threads)
+    {
+      std::size_t n = l.order();
+      if (l.total == 0)
+        return 0;
+      std::vector<double> tot(l.strength);
+      auto classes = color_classes(l);
+      std::size_t t = thread_count(n, threads, 256);
+      std::vector<weight_map> maps(t);
+      std::vector<std::size_t> next;
+
+      std::size_t moved = 0;
+      double q = modularity(l, comm, threads);
+      for (std::size_t sweep = 0; sweep < 64; ++sweep) {
+        std::size_t changed = 0;
+        for (const auto& cls : classes) {
+          next.resize(cls.size());
+          parallel_blocks(cls.size(), [&](std::size_t i, std::size_t b, std::size_t e) {
+            weight_map& map = maps[i];
+            for (std::size_t j = b; j != e; ++j) {
+              std::size_t v = cls[j];
+              std::size_t a = comm[v];
+              double k = l.strength[v];
+              map.reset(l.offset[v + 1] - l.offset[v] + 1);
+              map[a];
+              for (std::size_t x = l.offset[v]; x != l.offset[v + 1]; ++x)
+                map[comm[l.target[x]]] += l.weight[x];
+
+              std::size_t best = a;
+              double most = map[a] - k * (tot[a] - k) / l.total;
+              for (std::size_t s : map.slots()) {
+                std::size_t c = map.key(s);
+                double gain = map.value(s) - k * tot[c] / l.total;
+                if (c != a && gain > most) {
+                  best = c;
+                  most = gain;
+                }
+              }
+              next[j] = best;
+            }
+          }, t, 256);
+
+          for (std::size_t j = 0; j < cls.size(); ++j) {
+            std::size_t v = cls[j];
+            if (next[j] != comm[v]) {
+              tot[comm[v]] -= l.strength[v];
+              tot[next[j]] += l.strength[v];
+              comm[v] = next[j];
+              ++changed;
+            }
+          }
+        }
+        moved += changed;
+        double r = modularity(l, comm, threads);
+        if (changed == 0 || r - q <= tol)
+          break;
+        q = r;
+      }
+      return moved;
+    }
+
+    // Renumber the communities in comm as 0, 1, ..., in order of their least
+    // vertex. Returns the number of communities.
+    inline std::size_t
+    renumber(std::vector<std::size_t>& comm)
+    {
+      std::vector<std::size_t> id(comm.size(), npos);
+      std::size_t k = 0;
+      for (std::size_t& c : comm) {
+        if (id[c] == npos)
+          id[c] = k++;
+        c = id[c];
+      }
+      return k;
+    }
+
+    // Returns the graph whose vertices are the k communities of l. The
+    // weight of the edge between two communities is the total weight of
+    // the edges between them, and the loop weight of a community is the
+    // total weight of its loops and internal edges.
+    inline level_graph
+    aggregate(const level_graph& l, const std::vector<std::size_t>& comm,
+              std::size_t k, std::size_t threads)
+    {
+      std::size_t n = l.order();
+
+      // Group the vertices by community.
+      std::vector<std::size_t> first(k + 1, 0);
+      for (std::size_t c : comm)
+        ++first[c + 1];
+      for (std::size_t c = 0; c < k; ++c)
+        first[c + 1] += first[c];
+      std::vector<std::size_t> members(n);
+      std::vector<std::size_t> pos(first.begin(), first.end() - 1);
+      for (std::size_t v = 0; v < n; ++v)
+        members[pos[comm[v]]++] = v;
+
+      // Accumulate the arcs of each community into per-thread buffers.
+      level_graph r;
+      r.offset.assign(k + 1, 0);
+      r.loop.assign(k, 0);
+      std::size_t t = thread_count(k, threads, 256);
+      std::vector<std::vector<std::size_t>> targets(t);
+      std::vector<std::vector<double>> weights(t);
+      std::vector<std::size_t> start(k);
+      std::vector<weight_map> maps(t);
+      parallel_blocks(k, [&](std::size_t i, std::size_t b, std::size_t e) {
+        weight_map& map = maps[i];
+        for (std::size_t c = b; c != e; ++c) {
+          std::size_t deg = 0;
+          for (std::size_t j = first[c]; j != first[c + 1]; ++j) {
+            std::size_t v = members[j];
+            deg += l.offset[v + 1] - l.offset[v];
+          }
+          map.reset(deg);
+          double loop = 0;
+          for (std::size_t j = first[c]; j != first[c + 1]; ++j) {
+            std::size_t v = members[j];
+            loop += l.loop[v];
+            for (std::size_t a = l.offset[v]; a != l.offset[v + 1]; ++a) {
+              std::size_t d = comm[l.target[a]];
+              if (d == c)
+                loop += l.weight[a] / 2;
+              else
+                map[d] += l.weight[a];
+            }
+          }
+          r.loop[c] = loop;
+          start[c] = targets[i].size();
+          r.offset[c + 1] = map.slots().size();
+          for (std::size_t s : map.slots()) {
+            targets[i].push_back(map.key(s));
+            weights[i].push_back(map.value(s));
+          }
+        }
+      }, t, 256);
+
+      for (std::size_t c = 0; c < k; ++c)
+        r.offset[c + 1] += r.offset[c];
+      r.target.resize(r.offset[k]);
+      r.weight.resize(r.offset[k]);
+      parallel_blocks(k, [&](std::size_t i, std::size_t b, std::size_t e) {
+        for (std::size_t c = b; c != e; ++c) {
+          std::size_t m = r.offset[c + 1] - r.offset[c];
+          std::copy_n(targets[i].begin() + start[c], m, r.target.begin() + r.offset[c]);
+          std::copy_n(weights[i].begin() + start[c], m, r.weight.begin() + r.offset[c]);
+        }
+      }, t, 256);
+      measure(r, threads);
+      return r;
+    }
+
+  } // namespace community_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                                                           [graph.community]
+  //                         Community Detection
+  //
+  // A community structure partitions the vertices of an undirected graph
+  // into groups that are densely connected inside and sparsely connected to
+  // each other. Its quality is measured by modularity:
+  //
+  //    Q = sum over communities c of (in(c) / M - (tot(c) / M)^2)
+  //
+  // where in(c) is twice the weight of the edges inside c, tot(c) is the sum
+  // of the weighted degrees of the vertices of c, and M is twice the total
+  // edge weight. A loop counts twice toward the weighted degree of its
+  // vertex. The weight of an edge e is weight(e); when no weight function is
+  // given, the weight is the edge's value, g(e). Weights must be
+  // non-negative.
+  //
+  //    louvain(g)
+  //    louvain(g, weight, threads)
+  //    modularity(g, community)
+  //    modularity(g, community, weight)
+  //
+  // These algorithms require the vertex handles of g to be the integers in
+  // [0, g.order()), as in the adjacency vector classes.
+  struct community_structure
+  {
+    std::vector<std::size_t> community; // The community of each vertex
+    std::size_t communities;            // The number of communities
+    double modularity;
+    std::size_t levels;                 // The number of aggregation levels
+  };
+
+
+  // Compute a community structure of g using the Louvain method of Blondel
+  // et al. Starting from singleton communities, vertices are moved to the
+  // neighboring community that most increases modularity until no sweep
+  // improves it by more than tol. The communities are then contracted into
+  // the vertices of a weighted graph, and the process repeats on that graph
+  // until no vertex moves.
+  //
+  // Local moving runs in parallel over the color classes of each level, and
+  // aggregation runs in parallel over communities, with a hash table of
+  // community weights per thread. Moves within a color class are computed
+  // from the same state and applied in order, so the result does not depend
+  // on the number of threads. Communities are numbered in order of their
+  // least vertex.
+  template<typename G, typename W>
+    community_structure
+    louvain(const G& g, W weight, std::size_t threads = 0, double tol = 1e-7)
+    {
+      using namespace community_impl;
+      std::size_t n = g.order();
+      level_graph l = make_level(g, weight, threads);
+
+      community_structure r {std::vector<std::size_t>(n), n, 0, 0};
+      for (std::size_t v = 0; v < n; ++v)
+        r.community[v] = v;
+
+      std::vector<std::size_t> comm(n);
+      while (true) {
+        for (std::size_t v = 0; v < l.order(); ++v)
+          comm[v] = v;
+        if (move_vertices(l, comm, tol, threads) == 0)
+          break;
+        std::size_t k = renumber(comm);
+        for (std::size_t& c : r.community)
+          c = comm[c];
+        r.communities = k;
+        if (k == l.order())
+          break;
+        l = aggregate(l, comm, k, threads);
+        comm.resize(k);
+        ++r.levels;
+      }
+
+      // The vertices of the last level are the communities.
+      comm.resize(l.order());
+      for (std::size_t v = 0; v < l.order(); ++v)
+        comm[v] = v;
+      r.modularity = modularity(l, comm, threads);
+      return r;
+    }
+
+  template<typename G>
+    inline community_structure
+    louvain(const G& g)
+    {
+      return louvain(g, edge_value<G>(g));
+    }
+
+
+  // Returns the modularity of the partition of g whose community labels
+  // are given by community, indexed by vertex handle. Labels must be less
+  // than g.order().
+  template<typename G, typename W>
+    double
+    modularity(const G& g, const std::vector<std::size_t>& community, W weight)
+    {
+      using namespace community_impl;
+      level_graph l = make_level(g, weight, 1);
+      return community_impl::modularity(l, community, 1);
+    }
+
+  template<typename G>
+    inline double
+    modularity(const G& g, const std::vector<std::size_t>& community)
+    {
+      return modularity(g, community, edge_value<G>(g));
+    }
+
+} // namespace origin
+
+#endif
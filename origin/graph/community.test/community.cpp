@@ -0,0 +1,183 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/community.hpp>
+
+using namespace std;
+using namespace origin;
+
+using V = undirected_adjacency_vector<empty_t, double>;
+
+bool
+close(double a, double b) { return abs(a - b) < 1e-9; }
+
+// Add a clique on the vertices [b, b + k) to g, with edges of weight w.
+void
+add_clique(V& g, size_t b, size_t k, double w = 1)
+{
+  for (size_t i = b; i < b + k; ++i)
+    for (size_t j = i + 1; j < b + k; ++j)
+      g.add_edge(i, j, w);
+}
+
+// Returns a ring of c cliques of k vertices, adjacent cliques joined by a
+// single edge.
+V
+ring_of_cliques(size_t c, size_t k)
+{
+  V g;
+  for (size_t i = 0; i < c * k; ++i)
+    g.add_vertex();
+  for (size_t i = 0; i < c; ++i) {
+    add_clique(g, i * k, k);
+    g.add_edge(i * k, ((i + 1) % c) * k + 1, 1);
+  }
+  return g;
+}
+
+// Returns a graph of c groups of k vertices, where vertices in the same
+// group are joined with probability p and others with probability q.
+V
+planted_partition(size_t c, size_t k, double p, double q, unsigned seed)
+{
+  minstd_rand prng(seed);
+  uniform_real_distribution<double> u(0, 1);
+  V g;
+  size_t n = c * k;
+  for (size_t i = 0; i < n; ++i)
+    g.add_vertex();
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = i + 1; j < n; ++j)
+      if (u(prng) < (i / k == j / k ? p : q))
+        g.add_edge(i, j, 1 + u(prng));
+  return g;
+}
+
+// Returns true if the vertices in each group of k have the same community,
+// and vertices in different groups do not.
+bool
+recovers(const community_structure& r, size_t c, size_t k)
+{
+  for (size_t v = 0; v < c * k; ++v)
+    for (size_t u = 0; u < c * k; ++u)
+      if ((r.community[u] == r.community[v]) != (u / k == v / k))
+        return false;
+  return true;
+}
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // Two 5-cliques joined by an edge.
+  V g;
+  for (size_t i = 0; i < 10; ++i)
+    g.add_vertex();
+  add_clique(g, 0, 5);
+  add_clique(g, 5, 5);
+  g.add_edge(4, 5, 1);
+
+  auto r = louvain(g);
+  assert(r.communities == 2);
+  assert(recovers(r, 2, 5));
+  assert(r.community[0] == 0 && r.community[9] == 1);
+  assert(close(r.modularity, 2 * (20.0 / 42 - 0.25)));
+  assert(close(r.modularity, modularity(g, r.community)));
+
+  // Without edges, every vertex is its own community.
+  V e;
+  for (size_t i = 0; i < 4; ++i)
+    e.add_vertex();
+  auto s = louvain(e);
+  assert(s.communities == 4 && s.modularity == 0 && s.levels == 0);
+
+  V z;
+  assert(louvain(z).communities == 0);
+}
+
+void
+check_weights()
+{
+  cout << "*** weights ***\n";
+  // A 6-cycle whose alternate edges are heavy splits into the heavy pairs,
+  // and a loop adds to the weight inside its community.
+  V g;
+  for (size_t i = 0; i < 6; ++i)
+    g.add_vertex();
+  for (size_t i = 0; i < 6; ++i)
+    g.add_edge(i, (i + 1) % 6, i % 2 ? 1 : 10);
+  auto r = louvain(g);
+  assert(r.communities == 3);
+  for (size_t i = 0; i < 6; i += 2)
+    assert(r.community[i] == r.community[i + 1]);
+  assert(close(r.modularity, modularity(g, r.community)));
+
+  auto unit = [](edge_handle) { return 1.0; };
+  vector<size_t> one(6, 0);
+  assert(close(modularity(g, one, unit), 0));
+
+  g.add_edge(0, 0, 5);
+  assert(modularity(g, r.community) > r.modularity);
+}
+
+void
+check_ring()
+{
+  cout << "*** ring ***\n";
+  V g = ring_of_cliques(30, 6);
+  auto r = louvain(g, edge_value<V>(g), 4);
+  assert(r.communities == 30);
+  assert(recovers(r, 30, 6));
+  assert(close(r.modularity, modularity(g, r.community)));
+}
+
+void
+check_planted()
+{
+  cout << "*** planted ***\n";
+  for (unsigned seed = 1; seed <= 5; ++seed) {
+    V g = planted_partition(8, 40, 0.4, 0.01, seed);
+    auto w = edge_value<V>(g);
+    auto r1 = louvain(g, w, 1);
+    auto r2 = louvain(g, w, 4);
+    assert(r1.community == r2.community);
+    assert(r1.modularity == r2.modularity);
+    assert(recovers(r1, 8, 40));
+    assert(close(r1.modularity, modularity(g, r1.community)));
+    assert(r1.levels >= 1);
+  }
+}
+
+void
+check_large()
+{
+  cout << "*** large ***\n";
+  V g = ring_of_cliques(2000, 8);
+  minstd_rand prng(1);
+  for (size_t i = 0; i < 2000; ++i)
+    g.add_edge(prng() % g.order(), prng() % g.order(), 1);
+  auto r1 = louvain(g, edge_value<V>(g), 1);
+  auto r2 = louvain(g, edge_value<V>(g));
+  assert(r1.community == r2.community);
+  assert(r1.modularity > 0.9);
+  assert(close(r2.modularity, modularity(g, r2.community)));
+}
+
+int main()
+{
+  check_small();
+  check_weights();
+  check_ring();
+  check_planted();
+  check_large();
+}
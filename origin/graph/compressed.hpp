@@ -0,0 +1,513 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_COMPRESSED_HPP
+#define ORIGIN_GRAPH_COMPRESSED_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <origin/sequence/range.hpp>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/memory.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                          [graph.compressed]
+  //                           Compressed Graphs
+  //
+  // A compressed graph is an immutable copy of the topology of an adjacency
+  // vector in which every neighbor list is sorted and stored as a sequence of
+  // variable-length integers. The list of v is encoded as
+  //
+  //    degree, zigzag(n[0] - v), n[1] - n[0], ..., n[k-1] - n[k-2]
+  //
+  // where each number is written in 7 bit groups, least significant first,
+  // with the high bit of a byte set when another byte follows. Neighbors
+  // with nearby handles, which are common in graphs with good vertex orders,
+  // take a single byte. An offset per vertex locates its list, and the degree
+  // of a vertex is read in constant time.
+  //
+  // A compressed graph stores neither vertex nor edge values. Its edges are
+  // identified by their endpoints: edge handles are source/target pairs
+  // (compressed_edge), produced as the lists are decoded, so parallel edges
+  // compare equal.
+  //
+  //    directed_compressed_graph
+  //    undirected_compressed_graph
+  //
+
+  // A compressed edge is the pair of endpoints of an edge. The default
+  // edge is invalid.
+  struct compressed_edge
+  {
+    compressed_edge() = default;
+    compressed_edge(vertex_handle s, vertex_handle t)
+      : source(s), target(t)
+    { }
+
+    explicit operator bool() const { return bool(source); }
+
+    vertex_handle source;
+    vertex_handle target;
+  };
+
+  // Equality
+  inline bool
+  operator==(compressed_edge a, compressed_edge b)
+  {
+    return a.source == b.source && a.target == b.target;
+  }
+
+  inline bool
+  operator!=(compressed_edge a, compressed_edge b) { return !(a == b); }
+
+  // Ordering
+  inline bool
+  operator<(compressed_edge a, compressed_edge b)
+  {
+    return a.source < b.source || (a.source == b.source && a.target < b.target);
+  }
+
+
+  namespace compressed_graph_impl
+  {
+    // Append the varint encoding of x to buf.
+    inline void
+    put_varint(std::vector<std::uint8_t>& buf, std::uint64_t x)
+    {
+      while (x >= 0x80) {
+        buf.push_back(std::uint8_t(x) | 0x80);
+        x >>= 7;
+      }
+      buf.push_back(std::uint8_t(x));
+    }
+
+    // Decode the varint at p, and advance p past it.
+    inline std::uint64_t
+    get_varint(const std::uint8_t*& p)
+    {
+      std::uint64_t x = *p & 0x7f;
+      unsigned s = 7;
+      while (*p++ & 0x80) {
+        x |= std::uint64_t(*p & 0x7f) << s;
+        s += 7;
+      }
+      return x;
+    }
+
+    // Map signed differences to unsigned numbers, so that differences of
+    // small magnitude have short encodings.
+    inline std::uint64_t
+    zigzag(std::int64_t x) { return (std::uint64_t(x) << 1) ^ (x >> 63); }
+
+    inline std::int64_t
+    unzigzag(std::uint64_t x) { return std::int64_t(x >> 1) ^ -std::int64_t(x & 1); }
+
+
+    // ---------------------------------------------------------------------- //
+    //                          Neighbor Iterator
+    //
+    // The neighbor iterator decodes a neighbor list. Dereferencing returns
+    // the edge from the owner of the list to the current neighbor or, if
+    // Reversed is true, the edge from the neighbor to the owner.
+    template<bool Reversed>
+      class neighbor_iterator
+      {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = compressed_edge;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const compressed_edge*;
+        using reference = compressed_edge;
+
+        neighbor_iterator()
+          : p(nullptr), owner(0), cur(0), left(0)
+        { }
+
+        // Initialize the iterator at the start of the list of v, which
+        // begins at p.
+        neighbor_iterator(const std::uint8_t* p, std::size_t v)
+          : p(p), owner(v), cur(0), left(get_varint(this->p))
+        {
+          if (left)
+            cur = v + unzigzag(get_varint(this->p));
+        }
+
+        // Returns the current neighbor.
+        std::size_t neighbor() const { return cur; }
+
+        // Returns the number of neighbors not yet visited, including the
+        // current one.
+        std::size_t remaining() const { return left; }
+
+        reference operator*() const
+        {
+          return Reversed ? compressed_edge(cur, owner)
+                          : compressed_edge(owner, cur);
+        }
+
+        neighbor_iterator& operator++()
+        {
+          assert(left);
+          if (--left)
+            cur += get_varint(p);
+          return *this;
+        }
+
+        neighbor_iterator operator++(int)
+        {
+          neighbor_iterator i = *this;
+          ++*this;
+          return i;
+        }
+
+        // Iterators over the same list are equal when they have the same
+        // number of neighbors left.
+        bool operator==(const neighbor_iterator& x) const { return left == x.left; }
+        bool operator!=(const neighbor_iterator& x) const { return left != x.left; }
+
+      private:
+        const std::uint8_t* p;
+        std::size_t owner;
+        std::size_t cur;
+        std::size_t left;
+      };
+
+
+    // ---------------------------------------------------------------------- //
+    //                          Adjacency Store
+    //
+    // The adjacency store holds the encoded neighbor lists of n vertices.
+    class adjacency_store
+    {
+    public:
+      adjacency_store() : offset_(1, 0), arcs_(0) { }
+
+      // Encode the lists produced by lists(v, buf), which appends the
+      // neighbors of v to buf.
+      template<typename F>
+        adjacency_store(std::size_t n, F lists);
+
+      std::size_t order() const { return offset_.size() - 1; }
+      std::size_t arcs() const  { return arcs_; }
+
+      // Returns the number of bytes used by the lists and their offsets.
+      std::size_t bytes() const
+      {
+        return data_.size() + offset_.size() * sizeof(std::size_t);
+      }
+
+      // Returns the memory of the offsets, counted as vertex nodes, and of
+      // the encoded lists.
+      graph_memory memory_usage() const
+      {
+        graph_memory m {};
+        m.vertices = memory_impl::block(offset_);
+        m.incidence = memory_impl::block(data_);
+        return m;
+      }
+
+      std::size_t degree(std::size_t v) const
+      {
+        const std::uint8_t* p = list(v);
+        return get_varint(p);
+      }
+
+      template<bool R>
+        bounded_range<neighbor_iterator<R>> neighbors(std::size_t v) const
+        {
+          return {neighbor_iterator<R>(list(v), v), neighbor_iterator<R>()};
+        }
+
+    private:
+      const std::uint8_t* list(std::size_t v) const
+      {
+        return data_.data() + offset_[v];
+      }
+
+      std::vector<std::uint8_t> data_;
+      std::vector<std::size_t> offset_;
+      std::size_t arcs_;
+    };
+
+    template<typename F>
+      adjacency_store::adjacency_store(std::size_t n, F lists)
+        : offset_(n + 1, 0), arcs_(0)
+      {
+        std::vector<std::size_t> buf;
+        for (std::size_t v = 0; v < n; ++v) {
+          offset_[v] = data_.size();
+          buf.clear();
+          lists(v, buf);
+          std::sort(buf.begin(), buf.end());
+          put_varint(data_, buf.size());
+          if (!buf.empty())
+            put_varint(data_, zigzag(std::int64_t(buf[0]) - std::int64_t(v)));
+          for (std::size_t i = 1; i < buf.size(); ++i)
+            put_varint(data_, buf[i] - buf[i - 1]);
+          arcs_ += buf.size();
+        }
+        offset_[n] = data_.size();
+        data_.shrink_to_fit();
+      }
+
+
+    // ---------------------------------------------------------------------- //
+    //                            Edge Iterator
+    //
+    // The edge iterator visits every edge of a compressed graph by decoding
+    // each list in turn. In an undirected graph, every edge appears in the
+    // lists of both its endpoints (a loop appears twice in one list), so
+    // only the copy in the list of its lesser endpoint, and every other copy
+    // of a loop, is visited.
+    class edge_iterator
+    {
+      using list_iterator = neighbor_iterator<false>;
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = compressed_edge;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const compressed_edge*;
+      using reference = compressed_edge;
+
+      edge_iterator()
+        : store(nullptr), v(0), once(false), skip(false)
+      { }
+
+      edge_iterator(const adjacency_store* s, std::size_t v, bool undirected)
+        : store(s), v(v), once(undirected), skip(false)
+      {
+        if (v < store->order())
+          i = store->neighbors<false>(v).begin();
+        settle();
+      }
+
+      reference operator*() const { return *i; }
+
+      edge_iterator& operator++() { ++i; settle(); return *this; }
+
+      edge_iterator operator++(int)
+      {
+        edge_iterator x = *this;
+        ++*this;
+        return x;
+      }
+
+      bool operator==(const edge_iterator& x) const
+      {
+        return v == x.v && i.remaining() == x.i.remaining();
+      }
+
+      bool operator!=(const edge_iterator& x) const { return !(*this == x); }
+
+    private:
+      // Move to the next edge that should be visited, if the current one
+      // should not be.
+      void settle()
+      {
+        while (v < store->order()) {
+          if (i.remaining() == 0) {
+            if (++v < store->order())
+              i = store->neighbors<false>(v).begin();
+            skip = false;
+            continue;
+          }
+          if (!once || i.neighbor() > v)
+            return;
+          if (i.neighbor() == v && (skip = !skip))
+            return;
+          ++i;
+        }
+        i = list_iterator();
+      }
+
+      const adjacency_store* store;
+      std::size_t v;
+      list_iterator i;
+      bool once; // True if edges are stored twice
+      bool skip; // True if the next copy of a loop is skipped
+    };
+
+  } // namespace compressed_graph_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                      Directed Compressed Graph
+  //
+  // The directed compressed graph stores the out neighbors and the in
+  // neighbors of each vertex. It is built from a directed graph whose vertex
+  // handles are the integers in [0, g.order()), as in the adjacency vector
+  // classes.
+  class directed_compressed_graph
+  {
+    using store_type = compressed_graph_impl::adjacency_store;
+    using vertex_iter = adjacency_vector_impl::handle_counter<std::size_t, vertex_handle>;
+    using edge_iter = compressed_graph_impl::edge_iterator;
+  public:
+    using vertex = vertex_handle;
+    using vertex_range = bounded_range<vertex_iter>;
+
+    using edge = compressed_edge;
+    using edge_range = bounded_range<edge_iter>;
+
+    using out_edge_range = bounded_range<compressed_graph_impl::neighbor_iterator<false>>;
+    using in_edge_range = bounded_range<compressed_graph_impl::neighbor_iterator<true>>;
+
+    directed_compressed_graph() = default;
+
+    template<typename G>
+      explicit directed_compressed_graph(const G& g);
+
+    // Observers
+    bool        null() const  { return order() == 0; }
+    std::size_t order() const { return out_.order(); }
+
+    bool        empty() const { return size() == 0; }
+    std::size_t size() const  { return out_.arcs(); }
+
+    // Returns the number of bytes used to store the graph.
+    std::size_t bytes() const { return out_.bytes() + in_.bytes(); }
+
+    // Returns the memory used by the graph, as described in [graph.memory].
+    graph_memory memory_usage() const
+    {
+      graph_memory m = out_.memory_usage();
+      return m += in_.memory_usage();
+    }
+
+    // Vertex observers
+    std::size_t out_degree(vertex v) const { return out_.degree(v); }
+    std::size_t in_degree(vertex v) const  { return in_.degree(v); }
+    std::size_t degree(vertex v) const { return out_degree(v) + in_degree(v); }
+
+    // Edge observers
+    vertex source(edge e) const { return e.source; }
+    vertex target(edge e) const { return e.target; }
+
+    // Iterators
+    vertex_range vertices() const;
+    edge_range   edges() const;
+
+    out_edge_range out_edges(vertex v) const { return out_.neighbors<false>(v); }
+    in_edge_range  in_edges(vertex v) const  { return in_.neighbors<true>(v); }
+
+  private:
+    store_type out_;
+    store_type in_;
+  };
+
+  template<typename G>
+    directed_compressed_graph::directed_compressed_graph(const G& g)
+      : out_(g.order(), [&g](std::size_t v, std::vector<std::size_t>& buf) {
+          for (auto e : g.out_edges(Vertex<G>(v)))
+            buf.push_back(g.target(e));
+        }),
+        in_(g.order(), [&g](std::size_t v, std::vector<std::size_t>& buf) {
+          for (auto e : g.in_edges(Vertex<G>(v)))
+            buf.push_back(g.source(e));
+        })
+    { }
+
+  inline auto
+  directed_compressed_graph::vertices() const -> vertex_range
+  {
+    return {vertex_iter(0), vertex_iter(order())};
+  }
+
+  inline auto
+  directed_compressed_graph::edges() const -> edge_range
+  {
+    return {edge_iter(&out_, 0, false), edge_iter(&out_, order(), false)};
+  }
+
+
+  // ------------------------------------------------------------------------ //
+  //                     Undirected Compressed Graph
+  //
+  // The undirected compressed graph stores the neighbors of each vertex. The
+  // edges incident to v have v as their source, so the opposite endpoint of
+  // an incident edge is its target. It is built from an undirected graph
+  // whose vertex handles are the integers in [0, g.order()).
+  class undirected_compressed_graph
+  {
+    using store_type = compressed_graph_impl::adjacency_store;
+    using vertex_iter = adjacency_vector_impl::handle_counter<std::size_t, vertex_handle>;
+    using edge_iter = compressed_graph_impl::edge_iterator;
+  public:
+    using vertex = vertex_handle;
+    using vertex_range = bounded_range<vertex_iter>;
+
+    using edge = compressed_edge;
+    using edge_range = bounded_range<edge_iter>;
+
+    using incidence_range = bounded_range<compressed_graph_impl::neighbor_iterator<false>>;
+
+    undirected_compressed_graph() = default;
+
+    template<typename G>
+      explicit undirected_compressed_graph(const G& g);
+
+    // Observers
+    bool        null() const  { return order() == 0; }
+    std::size_t order() const { return adj_.order(); }
+
+    bool        empty() const { return size() == 0; }
+    std::size_t size() const  { return adj_.arcs() / 2; }
+
+    // Returns the number of bytes used to store the graph.
+    std::size_t bytes() const { return adj_.bytes(); }
+
+    // Returns the memory used by the graph, as described in [graph.memory].
+    graph_memory memory_usage() const { return adj_.memory_usage(); }
+
+    // Vertex observers
+    std::size_t degree(vertex v) const { return adj_.degree(v); }
+
+    // Edge observers
+    vertex source(edge e) const { return e.source; }
+    vertex target(edge e) const { return e.target; }
+
+    // Iterators
+    vertex_range    vertices() const;
+    edge_range      edges() const;
+    incidence_range edges(vertex v) const { return adj_.neighbors<false>(v); }
+
+  private:
+    store_type adj_;
+  };
+
+  template<typename G>
+    undirected_compressed_graph::undirected_compressed_graph(const G& g)
+      : adj_(g.order(), [&g](std::size_t v, std::vector<std::size_t>& buf) {
+          Vertex<G> u(v);
+          for (auto e : g.edges(u))
+            buf.push_back(opposite(g, e, u));
+        })
+    { }
+
+  inline auto
+  undirected_compressed_graph::vertices() const -> vertex_range
+  {
+    return {vertex_iter(0), vertex_iter(order())};
+  }
+
+  inline auto
+  undirected_compressed_graph::edges() const -> edge_range
+  {
+    return {edge_iter(&adj_, 0, true), edge_iter(&adj_, order(), true)};
+  }
+
+} // namespace origin
+
+#endif
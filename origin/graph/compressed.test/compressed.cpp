@@ -0,0 +1,179 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/compressed.hpp>
+#include <origin/graph/core.hpp>
+#include <origin/graph/traversal.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using D = directed_adjacency_vector<empty_t, empty_t>;
+using U = undirected_adjacency_vector<empty_t, empty_t>;
+
+// Returns the sorted list of endpoints of a range of edges, as given by f.
+template<typename R, typename F>
+  vector<size_t>
+  ends(const R& r, F f)
+  {
+    vector<size_t> v;
+    for (auto e : r)
+      v.push_back(f(e));
+    sort(v.begin(), v.end());
+    return v;
+  }
+
+void
+check_varint()
+{
+  cout << "*** varint ***\n";
+  using namespace compressed_graph_impl;
+  vector<uint8_t> buf;
+  vector<uint64_t> xs {0, 1, 127, 128, 300, 16383, 16384, uint64_t(-1)};
+  for (auto x : xs)
+    put_varint(buf, x);
+  assert(buf[0] == 0 && buf[2] == 127 && buf[3] == 0x80 && buf[4] == 1);
+  const uint8_t* p = buf.data();
+  for (auto x : xs)
+    assert(get_varint(p) == x);
+  assert(p == buf.data() + buf.size());
+
+  for (int64_t x : {0, 1, -1, 63, -64, 1000000, -1000000})
+    assert(unzigzag(zigzag(x)) == x);
+  assert(zigzag(-1) == 1 && zigzag(1) == 2);
+}
+
+void
+check_directed()
+{
+  cout << "*** directed ***\n";
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    D g = random_graph<D>(300, 1500, seed);
+    directed_compressed_graph c(g);
+    assert(Directed_graph<directed_compressed_graph>());
+    assert(c.order() == g.order() && c.size() == g.size());
+
+    auto src = [&](compressed_edge e) { return size_t(c.source(e)); };
+    auto tgt = [&](compressed_edge e) { return size_t(c.target(e)); };
+    for (auto v : g.vertices()) {
+      assert(c.out_degree(v) == g.out_degree(v));
+      assert(c.in_degree(v) == g.in_degree(v));
+      auto out = ends(g.out_edges(v), [&](edge_handle e) { return g.target(e); });
+      auto in = ends(g.in_edges(v), [&](edge_handle e) { return g.source(e); });
+      assert(ends(c.out_edges(v), tgt) == out);
+      assert(ends(c.in_edges(v), src) == in);
+      for (auto e : c.out_edges(v))
+        assert(c.source(e) == v);
+      for (auto e : c.in_edges(v))
+        assert(c.target(e) == v);
+    }
+
+    vector<compressed_edge> a, b;
+    for (auto e : g.edges())
+      a.emplace_back(g.source(e), g.target(e));
+    for (auto e : c.edges())
+      b.push_back(e);
+    sort(a.begin(), a.end());
+    assert(a == b);
+
+    // Searches visit the same vertices.
+    vector<size_t> x, y;
+    for (auto v : bfs_range(g, Vertex<D>(0)))
+      x.push_back(v);
+    for (auto v : bfs_range(c, vertex_handle(0)))
+      y.push_back(v);
+    sort(x.begin(), x.end());
+    sort(y.begin(), y.end());
+    assert(x == y);
+  }
+}
+
+void
+check_undirected()
+{
+  cout << "*** undirected ***\n";
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    U g = random_graph<U>(300, 1200, seed);
+    undirected_compressed_graph c(g);
+    assert(Undirected_graph<undirected_compressed_graph>());
+    assert(c.order() == g.order() && c.size() == g.size());
+
+    for (auto v : g.vertices()) {
+      assert(c.degree(v) == g.degree(v));
+      auto adj = ends(g.edges(v), [&](edge_handle e) { return opposite(g, e, v); });
+      auto cadj = ends(c.edges(v), [&](compressed_edge e) {
+        assert(c.source(e) == v);
+        return size_t(c.target(e));
+      });
+      assert(cadj == adj);
+    }
+
+    // Every edge is visited once, loops included.
+    vector<compressed_edge> a, b;
+    for (auto e : g.edges()) {
+      size_t s = g.source(e), t = g.target(e);
+      a.emplace_back(min(s, t), max(s, t));
+    }
+    for (auto e : c.edges())
+      b.push_back(e);
+    sort(a.begin(), a.end());
+    assert(a == b);
+
+    auto r1 = core_decomposition(g);
+    auto r2 = core_decomposition(c);
+    for (auto v : g.vertices())
+      assert(r1.core[v] == r2.core[v]);
+  }
+}
+
+void
+check_size()
+{
+  cout << "*** size ***\n";
+  undirected_compressed_graph e;
+  assert(e.null() && e.empty());
+  assert(e.vertices().begin() == e.vertices().end());
+  assert(e.edges().begin() == e.edges().end());
+
+  D g0;
+  for (size_t i = 0; i < 10; ++i)
+    g0.add_vertex();
+  directed_compressed_graph d0(g0);
+  assert(d0.order() == 10 && d0.empty());
+  assert(d0.edges().begin() == d0.edges().end());
+
+  // Neighbors close in the handle order take one byte per arc, plus the
+  // offsets and degrees.
+  U g;
+  size_t n = 10000;
+  for (size_t i = 0; i < n; ++i)
+    g.add_vertex();
+  for (size_t i = 0; i < n; ++i)
+    for (size_t d = 1; d <= 8; ++d)
+      g.add_edge(i, (i + d) % n);
+  undirected_compressed_graph c(g);
+  assert(c.size() == 8 * n);
+  size_t arcs = 2 * c.size();
+  assert(c.bytes() < arcs * 2);
+  assert(c.bytes() - n * sizeof(size_t) < arcs + 4 * n);
+}
+
+int main()
+{
+  check_varint();
+  check_directed();
+  check_undirected();
+  check_size();
+}
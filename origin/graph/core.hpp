@@ -0,0 +1,215 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_CORE_HPP
+#define ORIGIN_GRAPH_CORE_HPP
+
+#include <cassert>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <origin/graph/graph.hpp>
+#include <origin/graph/parallel.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                                [graph.core]
+  //                          Core Decomposition
+  //
+  // The k-core of an undirected graph is the largest subgraph in which every
+  // vertex has degree at least k. The core number of a vertex is the largest
+  // k for which it belongs to the k-core, and the degeneracy of the graph is
+  // the largest core number.
+  //
+  //    core_decomposition(g)
+  //    parallel_core_decomposition(g, threads)
+  //
+  // Both algorithms return the core number of each vertex, indexed by vertex
+  // handle, and a degeneracy ordering of the vertices: an ordering in which
+  // each vertex has at most degeneracy neighbors that appear after it. Core
+  // numbers are computed from g.degree(v), so parallel edges each count, and
+  // a loop counts as often as it appears in the incidence list of v.
+  //
+  // The core array is sized by vertex_bound(g). The entries for handles that
+  // do not denote vertices of g are 0.
+  template<typename G>
+    struct k_cores
+    {
+      std::vector<std::size_t> core;
+      std::vector<Vertex<G>> order;
+      std::size_t degeneracy;
+    };
+
+
+  // Compute the core decomposition of g using the bucket algorithm of
+  // Batagelj and Zaversnik, in O(n + m) time. Vertices are kept in an array
+  // sorted by current degree, with the start of each degree's bucket, and
+  // vertices are removed in order of least degree. Removing a vertex moves
+  // each neighbor of greater degree to the front of its bucket, and then
+  // into the bucket below by advancing that bucket's start.
+  //
+  // The order in which vertices are removed is a degeneracy ordering.
+  template<typename G>
+    k_cores<G>
+    core_decomposition(const G& g)
+    {
+      std::size_t n = vertex_bound(g);
+      std::vector<std::size_t> deg(n, 0);
+      std::size_t md = 0;
+      for (auto v : g.vertices()) {
+        deg[v] = g.degree(v);
+        md = std::max(md, deg[v]);
+      }
+
+      // Sort the vertices by degree.
+      std::vector<std::size_t> bin(md + 1, 0);
+      for (auto v : g.vertices())
+        ++bin[deg[v]];
+      std::size_t start = 0;
+      for (std::size_t d = 0; d <= md; ++d) {
+        std::size_t k = bin[d];
+        bin[d] = start;
+        start += k;
+      }
+      std::vector<std::size_t> pos(n);
+      std::vector<Vertex<G>> vert(g.order());
+      for (auto v : g.vertices()) {
+        pos[v] = bin[deg[v]]++;
+        vert[pos[v]] = v;
+      }
+      for (std::size_t d = md; d > 0; --d)
+        bin[d] = bin[d - 1];
+      bin[0] = 0;
+
+      // Remove vertices in order of least degree.
+      std::size_t degeneracy = 0;
+      for (std::size_t i = 0; i < vert.size(); ++i) {
+        Vertex<G> v = vert[i];
+        degeneracy = std::max(degeneracy, deg[v]);
+        for (auto e : g.edges(v)) {
+          Vertex<G> u = opposite(g, e, v);
+          if (deg[u] > deg[v]) {
+            std::size_t du = deg[u];
+            std::size_t pu = pos[u];
+            std::size_t pw = bin[du];
+            Vertex<G> w = vert[pw];
+            if (u != w) {
+              pos[u] = pw;
+              vert[pu] = w;
+              pos[w] = pu;
+              vert[pw] = u;
+            }
+            ++bin[du];
+            --deg[u];
+          }
+        }
+      }
+      return {std::move(deg), std::move(vert), degeneracy};
+    }
+
+
+  // Compute the core decomposition of g by parallel peeling. For each k in
+  // increasing order, the vertices of degree at most k are removed in rounds:
+  // each round removes its whole frontier concurrently, atomically
+  // decrementing the degrees of the neighbors that are above k, and a
+  // neighbor whose degree falls to k joins the next frontier. Levels at which
+  // no vertex remains with degree at most k are skipped.
+  //
+  // The work is O(n + m) plus O(n) for each distinct core number, and the
+  // vertices removed in each round appear in the degeneracy ordering in
+  // arbitrary order.
+  template<typename G>
+    k_cores<G>
+    parallel_core_decomposition(const G& g, std::size_t threads = 0)
+    {
+      std::size_t n = vertex_bound(g);
+      std::unique_ptr<std::atomic<std::size_t>[]> deg(
+        new std::atomic<std::size_t>[n]
+      );
+      for (std::size_t i = 0; i < n; ++i)
+        deg[i].store(0, std::memory_order_relaxed);
+
+      std::vector<Vertex<G>> rest;
+      rest.reserve(g.order());
+      for (auto v : g.vertices()) {
+        deg[v].store(g.degree(v), std::memory_order_relaxed);
+        rest.push_back(v);
+      }
+
+      k_cores<G> r {std::vector<std::size_t>(n, 0), {}, 0};
+      r.order.reserve(g.order());
+
+      std::size_t t = thread_count(n, threads);
+      std::vector<std::vector<Vertex<G>>> next(t);
+      std::vector<Vertex<G>> frontier;
+      std::size_t k = 0;
+      while (!rest.empty()) {
+        // Find the least degree of the remaining vertices, and move to that
+        // level if it is above the current one.
+        std::vector<std::size_t> least(t, std::size_t(-1));
+        auto reduce = [&](std::size_t i, std::size_t b, std::size_t e) {
+          for (std::size_t j = b; j != e; ++j) {
+            std::size_t d = deg[rest[j]].load(std::memory_order_relaxed);
+            least[i] = std::min(least[i], d);
+          }
+        };
+        parallel_blocks(rest.size(), reduce, t);
+        k = std::max(k, *std::min_element(least.begin(), least.end()));
+
+        frontier = parallel_filter(rest, [&](Vertex<G> v) {
+          return deg[v].load(std::memory_order_relaxed) <= k;
+        }, t);
+
+        // Peel the frontier until no vertex falls to this level.
+        while (!frontier.empty()) {
+          for (Vertex<G> v : frontier)
+            r.core[v] = k;
+          r.order.insert(r.order.end(), frontier.begin(), frontier.end());
+          auto peel = [&](std::size_t i, std::size_t b, std::size_t e) {
+            for (std::size_t j = b; j != e; ++j) {
+              Vertex<G> v = frontier[j];
+              for (auto x : g.edges(v)) {
+                Vertex<G> u = opposite(g, x, v);
+                // Decrement only while the degree is above k, so that
+                // concurrent peels cannot push it below the level. The
+                // thread that takes it from k + 1 to k claims u.
+                std::atomic<std::size_t>& d = deg[u];
+                std::size_t c = d.load(std::memory_order_relaxed);
+                while (c > k)
+                  if (d.compare_exchange_weak(c, c - 1, std::memory_order_relaxed)) {
+                    if (c == k + 1)
+                      next[i].push_back(u);
+                    break;
+                  }
+              }
+            }
+          };
+          parallel_blocks(frontier.size(), peel, t);
+
+          frontier.clear();
+          for (auto& x : next) {
+            frontier.insert(frontier.end(), x.begin(), x.end());
+            x.clear();
+          }
+        }
+
+        // Remove the vertices peeled at this level from the remainder.
+        rest = parallel_filter(rest, [&](Vertex<G> v) {
+          return deg[v].load(std::memory_order_relaxed) > k;
+        }, t);
+      }
+      r.degeneracy = k;
+      return r;
+    }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,197 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_list.hpp>
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/core.hpp>
+#include <origin/graph/generator.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using L = undirected_adjacency_list<>;
+using V = undirected_adjacency_vector<>;
+
+// Compute core numbers by repeatedly deleting every vertex whose degree is
+// below k from a copy of g.
+template<typename G>
+  vector<size_t>
+  simple_cores(G g)
+  {
+    vector<size_t> core(vertex_bound(g), 0);
+    for (size_t k = 1; !g.null(); ++k) {
+      bool removed = true;
+      while (removed) {
+        removed = false;
+        vector<Vertex<G>> low;
+        for (auto v : g.vertices())
+          if (g.degree(v) < k)
+            low.push_back(v);
+        for (auto v : low) {
+          core[v] = k - 1;
+          g.remove_vertex(v);
+          removed = true;
+        }
+      }
+    }
+    return core;
+  }
+
+// Check that the cores and ordering describe a decomposition of g.
+template<typename G>
+  void
+  check_cores(const G& g, const k_cores<G>& r)
+  {
+    assert(r.order.size() == g.order());
+    vector<size_t> pos(vertex_bound(g), size_t(-1));
+    for (size_t i = 0; i < r.order.size(); ++i) {
+      assert(pos[r.order[i]] == size_t(-1));
+      pos[r.order[i]] = i;
+    }
+
+    size_t d = 0;
+    for (auto v : g.vertices()) {
+      d = max(d, r.core[v]);
+      size_t later = 0;
+      for (auto e : g.edges(v))
+        if (pos[opposite(g, e, v)] > pos[v])
+          ++later;
+      assert(later <= r.degeneracy);
+      assert(later <= r.core[v]);
+    }
+    assert(d == r.degeneracy);
+  }
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // A 4-clique with a pendant path, and an isolated vertex.
+  V g;
+  for (int i = 0; i < 7; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1);
+  g.add_edge(0, 2);
+  g.add_edge(0, 3);
+  g.add_edge(1, 2);
+  g.add_edge(1, 3);
+  g.add_edge(2, 3);
+  g.add_edge(3, 4);
+  g.add_edge(4, 5);
+
+  vector<size_t> expect {3, 3, 3, 3, 1, 1, 0};
+  auto r1 = core_decomposition(g);
+  auto r2 = parallel_core_decomposition(g, 4);
+  assert(r1.core == expect);
+  assert(r2.core == expect);
+  assert(r1.degeneracy == 3);
+  assert(r2.degeneracy == 3);
+  check_cores(g, r1);
+  check_cores(g, r2);
+}
+
+void
+check_vector()
+{
+  cout << "*** vector ***\n";
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    V g = generate_graph<V>(gnm_generator(300, 300 * (seed % 7 + 1), seed));
+    auto r1 = core_decomposition(g);
+    auto r2 = parallel_core_decomposition(g, 4);
+    assert(r1.core == simple_cores(generate_graph<L>(gnm_generator(300, 300 * (seed % 7 + 1), seed))));
+    assert(r1.core == r2.core);
+    check_cores(g, r1);
+    check_cores(g, r2);
+  }
+}
+
+void
+check_list()
+{
+  cout << "*** list ***\n";
+  // Removing vertices leaves holes in the handle space.
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    L g = generate_graph<L>(gnm_generator(300, 1500, seed));
+    for (size_t v = 0; v < 300; v += 7)
+      g.remove_vertex(v);
+    auto r1 = core_decomposition(g);
+    auto r2 = parallel_core_decomposition(g, 4);
+    assert(r1.core == simple_cores(g));
+    assert(r1.core == r2.core);
+    check_cores(g, r1);
+    check_cores(g, r2);
+  }
+}
+
+void
+check_contention()
+{
+  cout << "*** contention ***\n";
+  // Many frontier vertices decrement the same neighbors at once: the hubs
+  // of a star and of a complete bipartite graph, and the vertices of a
+  // clique.
+  V star;
+  star.add_vertex();
+  for (size_t i = 1; i <= 50000; ++i) {
+    star.add_vertex();
+    star.add_edge(0, i);
+  }
+  V bip;
+  for (size_t i = 0; i < 20008; ++i)
+    bip.add_vertex();
+  for (size_t h = 0; h < 8; ++h)
+    for (size_t i = 8; i < 20008; ++i)
+      bip.add_edge(h, i);
+  V clique;
+  for (size_t i = 0; i < 400; ++i)
+    clique.add_vertex();
+  for (size_t i = 0; i < 400; ++i)
+    for (size_t j = i + 1; j < 400; ++j)
+      clique.add_edge(i, j);
+
+  for (size_t t : {2, 4, 8}) {
+    for (int rep = 0; rep < 5; ++rep) {
+      auto r = parallel_core_decomposition(star, t);
+      assert(r.core == vector<size_t>(star.order(), 1));
+      check_cores(star, r);
+
+      r = parallel_core_decomposition(bip, t);
+      assert(r.core == vector<size_t>(bip.order(), 8));
+      check_cores(bip, r);
+
+      r = parallel_core_decomposition(clique, t);
+      assert(r.core == vector<size_t>(clique.order(), 399));
+      check_cores(clique, r);
+    }
+  }
+}
+
+void
+check_large()
+{
+  cout << "*** large ***\n";
+  V g = generate_graph<V>(gnm_generator(50000, 500000, 1));
+  auto r1 = core_decomposition(g);
+  auto r2 = parallel_core_decomposition(g);
+  assert(r1.core == r2.core);
+  assert(r1.degeneracy == r2.degeneracy);
+}
+
+int main()
+{
+  check_small();
+  check_vector();
+  check_list();
+  check_contention();
+  check_large();
+}
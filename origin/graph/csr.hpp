@@ -0,0 +1,168 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_CSR_HPP
+#define ORIGIN_GRAPH_CSR_HPP
+
+#include <cassert>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <origin/sequence/range.hpp>
+
+#include <origin/graph/handle.hpp>
+#include <origin/graph/graph.hpp>
+#include <origin/graph/memory.hpp>
+#include <origin/graph/numa.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                                 [graph.csr]
+  //                        Compressed Sparse Rows
+  //
+  // The CSR graph is an immutable, compact copy of the out edges of a
+  // directed graph. The arcs leaving each vertex are stored contiguously and
+  // sorted by target, so the out neighbors of a vertex form a contiguous
+  // array and adjacency can be tested by binary search.
+  //
+  // Arcs are numbered from 0 to size() - 1. The arcs of v are the numbers in
+  // [first(v), last(v)), and each arc records its target and the handle of
+  // the edge it was copied from, so that edge properties of the original
+  // graph can be looked up.
+  //
+  // Vertex handles of the original graph must be the integers in
+  // [0, g.order()), as in the adjacency vector classes.
+  //
+  // The arrays can be placed across NUMA nodes (see [graph.numa]) when the
+  // graph is built. Under partitioning, the offsets of the vertices owned by
+  // a node are local to it, and so are their arcs when degrees are roughly
+  // even; interleaving spreads the load regardless of the degrees.
+  class csr_graph
+  {
+  public:
+    using vertex = vertex_handle;
+    using edge = edge_handle;
+    using neighbor_range = bounded_range<const std::size_t*>;
+
+    csr_graph();
+
+    template<typename G>
+      explicit csr_graph(const G& g, numa_policy p = numa_policy::local,
+                         const numa_topology& topo = numa_system());
+
+    // Observers
+    bool        null() const  { return order() == 0; }
+    std::size_t order() const { return offset_.size() - 1; }
+
+    bool        empty() const { return size() == 0; }
+    std::size_t size() const  { return target_.size(); }
+
+    std::size_t out_degree(std::size_t v) const { return last(v) - first(v); }
+
+    // Arc access
+    std::size_t first(std::size_t v) const { return offset_[v]; }
+    std::size_t last(std::size_t v) const  { return offset_[v + 1]; }
+
+    std::size_t target(std::size_t a) const { return target_[a]; }
+    edge        edge_of(std::size_t a) const { return edge_[a]; }
+
+    // Returns the out neighbors of v in increasing order.
+    neighbor_range out_neighbors(std::size_t v) const;
+
+    // Returns true if there is an arc from u to v.
+    bool adjacent(std::size_t u, std::size_t v) const;
+
+    // Memory
+    graph_memory memory_usage() const;
+
+  private:
+    numa_vector<std::size_t> offset_;
+    numa_vector<std::size_t> target_;
+    numa_vector<edge> edge_;
+  };
+
+  inline
+  csr_graph::csr_graph()
+    : offset_(1, 0)
+  { }
+
+  // Copy the out edges of g. The arcs of each vertex are sorted by target,
+  // and arcs with equal targets (parallel edges) keep their edge order.
+  // The arrays are placed by the policy p on the nodes of topo.
+  template<typename G>
+    csr_graph::csr_graph(const G& g, numa_policy p, const numa_topology& topo)
+      : offset_(g.order() + 1, 0, numa_allocator<std::size_t>(p, topo)),
+        target_(numa_allocator<std::size_t>(p, topo)),
+        edge_(numa_allocator<edge>(p, topo))
+    {
+      target_.reserve(g.size());
+      edge_.reserve(g.size());
+      std::vector<std::size_t> perm;
+      std::vector<std::size_t> t;
+      std::vector<edge> x;
+      for (auto v : g.vertices()) {
+        std::size_t b = target_.size();
+        offset_[v] = b;
+        for (auto e : g.out_edges(v)) {
+          target_.push_back(g.target(e));
+          edge_.push_back(e);
+        }
+
+        // Sort the arcs of v by target.
+        std::size_t n = target_.size() - b;
+        perm.resize(n);
+        std::iota(perm.begin(), perm.end(), std::size_t(0));
+        std::stable_sort(perm.begin(), perm.end(),
+                         [&](std::size_t i, std::size_t j) {
+          return target_[b + i] < target_[b + j];
+        });
+        t.resize(n);
+        x.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+          t[i] = target_[b + perm[i]];
+          x[i] = edge_[b + perm[i]];
+        }
+        std::copy(t.begin(), t.end(), target_.begin() + b);
+        std::copy(x.begin(), x.end(), edge_.begin() + b);
+      }
+      offset_[g.order()] = target_.size();
+    }
+
+  inline auto
+  csr_graph::out_neighbors(std::size_t v) const -> neighbor_range
+  {
+    const std::size_t* p = target_.data();
+    return {p + first(v), p + last(v)};
+  }
+
+  inline bool
+  csr_graph::adjacent(std::size_t u, std::size_t v) const
+  {
+    auto r = out_neighbors(u);
+    return std::binary_search(r.begin(), r.end(), v);
+  }
+
+  // Returns the memory used by the graph, as described in [graph.memory].
+  // The offsets are counted as vertex nodes, the targets of the arcs as
+  // incidence lists, and their edge handles as edge nodes.
+  inline graph_memory
+  csr_graph::memory_usage() const
+  {
+    using memory_impl::block;
+    graph_memory m {};
+    m.vertices = block(offset_);
+    m.edges = block(edge_);
+    m.incidence = block(target_);
+    return m;
+  }
+
+} // namespace origin
+
+#endif
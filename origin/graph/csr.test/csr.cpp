@@ -0,0 +1,70 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <random>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/csr.hpp>
+
+using namespace std;
+using namespace origin;
+
+using G = directed_adjacency_vector<empty_t, int>;
+
+void
+check_empty()
+{
+  cout << "*** empty ***\n";
+  csr_graph c;
+  assert(c.null());
+  assert(c.empty());
+
+  G g;
+  csr_graph d(g);
+  assert(d.null());
+}
+
+void
+check_random()
+{
+  cout << "*** random ***\n";
+  minstd_rand prng(3);
+  G g;
+  for (int i = 0; i < 50; ++i)
+    g.add_vertex();
+  for (int i = 0; i < 400; ++i)
+    g.add_edge(prng() % 50, prng() % 50, i);
+
+  csr_graph c(g);
+  assert(c.order() == g.order());
+  assert(c.size() == g.size());
+  size_t n = 0;
+  for (auto v : g.vertices()) {
+    assert(c.out_degree(v) == g.out_degree(v));
+    auto r = c.out_neighbors(v);
+    assert(is_sorted(r.begin(), r.end()));
+
+    // Each arc refers to an out edge of v with the same target.
+    for (size_t a = c.first(v); a != c.last(v); ++a) {
+      Edge<G> e = c.edge_of(a);
+      assert(g.source(e) == v);
+      assert(g.target(e) == Vertex<G>(c.target(a)));
+      ++n;
+    }
+    for (auto u : g.vertices())
+      assert(c.adjacent(v, u) == bool(g(v, u)));
+  }
+  assert(n == g.size());
+}
+
+int main()
+{
+  check_empty();
+  check_random();
+}
@@ -0,0 +1,24 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_EDGE_PAIR_HPP
+#define ORIGIN_GRAPH_EDGE_PAIR_HPP
+
+#include <cstddef>
+
+#include <utility>
+
+namespace origin
+{
+  // An edge pair names an edge by the indices of its source and target
+  // vertices. Edge lists of this form are produced by the graph generators
+  // and consumed by the bulk loader, independently of any graph type.
+  using edge_pair = std::pair<std::size_t, std::size_t>;
+
+} // namespace origin
+
+#endif
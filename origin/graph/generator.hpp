@@ -0,0 +1,631 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_GENERATOR_HPP
+#define ORIGIN_GRAPH_GENERATOR_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <origin/graph/edge_pair.hpp>
+#include <origin/graph/parallel.hpp>
+#include <origin/graph/random.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                           [graph.generator]
+  //                          Graph Generators
+  //
+  // A graph generator describes a random (or regular) graph on the vertices
+  // [0, order()) as a sequence of blocks of edges. Each generator provides:
+  //
+  //    g.order()             the number of vertices
+  //    g.blocks()            the number of blocks
+  //    g.generate(b, out)    append the edges of block b to out
+  //
+  // Blocks are generated independently, each from counter-based random
+  // streams (see [graph.random]) determined by the seed and the block, or by
+  // the position of an edge. The edge sequence therefore depends only on the
+  // parameters and the seed, not on the number of threads that generate it.
+  //
+  // The driver functions generate blocks in parallel and deliver them in
+  // order: to a vector, to a sink function, to a text edge file, or to a
+  // graph. The sink and file drivers keep only a few blocks per thread in
+  // memory, so graphs larger than memory can be written to disk.
+
+  namespace generator_impl
+  {
+    // The number of edges generated per block, approximately.
+    constexpr std::size_t block_size = 1 << 16;
+
+    // The number of blocks generated per thread between deliveries.
+    constexpr std::size_t window = 4;
+
+    inline std::size_t
+    ceil_div(std::size_t a, std::size_t b)
+    {
+      return a / b + (a % b != 0);
+    }
+
+    // Returns the number of vertex pairs that may be connected by an edge:
+    // ordered pairs if directed, and unordered pairs otherwise. Loops are
+    // excluded.
+    inline std::size_t
+    pair_count(std::size_t n, bool directed)
+    {
+      if (n < 2)
+        return 0;
+      return directed ? n * (n - 1) : n / 2 * (n - 1) + n % 2 * ((n - 1) / 2);
+    }
+
+    // Returns the kth vertex pair. Directed pairs are ordered by source and
+    // then target. Undirected pair k = i(i - 1)/2 + j, for j < i, is (j, i).
+    inline edge_pair
+    pair_at(std::size_t k, std::size_t n, bool directed)
+    {
+      if (directed) {
+        std::size_t u = k / (n - 1);
+        std::size_t v = k % (n - 1);
+        return {u, v < u ? v : v + 1};
+      }
+      std::size_t i = (1 + std::sqrt(1 + 8 * (double)k)) / 2;
+      while (i * (i - 1) / 2 > k)
+        --i;
+      while ((i + 1) * i / 2 <= k)
+        ++i;
+      return {k - i * (i - 1) / 2, i};
+    }
+
+    // Generate the blocks of gen in windows of blocks, calling make(b, x) in
+    // parallel to fill the buffer x of block b, and then emit(x) for each
+    // block in order.
+    template<typename Gen, typename T, typename Make, typename Emit>
+      void
+      pipeline(const Gen& gen, Make make, Emit emit, std::size_t threads)
+      {
+        std::size_t n = gen.blocks();
+        std::size_t w = window * (threads ? threads : concurrency());
+        std::vector<T> buf(std::min(n, w));
+        for (std::size_t first = 0; first < n; first += w) {
+          std::size_t last = std::min(n, first + w);
+          parallel_blocks(last - first, [&](std::size_t, std::size_t i, std::size_t j) {
+            for (; i != j; ++i) {
+              buf[i].clear();
+              make(first + i, buf[i]);
+            }
+          }, threads, 1);
+          for (std::size_t b = first; b != last; ++b)
+            emit(buf[b - first]);
+        }
+      }
+
+    // Append the decimal digits of x to s.
+    inline void
+    append_number(std::string& s, std::size_t x)
+    {
+      char d[20];
+      int n = 0;
+      do {
+        d[n++] = '0' + x % 10;
+        x /= 10;
+      } while (x);
+      while (n)
+        s += d[--n];
+    }
+
+  } // namespace generator_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                          R-MAT and Kronecker
+  //
+  // The R-MAT generator places each of the edge_factor * 2^scale edges in
+  // the adjacency matrix of 2^scale vertices by recursively choosing one of
+  // its four quadrants with probabilities a, b, c, and 1 - a - b - c, once
+  // for each bit of the endpoints. The result is a directed multigraph with
+  // loops and a skewed degree distribution.
+  //
+  // If scramble is true, vertex labels are permuted by a bijection on
+  // [0, 2^scale) derived from the seed, so that degree is not correlated
+  // with label. The kronecker generator is the Graph 500 configuration:
+  // a = 0.57, b = c = 0.19, with scrambled labels.
+  //
+  // Each edge is drawn from its own stream, so that edge i is the same
+  // however the edges are blocked.
+  class rmat_generator
+  {
+  public:
+    rmat_generator(std::size_t scale, std::size_t edge_factor,
+                   double a, double b, double c,
+                   std::uint64_t seed, bool scramble = false);
+
+    std::size_t order() const { return std::size_t(1) << scale_; }
+    std::size_t size() const { return edge_factor_ << scale_; }
+    std::size_t blocks() const;
+
+    void generate(std::size_t b, std::vector<edge_pair>& out) const;
+
+    // Returns the label of the vertex v.
+    std::size_t label(std::size_t v) const;
+
+  private:
+    std::size_t scale_;
+    std::size_t edge_factor_;
+    double a_, ab_, abc_;   // Cumulative quadrant probabilities
+    std::uint64_t seed_;
+    bool scramble_;
+    std::uint64_t mul1_, mul2_, add_;
+  };
+
+  inline
+  rmat_generator::rmat_generator(std::size_t scale, std::size_t edge_factor,
+                                 double a, double b, double c,
+                                 std::uint64_t seed, bool scramble)
+    : scale_(scale), edge_factor_(edge_factor),
+      a_(a), ab_(a + b), abc_(a + b + c),
+      seed_(seed), scramble_(scramble)
+  {
+    assert(scale < 64);
+    assert(a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1);
+    mul1_ = counter_rng::mix(seed ^ 0x51) | 1;
+    mul2_ = counter_rng::mix(seed ^ 0x52) | 1;
+    add_ = counter_rng::mix(seed ^ 0x53);
+  }
+
+  inline std::size_t
+  rmat_generator::blocks() const
+  {
+    return generator_impl::ceil_div(size(), generator_impl::block_size);
+  }
+
+  inline void
+  rmat_generator::generate(std::size_t b, std::vector<edge_pair>& out) const
+  {
+    std::size_t first = b * generator_impl::block_size;
+    std::size_t last = std::min(size(), first + generator_impl::block_size);
+    for (std::size_t i = first; i != last; ++i) {
+      counter_rng rng(seed_, i);
+      std::size_t u = 0, v = 0;
+      for (std::size_t k = 0; k < scale_; ++k) {
+        double x = rng.uniform();
+        u <<= 1;
+        v <<= 1;
+        if (x >= abc_)
+          u |= 1, v |= 1;
+        else if (x >= ab_)
+          u |= 1;
+        else if (x >= a_)
+          v |= 1;
+      }
+      out.emplace_back(label(u), label(v));
+    }
+  }
+
+  // The permutation alternates multiplication by odd constants, addition,
+  // and xor with a right shift, each of which is a bijection modulo 2^scale.
+  inline std::size_t
+  rmat_generator::label(std::size_t v) const
+  {
+    if (!scramble_ || scale_ == 0)
+      return v;
+    std::uint64_t mask = (std::uint64_t(1) << scale_) - 1;
+    std::size_t shift = (scale_ + 1) / 2;
+    std::uint64_t x = v;
+    x = (x * mul1_ + add_) & mask;
+    x ^= x >> shift;
+    x = (x * mul2_) & mask;
+    x ^= x >> shift;
+    x = (x * mul1_ + add_) & mask;
+    return x;
+  }
+
+  // Returns the Graph 500 Kronecker generator.
+  inline rmat_generator
+  kronecker_generator(std::size_t scale, std::size_t edge_factor,
+                      std::uint64_t seed)
+  {
+    return rmat_generator(scale, edge_factor, 0.57, 0.19, 0.19, seed, true);
+  }
+
+
+  // ------------------------------------------------------------------------ //
+  //                              Erdos-Renyi
+  //
+  // The G(n, p) generator includes each possible edge independently with
+  // probability p. The possible edges are the ordered pairs of distinct
+  // vertices if directed is true, and the unordered pairs otherwise, where
+  // each undirected edge is generated once, as (u, v) with u < v. The pairs
+  // are split into ranges of consecutive pairs, each expected to contain
+  // about one block of edges, and each range is sampled by skipping over
+  // geometrically distributed gaps, in time proportional to its edges.
+  class gnp_generator
+  {
+  public:
+    gnp_generator(std::size_t n, double p, std::uint64_t seed,
+                  bool directed = false);
+
+    std::size_t order() const { return n_; }
+    std::size_t blocks() const;
+
+    void generate(std::size_t b, std::vector<edge_pair>& out) const;
+
+  private:
+    std::size_t n_;
+    double p_;
+    std::uint64_t seed_;
+    bool directed_;
+    std::size_t pairs_;
+    std::size_t span_;   // The number of pairs per block
+  };
+
+  inline
+  gnp_generator::gnp_generator(std::size_t n, double p, std::uint64_t seed,
+                               bool directed)
+    : n_(n), p_(p), seed_(seed), directed_(directed),
+      pairs_(generator_impl::pair_count(n, directed))
+  {
+    assert(p >= 0 && p <= 1);
+    double span = p > 0 ? generator_impl::block_size / p : pairs_;
+    span_ = span >= pairs_ ? pairs_ : std::size_t(span);
+    span_ = std::max(span_, generator_impl::block_size);
+  }
+
+  inline std::size_t
+  gnp_generator::blocks() const
+  {
+    return p_ > 0 ? generator_impl::ceil_div(pairs_, span_) : 0;
+  }
+
+  inline void
+  gnp_generator::generate(std::size_t b, std::vector<edge_pair>& out) const
+  {
+    std::size_t first = b * span_;
+    std::size_t last = std::min(pairs_, first + span_);
+    if (p_ == 1) {
+      for (std::size_t k = first; k != last; ++k)
+        out.push_back(generator_impl::pair_at(k, n_, directed_));
+      return;
+    }
+    counter_rng rng(seed_, b);
+    double q = std::log1p(-p_);
+    std::size_t k = first;
+    while (true) {
+      // The number of pairs skipped before the next edge.
+      double skip = std::floor(std::log1p(-rng.uniform()) / q);
+      if (skip >= double(last - k))
+        break;
+      k += std::size_t(skip);
+      out.push_back(generator_impl::pair_at(k, n_, directed_));
+      ++k;
+    }
+  }
+
+
+  // The G(n, m) generator chooses m distinct edges among the possible edges
+  // of G(n, p). To generate in parallel, the pairs are split into blocks of
+  // equal ranges, and m is split as evenly as possible among them; each
+  // block chooses its share of edges uniformly from its range. Apart from
+  // this stratification, which fixes the number of edges in each range, the
+  // edges are uniformly distributed.
+  class gnm_generator
+  {
+  public:
+    gnm_generator(std::size_t n, std::size_t m, std::uint64_t seed,
+                  bool directed = false);
+
+    std::size_t order() const { return n_; }
+    std::size_t size() const { return m_; }
+    std::size_t blocks() const { return blocks_; }
+
+    void generate(std::size_t b, std::vector<edge_pair>& out) const;
+
+  private:
+    std::size_t n_;
+    std::size_t m_;
+    std::uint64_t seed_;
+    bool directed_;
+    std::size_t pairs_;
+    std::size_t blocks_;
+  };
+
+  inline
+  gnm_generator::gnm_generator(std::size_t n, std::size_t m,
+                               std::uint64_t seed, bool directed)
+    : n_(n), m_(m), seed_(seed), directed_(directed),
+      pairs_(generator_impl::pair_count(n, directed))
+  {
+    assert(m <= pairs_);
+    blocks_ = generator_impl::ceil_div(m, generator_impl::block_size);
+  }
+
+  inline void
+  gnm_generator::generate(std::size_t b, std::vector<edge_pair>& out) const
+  {
+    // Block b has the pairs [first, last), and chooses k of them.
+    std::size_t q = pairs_ / blocks_, r = pairs_ % blocks_;
+    std::size_t first = b * q + std::min(b, r);
+    std::size_t span = q + (b < r);
+    std::size_t k = m_ / blocks_ + (b < m_ % blocks_);
+    assert(k <= span);
+    counter_rng rng(seed_, b);
+    std::vector<std::size_t> x;
+    if (2 * k <= span) {
+      // Draw until k distinct pairs are chosen.
+      while (x.size() < k) {
+        std::size_t n = x.size();
+        for (std::size_t i = n; i < k; ++i)
+          x.push_back(rng.below(span));
+        std::sort(x.begin(), x.end());
+        x.erase(std::unique(x.begin(), x.end()), x.end());
+      }
+    } else {
+      // Select each pair with probability (needed / remaining).
+      std::size_t need = k;
+      for (std::size_t i = 0; i < span && need; ++i)
+        if (rng.below(span - i) < need) {
+          x.push_back(i);
+          --need;
+        }
+    }
+    for (std::size_t i : x)
+      out.push_back(generator_impl::pair_at(first + i, n_, directed_));
+  }
+
+
+  // ------------------------------------------------------------------------ //
+  //                                 Grids
+  //
+  // The grid generator connects the vertices of an x by y by z lattice to
+  // their successors along each dimension of length greater than 1; vertex
+  // (i, j, k) is numbered (k * y + j) * x + i. If torus is true, the last
+  // vertex of each dimension of length greater than 2 is also connected to
+  // the first. Each edge is generated once, from the lesser coordinate, or
+  // from the last vertex for wrapping edges. A 2D grid has z = 1.
+  class grid_generator
+  {
+  public:
+    grid_generator(std::size_t x, std::size_t y, std::size_t z = 1,
+                   bool torus = false);
+
+    std::size_t order() const { return x_ * y_ * z_; }
+    std::size_t size() const;
+    std::size_t blocks() const;
+
+    void generate(std::size_t b, std::vector<edge_pair>& out) const;
+
+  private:
+    std::size_t x_, y_, z_;
+    bool torus_;
+  };
+
+  inline
+  grid_generator::grid_generator(std::size_t x, std::size_t y, std::size_t z,
+                                 bool torus)
+    : x_(x), y_(y), z_(z), torus_(torus)
+  { }
+
+  inline std::size_t
+  grid_generator::size() const
+  {
+    std::size_t n = order();
+    std::size_t r = 0;
+    for (std::size_t d : {x_, y_, z_})
+      if (d > 1)
+        r += n / d * (torus_ && d > 2 ? d : d - 1);
+    return r;
+  }
+
+  inline std::size_t
+  grid_generator::blocks() const
+  {
+    return generator_impl::ceil_div(order(), generator_impl::block_size);
+  }
+
+  inline void
+  grid_generator::generate(std::size_t b, std::vector<edge_pair>& out) const
+  {
+    std::size_t first = b * generator_impl::block_size;
+    std::size_t last = std::min(order(), first + generator_impl::block_size);
+    std::size_t plane = x_ * y_;
+    for (std::size_t v = first; v != last; ++v) {
+      std::size_t i = v % x_, j = v / x_ % y_, k = v / plane;
+      if (i + 1 < x_)
+        out.emplace_back(v, v + 1);
+      else if (torus_ && x_ > 2)
+        out.emplace_back(v, v - i);
+      if (j + 1 < y_)
+        out.emplace_back(v, v + x_);
+      else if (torus_ && y_ > 2)
+        out.emplace_back(v, v - j * x_);
+      if (k + 1 < z_)
+        out.emplace_back(v, v + plane);
+      else if (torus_ && z_ > 2)
+        out.emplace_back(v, v - k * plane);
+    }
+  }
+
+
+  // ------------------------------------------------------------------------ //
+  //                        Preferential Attachment
+  //
+  // The preferential attachment generator implements the Barabasi-Albert
+  // model: vertices are added in order, and each adds d edges to earlier (or
+  // the same) vertices chosen with probability proportional to their degree.
+  //
+  // Following Batagelj and Brandes, the endpoints of the edges form a
+  // sequence in which edge i contributes its source, i / d, at position 2i
+  // and its target at position 2i + 1. The target is a copy of the endpoint
+  // at a position chosen uniformly from [0, 2i + 1), which is a vertex drawn
+  // in proportion to its degree. As in the parallel algorithm of Sanders and
+  // Schulz, the position chosen for position p is drawn from stream p, so a
+  // target that copies another target is recomputed rather than looked up,
+  // and every edge can be generated independently. The result is a
+  // multigraph with loops, whose edges are directed from newer vertices.
+  class preferential_attachment_generator
+  {
+  public:
+    preferential_attachment_generator(std::size_t n, std::size_t d,
+                                      std::uint64_t seed);
+
+    std::size_t order() const { return n_; }
+    std::size_t size() const { return n_ * d_; }
+    std::size_t blocks() const;
+
+    void generate(std::size_t b, std::vector<edge_pair>& out) const;
+
+    // Returns the vertex at position p of the endpoint sequence.
+    std::size_t endpoint(std::size_t p) const;
+
+  private:
+    std::size_t n_;
+    std::size_t d_;
+    std::uint64_t seed_;
+  };
+
+  inline
+  preferential_attachment_generator::
+    preferential_attachment_generator(std::size_t n, std::size_t d,
+                                      std::uint64_t seed)
+    : n_(n), d_(d), seed_(seed)
+  {
+    assert(d > 0);
+  }
+
+  inline std::size_t
+  preferential_attachment_generator::blocks() const
+  {
+    return generator_impl::ceil_div(size(), generator_impl::block_size);
+  }
+
+  inline std::size_t
+  preferential_attachment_generator::endpoint(std::size_t p) const
+  {
+    // Each odd position copies an earlier one; the chain ends at an even
+    // position, a source. The expected length of the chain is O(1).
+    while (p % 2) {
+      counter_rng rng(seed_, p);
+      p = rng.below(p);
+    }
+    return p / 2 / d_;
+  }
+
+  inline void
+  preferential_attachment_generator::
+    generate(std::size_t b, std::vector<edge_pair>& out) const
+  {
+    std::size_t first = b * generator_impl::block_size;
+    std::size_t last = std::min(size(), first + generator_impl::block_size);
+    for (std::size_t i = first; i != last; ++i)
+      out.emplace_back(i / d_, endpoint(2 * i + 1));
+  }
+
+
+  // ------------------------------------------------------------------------ //
+  //                            Edge Streams
+
+  // Returns the edges of gen, in order.
+  template<typename Gen>
+    std::vector<edge_pair>
+    generate_edges(const Gen& gen, std::size_t threads = 0)
+    {
+      std::vector<edge_pair> r;
+      generator_impl::pipeline<Gen, std::vector<edge_pair>>(gen,
+        [&gen](std::size_t b, std::vector<edge_pair>& x) { gen.generate(b, x); },
+        [&r](const std::vector<edge_pair>& x) {
+          r.insert(r.end(), x.begin(), x.end());
+        },
+        threads);
+      return r;
+    }
+
+  // Call sink(first, last) for the edges [first, last) of each block of
+  // gen, in order. The sink is called on this thread.
+  template<typename Gen, typename Sink>
+    void
+    stream_edges(const Gen& gen, Sink sink, std::size_t threads = 0)
+    {
+      generator_impl::pipeline<Gen, std::vector<edge_pair>>(gen,
+        [&gen](std::size_t b, std::vector<edge_pair>& x) { gen.generate(b, x); },
+        [&sink](const std::vector<edge_pair>& x) {
+          sink(x.data(), x.data() + x.size());
+        },
+        threads);
+    }
+
+  // Write the edges of gen to os as an edge file: one edge "u v" per line.
+  // Blocks are formatted in parallel.
+  template<typename Gen>
+    void
+    write_edges(const Gen& gen, std::ostream& os, std::size_t threads = 0)
+    {
+      generator_impl::pipeline<Gen, std::string>(gen,
+        [&gen](std::size_t b, std::string& s) {
+          std::vector<edge_pair> x;
+          gen.generate(b, x);
+          s.reserve(x.size() * 16);
+          for (const edge_pair& e : x) {
+            generator_impl::append_number(s, e.first);
+            s += ' ';
+            generator_impl::append_number(s, e.second);
+            s += '\n';
+          }
+        },
+        [&os](const std::string& s) { os.write(s.data(), s.size()); },
+        threads);
+    }
+
+  // Read the edges of an edge file. Lines that are empty or start with '#'
+  // are ignored. Returns false if a line is not an edge.
+  inline bool
+  read_edges(std::istream& is, std::vector<edge_pair>& edges)
+  {
+    std::string line;
+    while (std::getline(is, line)) {
+      if (line.empty() || line[0] == '#')
+        continue;
+      const char* p = line.c_str();
+      char* end;
+      std::size_t u = std::strtoull(p, &end, 10);
+      if (end == p)
+        return false;
+      p = end;
+      std::size_t v = std::strtoull(p, &end, 10);
+      if (end == p)
+        return false;
+      edges.emplace_back(u, v);
+    }
+    return true;
+  }
+
+  // Returns a graph of type G with the vertices and edges of gen.
+  template<typename G, typename Gen>
+    G
+    generate_graph(const Gen& gen, std::size_t threads = 0)
+    {
+      G g;
+      for (std::size_t i = 0; i < gen.order(); ++i)
+        g.add_vertex();
+      stream_edges(gen, [&g](const edge_pair* first, const edge_pair* last) {
+        for (; first != last; ++first)
+          g.add_edge(first->first, first->second);
+      }, threads);
+      return g;
+    }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,202 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/generator.hpp>
+
+using namespace std;
+using namespace origin;
+
+// The edges of gen do not depend on the number of threads, and every
+// endpoint is a vertex.
+template<typename Gen>
+  vector<edge_pair>
+  check_stream(const Gen& gen)
+  {
+    vector<edge_pair> a = generate_edges(gen, 1);
+    vector<edge_pair> b = generate_edges(gen, 4);
+    assert(a == b);
+    for (auto& e : a)
+      assert(e.first < gen.order() && e.second < gen.order());
+
+    // The sink receives the same edges, in order.
+    vector<edge_pair> c;
+    stream_edges(gen, [&c](const edge_pair* first, const edge_pair* last) {
+      c.insert(c.end(), first, last);
+    }, 3);
+    assert(a == c);
+    return a;
+  }
+
+void
+check_pairs()
+{
+  cout << "*** pairs ***\n";
+  for (size_t n : {2, 3, 7, 10}) {
+    for (bool directed : {false, true}) {
+      size_t m = generator_impl::pair_count(n, directed);
+      assert(m == (directed ? n * (n - 1) : n * (n - 1) / 2));
+      set<edge_pair> s;
+      for (size_t k = 0; k < m; ++k) {
+        edge_pair p = generator_impl::pair_at(k, n, directed);
+        assert(p.first != p.second && p.first < n && p.second < n);
+        assert(directed || p.first < p.second);
+        s.insert(p);
+      }
+      assert(s.size() == m);
+    }
+  }
+}
+
+void
+check_rmat()
+{
+  cout << "*** rmat ***\n";
+  rmat_generator g(10, 8, 0.45, 0.15, 0.15, 7);
+  vector<edge_pair> e = check_stream(g);
+  assert(e.size() == g.size() && g.size() == 8 << 10);
+  assert(e != generate_edges(rmat_generator(10, 8, 0.45, 0.15, 0.15, 8)));
+
+  // Without scrambling, vertex 0 has the greatest degree.
+  vector<size_t> deg(g.order());
+  for (auto& x : e)
+    ++deg[x.first];
+  assert(max_element(deg.begin(), deg.end()) == deg.begin());
+
+  // Scrambling permutes the vertices.
+  rmat_generator k = kronecker_generator(10, 8, 7);
+  set<size_t> labels;
+  for (size_t v = 0; v < k.order(); ++v)
+    labels.insert(k.label(v));
+  assert(labels.size() == k.order() && *labels.rbegin() == k.order() - 1);
+  check_stream(k);
+
+  // Several blocks.
+  rmat_generator big(14, 16, 0.57, 0.19, 0.19, 1);
+  assert(big.blocks() == 4);
+  assert(check_stream(big).size() == big.size());
+}
+
+void
+check_erdos_renyi()
+{
+  cout << "*** erdos_renyi ***\n";
+  // The expected number of edges is 0.01 * 2000 * 1999 / 2 = 19990, and the
+  // standard deviation is about 140.
+  gnp_generator g(2000, 0.01, 3);
+  vector<edge_pair> e = check_stream(g);
+  assert(e.size() > 19000 && e.size() < 21000);
+  set<edge_pair> s(e.begin(), e.end());
+  assert(s.size() == e.size());
+  for (auto& x : e)
+    assert(x.first < x.second);
+
+  // Directed pairs, across many blocks.
+  gnp_generator d(30000, 0.001, 3, true);
+  assert(d.blocks() > 1);
+  e = check_stream(d);
+  assert(e.size() > 880000 && e.size() < 920000);
+
+  // The extreme probabilities.
+  assert(generate_edges(gnp_generator(50, 0, 1)).empty());
+  assert(generate_edges(gnp_generator(50, 1, 1)).size() == 50 * 49 / 2);
+  assert(generate_edges(gnp_generator(50, 1, 1, true)).size() == 50 * 49);
+
+  // G(n, m) has exactly m distinct edges, whether sparse or dense.
+  for (size_t m : {0, 1000, 100000, 190000, 199000}) {
+    gnm_generator h(633, m, 5);
+    e = check_stream(h);
+    s = set<edge_pair>(e.begin(), e.end());
+    assert(e.size() == m && s.size() == m);
+  }
+  gnm_generator all(10, 90, 5, true);
+  assert(generate_edges(all).size() == 90);
+}
+
+void
+check_grid()
+{
+  cout << "*** grid ***\n";
+  grid_generator g(4, 3);
+  vector<edge_pair> e = check_stream(g);
+  assert(g.order() == 12 && e.size() == g.size() && e.size() == 3 * 3 + 4 * 2);
+
+  // In a torus, every vertex has degree 2 per dimension longer than 2.
+  grid_generator t(5, 4, 3, true);
+  e = check_stream(t);
+  assert(e.size() == t.size() && e.size() == 60 * 3);
+  vector<size_t> deg(t.order());
+  for (auto& x : e) {
+    ++deg[x.first];
+    ++deg[x.second];
+  }
+  for (size_t d : deg)
+    assert(d == 6);
+
+  // Dimensions of length 2 are not wrapped, and those of length 1 have no
+  // edges.
+  grid_generator u(2, 1, 300, true);
+  assert(check_stream(u).size() == u.size() && u.size() == 300 + 2 * 300);
+  assert(u.blocks() == 1);
+}
+
+void
+check_preferential()
+{
+  cout << "*** preferential ***\n";
+  preferential_attachment_generator g(100000, 4, 11);
+  vector<edge_pair> e = check_stream(g);
+  assert(e.size() == 400000 && g.blocks() == 7);
+  vector<size_t> deg(g.order());
+  for (size_t i = 0; i < e.size(); ++i) {
+    assert(e[i].first == i / 4 && e[i].second <= e[i].first);
+    ++deg[e[i].first];
+    ++deg[e[i].second];
+  }
+
+  // Early vertices collect far more edges than the average degree of 8.
+  assert(*max_element(deg.begin(), deg.end()) > 200);
+}
+
+void
+check_output()
+{
+  cout << "*** output ***\n";
+  rmat_generator g = kronecker_generator(12, 16, 2);
+  stringstream ss;
+  write_edges(g, ss, 4);
+  vector<edge_pair> e;
+  assert(read_edges(ss, e));
+  assert(e == generate_edges(g));
+
+  stringstream bad("# comment\n\n1 2\n3\n");
+  e.clear();
+  assert(!read_edges(bad, e) && e.size() == 1);
+
+  using G = directed_adjacency_vector<>;
+  grid_generator grid(10, 10);
+  G h = generate_graph<G>(grid, 2);
+  assert(h.order() == 100 && h.size() == grid.size());
+  assert(h.out_degree(0) == 2 && h.in_degree(99) == 2);
+  assert(h(0, 1) && h(0, 10) && !h(0, 11));
+}
+
+int main()
+{
+  check_pairs();
+  check_rmat();
+  check_erdos_renyi();
+  check_grid();
+  check_preferential();
+  check_output();
+}
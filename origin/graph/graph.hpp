@@ -30,6 +30,20 @@ namespace origin
     inline auto
     edges(const G& g) -> decltype(g.edges()) { return g.edges(); }
 
+  // Returns one more than the greatest vertex handle in g, or 0 if g has no
+  // vertices. Arrays of this size can be indexed by the vertex handles of
+  // graphs whose removed vertices leave holes in the handle space.
+  template<typename G>
+    inline std::size_t
+    vertex_bound(const G& g)
+    {
+      std::size_t n = 0;
+      for (auto v : g.vertices())
+        if (std::size_t(v) + 1 > n)
+          n = std::size_t(v) + 1;
+      return n;
+    }
+
   // Returns the source vertex of an edge in g.
   template<typename G>
     inline Vertex<G>
@@ -194,6 +208,54 @@ namespace origin
       Vertex<G> v;
     };
 
+
+  // ------------------------------------------------------------------------ //
+  //                                                               [graph.value]
+  //                              Value Maps
+  //
+  // A value map is a function object that maps a vertex or edge of a graph
+  // to a value. The following maps return the user data stored with the
+  // vertex or edge. Algorithms that require weights, capacities, or other
+  // edge properties use edge_value<G> as the default.
+  //
+  //    vertex_value<G>
+  //    edge_value<G>
+  //
+
+  // Returns the user data stored with a vertex.
+  template<typename G>
+    struct vertex_value
+    {
+      vertex_value(const G& g)
+        : g(g)
+      { }
+
+      inline auto
+      operator()(Vertex<G> v) const -> decltype(std::declval<const G&>()(v))
+      {
+        return g(v);
+      }
+
+      const G& g;
+    };
+
+  // Returns the user data stored with an edge.
+  template<typename G>
+    struct edge_value
+    {
+      edge_value(const G& g)
+        : g(g)
+      { }
+
+      inline auto
+      operator()(Edge<G> e) const -> decltype(std::declval<const G&>()(e))
+      {
+        return g(e);
+      }
+
+      const G& g;
+    };
+
 } // namespace origin
 
 
@@ -0,0 +1,15 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <origin/graph/adjacency_list.hpp>
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv)
+{
+  return benchmark::run<origin::directed_adjacency_list<>>("adjacency_list", argc, argv);
+}
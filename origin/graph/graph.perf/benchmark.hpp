@@ -0,0 +1,238 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef GRAPH_PERF_BENCHMARK_HPP
+#define GRAPH_PERF_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <origin/graph/generator.hpp>
+#include <origin/graph/random.hpp>
+#include <origin/graph/traversal.hpp>
+
+namespace benchmark
+{
+  using namespace std;
+  using namespace origin;
+
+  // -------------------------------------------------------------------------- //
+  //                              Graph Benchmarks
+  //
+  // The suite measures a directed graph type on each input graph:
+  //
+  //    build     add the vertices and then the edges, one at a time
+  //    lookup    find edges g(u, v), half of which exist
+  //    bfs       breadth-first search from a vertex of greatest out degree
+  //    churn     apply batches that each remove and add 1/16 of the edges
+  //    iterate   visit every out edge, after churn
+  //
+  // The inputs are generated for each size from the uniform G(n, m) model
+  // and the skewed Kronecker model, with an average out degree of 8, and
+  // from a 2D torus, with out degree 2. Every repetition rebuilds the graph.
+  //
+  // Each program writes one CSV row per benchmark and input to stdout:
+  //
+  //    implementation,benchmark,distribution,vertices,edges,operations,
+  //    best_seconds,mean_seconds,ns_per_operation
+  //
+  // where ns_per_operation is derived from the best time.
+  //
+  // The programs take the number of repetitions and, optionally, the log2 of
+  // the largest graph, which is 16 by default. Sizes start at 2^12 and grow
+  // by factors of 16.
+
+  using clock_type = chrono::steady_clock;
+
+  // The times of one benchmark over all repetitions.
+  struct timing
+  {
+    void add(clock_type::duration d)
+    {
+      double s = chrono::duration<double>(d).count();
+      best = times.empty() ? s : min(best, s);
+      times.push_back(s);
+    }
+
+    double mean() const
+    {
+      double s = 0;
+      for (double t : times)
+        s += t;
+      return s / times.size();
+    }
+
+    double best;
+    vector<double> times;
+  };
+
+  // An input graph, with the queries and batches run against it.
+  struct input
+  {
+    string distribution;
+    size_t order;
+    vector<edge_pair> edges;
+    size_t source;
+    vector<edge_pair> queries;
+    vector<vector<edge_pair>> deletions;
+    vector<vector<edge_pair>> insertions;
+  };
+
+  // Generate the queries and churn batches of x.
+  inline void
+  prepare(input& x)
+  {
+    vector<size_t> degree(x.order);
+    for (const edge_pair& e : x.edges)
+      ++degree[e.first];
+    x.source = max_element(degree.begin(), degree.end()) - degree.begin();
+
+    counter_rng rng(x.order, 1);
+    size_t m = x.edges.size();
+    size_t q = min<size_t>(m, 1 << 16);
+    for (size_t i = 0; i < q; ++i) {
+      if (i % 2)
+        x.queries.push_back(x.edges[rng.below(m)]);
+      else
+        x.queries.emplace_back(rng.below(x.order), rng.below(x.order));
+    }
+    size_t b = m / 16;
+    for (int r = 0; r < 8; ++r) {
+      vector<edge_pair> del, ins;
+      for (size_t i = 0; i < b; ++i) {
+        del.push_back(x.edges[rng.below(m)]);
+        ins.emplace_back(rng.below(x.order), rng.below(x.order));
+      }
+      x.deletions.push_back(move(del));
+      x.insertions.push_back(move(ins));
+    }
+  }
+
+  template<typename Gen>
+    input
+    make_input(const string& dist, const Gen& gen)
+    {
+      input x;
+      x.distribution = dist;
+      x.order = gen.order();
+      x.edges = generate_edges(gen);
+      prepare(x);
+      return x;
+    }
+
+  inline void
+  report(const string& impl, const string& bench, const input& x,
+         size_t ops, const timing& t)
+  {
+    cout << impl << ',' << bench << ',' << x.distribution << ','
+         << x.order << ',' << x.edges.size() << ',' << ops << ','
+         << t.best << ',' << t.mean() << ',' << t.best * 1e9 / ops << '\n';
+  }
+
+  template<typename G>
+    void
+    run_input(const string& impl, const input& x, int repeat)
+    {
+      using Ins = typename G::edge_insertion;
+      using Del = typename G::edge_deletion;
+      timing build, lookup, bfs, churn, iterate;
+      size_t found = 0, visited = 0, sum = 0, churn_ops = 0, edges = 0;
+      for (int r = 0; r < repeat; ++r) {
+        auto t0 = clock_type::now();
+        G g;
+        for (size_t i = 0; i < x.order; ++i)
+          g.add_vertex();
+        for (const edge_pair& e : x.edges)
+          g.add_edge(e.first, e.second);
+        auto t1 = clock_type::now();
+        build.add(t1 - t0);
+
+        found = 0;
+        t0 = clock_type::now();
+        for (const edge_pair& e : x.queries)
+          if (g(e.first, e.second))
+            ++found;
+        lookup.add(clock_type::now() - t0);
+
+        visited = 0;
+        t0 = clock_type::now();
+        for (auto v : bfs_range(g, x.source)) {
+          (void)v;
+          ++visited;
+        }
+        bfs.add(clock_type::now() - t0);
+
+        // The batches are converted before timing.
+        vector<vector<Ins>> ins(x.insertions.size());
+        vector<vector<Del>> del(x.deletions.size());
+        churn_ops = 0;
+        for (size_t i = 0; i < ins.size(); ++i) {
+          for (const edge_pair& e : x.insertions[i])
+            ins[i].emplace_back(e.first, e.second, empty_t());
+          for (const edge_pair& e : x.deletions[i])
+            del[i].emplace_back(e.first, e.second);
+          churn_ops += ins[i].size() + del[i].size();
+        }
+        t0 = clock_type::now();
+        for (size_t i = 0; i < ins.size(); ++i)
+          g.apply_batch(ins[i], del[i], 1);
+        churn.add(clock_type::now() - t0);
+
+        sum = 0;
+        edges = 0;
+        t0 = clock_type::now();
+        for (auto v : g.vertices())
+          for (auto e : g.out_edges(v)) {
+            sum += g.target(e);
+            ++edges;
+          }
+        iterate.add(clock_type::now() - t0);
+      }
+
+      report(impl, "build", x, x.order + x.edges.size(), build);
+      report(impl, "lookup", x, x.queries.size(), lookup);
+      report(impl, "bfs", x, visited, bfs);
+      report(impl, "churn", x, churn_ops, churn);
+      report(impl, "iterate", x, edges, iterate);
+
+      // Keep the results observable.
+      if (found > x.queries.size() || sum == size_t(-1))
+        cerr << "unexpected result\n";
+    }
+
+  // Run the suite for the graph type G, named impl, with the command line
+  // arguments of the program.
+  template<typename G>
+    int
+    run(const string& impl, int argc, char** argv)
+    {
+      int repeat = argc > 1 ? atoi(argv[1]) : 1;
+      size_t max_scale = argc > 2 ? atoi(argv[2]) : 16;
+      if (repeat < 1 || max_scale < 4 || max_scale > 30) {
+        cerr << "usage: " << argv[0] << " [repeat [max_scale]]\n";
+        return 1;
+      }
+
+      cout << "implementation,benchmark,distribution,vertices,edges,"
+           << "operations,best_seconds,mean_seconds,ns_per_operation\n";
+      for (size_t scale = 12; scale <= max_scale; scale += 4) {
+        size_t n = size_t(1) << scale;
+        size_t side = size_t(1) << (scale / 2);
+        run_input<G>(impl, make_input("uniform", gnm_generator(n, 8 * n, scale, true)), repeat);
+        run_input<G>(impl, make_input("kronecker", kronecker_generator(scale, 8, scale)), repeat);
+        run_input<G>(impl, make_input("torus", grid_generator(side, side, 1, true)), repeat);
+      }
+      return 0;
+    }
+
+} // namespace benchmark
+
+#endif
@@ -8,8 +8,13 @@
 #ifndef GRAPH_TEST_TESTING_HPP
 #define GRAPH_TEST_TESTING_HPP
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <iostream>
+#include <random>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <origin/graph/graph.hpp>
@@ -84,6 +89,71 @@ namespace testing
       return g;
     }
 
+  // Returns edge values drawn uniformly from [first, last), for random_graph.
+  struct uniform_values
+  {
+    uniform_values(int first, int last) : first(first), last(last) { }
+
+    int operator()(minstd_rand& prng, size_t, size_t) const
+    {
+      return first + int(prng() % (last - first));
+    }
+
+    int first, last;
+  };
+
+  // Construct a random graph with n vertices and m edges, whose endpoints are
+  // drawn uniformly by a generator seeded with seed, so that loops and
+  // parallel edges are likely. The value of the edge (u, v) is given by
+  // value(prng, u, v), which may draw from the same generator.
+  template<typename G, typename F>
+    G random_graph(size_t n, size_t m, unsigned seed, F value)
+    {
+      minstd_rand prng(seed);
+      G g;
+      for (size_t i = 0; i < n; ++i)
+        g.add_vertex();
+      for (size_t i = 0; i < m; ++i) {
+        size_t u = prng() % n;
+        size_t v = prng() % n;
+        g.add_edge(u, v, value(prng, u, v));
+      }
+      return g;
+    }
+
+  // Construct a random graph as above, with default edge values.
+  template<typename G>
+    G random_graph(size_t n, size_t m, unsigned seed)
+    {
+      minstd_rand prng(seed);
+      G g;
+      for (size_t i = 0; i < n; ++i)
+        g.add_vertex();
+      for (size_t i = 0; i < m; ++i) {
+        size_t u = prng() % n;
+        size_t v = prng() % n;
+        g.add_edge(u, v);
+      }
+      return g;
+    }
+
+  // Construct a random bipartite graph with l left vertices (the first l) and
+  // r right vertices, and m edges between them.
+  template<typename G>
+    G random_bipartite_graph(size_t l, size_t r, size_t m, unsigned seed)
+    {
+      minstd_rand prng(seed);
+      G g;
+      for (size_t i = 0; i < l + r; ++i)
+        g.add_vertex();
+      for (size_t i = 0; i < m; ++i) {
+        size_t u = prng() % l;
+        size_t v = l + prng() % r;
+        g.add_edge(u, v);
+      }
+      return g;
+    }
+
 
   // -------------------------------------------------------------------------- //
   //                              Testing Functions
@@ -332,6 +402,103 @@ namespace testing
       assert(g.empty());
     }
 
+
+
+  // -------------------------------------------------------------------------- //
+  //                              Edge Batches
+  //
+  // A batch model records the out list of each vertex as a sequence of target
+  // and value pairs, against which apply_batch is checked.
+
+  using batch_model = vector<vector<pair<size_t, int>>>;
+
+  // Apply a batch to the model: each deletion removes the first edge with
+  // its endpoints, and then the insertions are appended.
+  template<typename Ins, typename Del>
+    void
+    apply_batch_model(batch_model& m, const Ins& ins, const Del& del)
+    {
+      for (auto& d : del) {
+        auto& l = m[d.first];
+        for (auto i = l.begin(); i != l.end(); ++i)
+          if (i->first == size_t(d.second)) {
+            l.erase(i);
+            break;
+          }
+      }
+      for (auto& x : ins)
+        m[get<0>(x)].emplace_back(get<1>(x), get<2>(x));
+    }
+
+  // Check that g has the out lists of m, in order, and consistent in lists.
+  template<typename G>
+    void
+    check_batch_model(const G& g, const batch_model& m)
+    {
+      assert(g.order() == m.size());
+      size_t n = 0;
+      batch_model in(m.size());
+      for (size_t u = 0; u < m.size(); ++u) {
+        vector<pair<size_t, int>> out;
+        for (auto e : g.out_edges(u)) {
+          assert(size_t(g.source(e)) == u);
+          out.emplace_back(g.target(e), g(e));
+        }
+        assert(out == m[u]);
+        n += out.size();
+        for (auto& x : m[u])
+          in[x.first].emplace_back(u, x.second);
+      }
+      assert(g.size() == n);
+      for (size_t v = 0; v < m.size(); ++v) {
+        vector<pair<size_t, int>> x;
+        for (auto e : g.in_edges(v)) {
+          assert(size_t(g.target(e)) == v);
+          x.emplace_back(g.source(e), g(e));
+        }
+        sort(x.begin(), x.end());
+        sort(in[v].begin(), in[v].end());
+        assert(x == in[v]);
+      }
+    }
+
+  // Apply random batches to a directed graph with integer edge values, and
+  // check each result against the model.
+  template<typename G>
+    void
+    check_random_batches(size_t threads)
+    {
+      using Ins = typename G::edge_insertion;
+      using Del = typename G::edge_deletion;
+      minstd_rand prng(threads);
+      size_t n = 3000;
+      G g;
+      batch_model m(n);
+      for (size_t i = 0; i < n; ++i)
+        g.add_vertex();
+      int value = 0;
+      vector<Ins> ins;
+      for (int round = 0; round < 10; ++round) {
+        // Delete some of the edges inserted by the previous batch, some
+        // twice, and edges that may not exist.
+        vector<Del> del;
+        for (auto& x : ins) {
+          if (prng() % 2)
+            del.emplace_back(get<0>(x), get<1>(x));
+          if (prng() % 10 == 0)
+            del.emplace_back(get<0>(x), get<1>(x));
+        }
+        for (int i = 0; i < 1000; ++i)
+          del.emplace_back(prng() % n, prng() % n);
+        ins.clear();
+        for (int i = 0; i < 5000; ++i)
+          ins.emplace_back(prng() % n, prng() % (i % 2 ? n : 30), value++);
+        g.apply_batch(ins, del, threads);
+        apply_batch_model(m, ins, del);
+        check_batch_model(g, m);
+      }
+    }
+
 } // namespace testing
 
 #endif
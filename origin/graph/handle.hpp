@@ -10,6 +10,8 @@
 
 #include <cstdint>
 #include <functional>
+#include <tuple>
+#include <type_traits>
 
 namespace origin 
 {
@@ -19,63 +21,87 @@ namespace origin
   //
   // A handle is an ordinal value type used to represent an object in a data
   // structure. Handles are implicitly interoperable with unsigned intger
-  // (size_t) values, and have the special property that unsigned -1 indicates
-  // an invalid object.
+  // values of their index type T, and have the special property that T(-1)
+  // indicates an invalid object.
+  //
+  // The index type determines the size of a handle, and so the size of the
+  // adjacency structures that store them. Graphs with fewer than 2^32 - 1
+  // vertices and edges can use 32 bit handles (see uint32_vertex_handle), which
+  // halves the memory needed for their topology. Vertex (or edge) handles of
+  // different index types convert to each other, preserving invalid handles.
   //
   // TODO: Disable arithmetic operations?
-  class handle
-  {
-  public:
-    static constexpr std::size_t npos = -1;
-
-    handle(std::size_t n = npos);
-
-    // Boolean
-    explicit operator bool() const;
-
-    // Integral
-    operator std::size_t() const { return value; }
-    
-    // Hashable
-    std::size_t hash() const;
-    
-    std::size_t value;
-  };
-  
-  inline
-  handle::handle(std::size_t n) : value(n) { }
-
-  inline 
-  handle::operator bool() const { return value != npos; }
-  
-  inline std::size_t 
-  handle::hash() const { return std::hash<std::size_t>{}(value); }
+  template<typename T>
+    class basic_handle
+    {
+      static_assert(std::is_unsigned<T>::value, "");
+    public:
+      using index_type = T;
+
+      static constexpr T npos = -1;
+
+      basic_handle(T n = npos);
+
+      // Boolean
+      explicit operator bool() const;
+
+      // Integral
+      operator T() const { return value; }
+
+      // Hashable
+      std::size_t hash() const;
+
+      T value;
+    };
+
+  template<typename T>
+    constexpr T basic_handle<T>::npos;
+
+  template<typename T>
+    inline
+    basic_handle<T>::basic_handle(T n) : value(n) { }
+
+  template<typename T>
+    inline
+    basic_handle<T>::operator bool() const { return value != npos; }
+
+  template<typename T>
+    inline std::size_t
+    basic_handle<T>::hash() const { return std::hash<T>{}(value); }
 
   // Equality
-  inline bool 
-  operator==(handle a, handle b) { return a.value == b.value; }
-  
-  inline bool 
-  operator!=(handle a, handle b) { return !(a == b); }
+  template<typename T>
+    inline bool
+    operator==(basic_handle<T> a, basic_handle<T> b) { return a.value == b.value; }
+
+  template<typename T>
+    inline bool
+    operator!=(basic_handle<T> a, basic_handle<T> b) { return !(a == b); }
 
   // Ordering
-  inline bool 
-  operator<(handle a, handle b)
-  { 
-    if (!a)
-      return bool(b);
-    else 
-      return b ? a.value < b.value : false; 
-  }
-    
-  inline bool 
-  operator>(handle a, handle b) { return b < a; }
-  
-  inline bool 
-  operator<=(handle a, handle b) { return !(b < a); }
-  
-  inline bool 
-  operator>=(handle a, handle b) { return !(a < b); }
+  template<typename T>
+    inline bool
+    operator<(basic_handle<T> a, basic_handle<T> b)
+    {
+      if (!a)
+        return bool(b);
+      else
+        return b ? a.value < b.value : false;
+    }
+
+  template<typename T>
+    inline bool
+    operator>(basic_handle<T> a, basic_handle<T> b) { return b < a; }
+
+  template<typename T>
+    inline bool
+    operator<=(basic_handle<T> a, basic_handle<T> b) { return !(b < a); }
+
+  template<typename T>
+    inline bool
+    operator>=(basic_handle<T> a, basic_handle<T> b) { return !(a < b); }
+
+  using handle = basic_handle<std::size_t>;
 
 
   // ------------------------------------------------------------------------ //
@@ -83,10 +109,18 @@ namespace origin
   //
   // A vertex handle is a handle specifically for graph vertices. It is
   // the same as a normal handle in every way except its type.
-  struct vertex_handle : handle
-  {
-    using handle::handle;
-  };
+  template<typename T>
+    struct basic_vertex_handle : basic_handle<T>
+    {
+      using basic_handle<T>::basic_handle;
+
+      template<typename U>
+        basic_vertex_handle(basic_vertex_handle<U> v)
+          : basic_handle<T>(v ? T(v.value) : basic_handle<T>::npos)
+        { }
+    };
+
+  using vertex_handle = basic_vertex_handle<std::size_t>;
 
 
   // ------------------------------------------------------------------------ //
@@ -97,10 +131,26 @@ namespace origin
   // data structures. More frequently, edge handles are source/target pairs
   // or source/target/edge triples. See simple_edge_handle and multi_edge_handle
   // for details.
-  struct edge_handle : handle
-  {
-    using handle::handle;
-  };
+  template<typename T>
+    struct basic_edge_handle : basic_handle<T>
+    {
+      using basic_handle<T>::basic_handle;
+
+      template<typename U>
+        basic_edge_handle(basic_edge_handle<U> e)
+          : basic_handle<T>(e ? T(e.value) : basic_handle<T>::npos)
+        { }
+    };
+
+  using edge_handle = basic_edge_handle<std::size_t>;
+
+
+  // ------------------------------------------------------------------------ //
+  //                            32 Bit Handles
+  //
+  // The handle types of graphs that use 32 bit indexes.
+  using uint32_vertex_handle = basic_vertex_handle<std::uint32_t>;
+  using uint32_edge_handle = basic_edge_handle<std::uint32_t>;
 
 
   // ------------------------------------------------------------------------ //
@@ -202,11 +252,11 @@ namespace origin
 // Natively support the standard hashing protocol for vertex handles.
 namespace std 
 {
-  template<>
-    struct hash<origin::vertex_handle>
+  template<typename T>
+    struct hash<origin::basic_vertex_handle<T>>
     {
-      std::size_t 
-      operator()(origin::vertex_handle x) const { return x.hash(); }
+      std::size_t
+      operator()(origin::basic_vertex_handle<T> x) const { return x.hash(); }
     };
 
   template<typename E>
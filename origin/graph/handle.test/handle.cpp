@@ -91,4 +91,16 @@ int main()
 
   // FIXME: This should not work.
   assert(v == e);
+
+  check_eq<uint32_vertex_handle>();
+  check_ord<uint32_vertex_handle>();
+  check_interop<uint32_vertex_handle>();
+  check_conv<uint32_vertex_handle>();
+
+  // Conversions between widths preserve invalid handles.
+  uint32_vertex_handle w = vertex_handle(7);
+  assert(w == uint32_vertex_handle(7));
+  assert(!uint32_vertex_handle(vertex_handle()));
+  assert(!vertex_handle(uint32_vertex_handle()));
+  assert(vertex_handle(w) == vertex_handle(7));
 }
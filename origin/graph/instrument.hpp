@@ -0,0 +1,262 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_INSTRUMENT_HPP
+#define ORIGIN_GRAPH_INSTRUMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                          [graph.instrument]
+  //                            Instrumentation
+  //
+  // When ORIGIN_GRAPH_INSTRUMENT is defined (see the CMake option of the
+  // same name), the graph containers count the following events:
+  //
+  //    add_edge      edges added, one at a time or in batches
+  //    remove_edge   edges removed by remove_edge, or by batches
+  //    search        searches of an incidence list, by find_edge, the edge
+  //                  relation g(u, v), and the unlink functions that remove
+  //                  edges
+  //    probe         the incidence list elements examined by those searches
+  //    pool_append   pool insertions that append a node
+  //    pool_reuse    pool insertions that reuse the index of an erased node
+  //    reallocation  insertions that grow a full vector: an incidence list,
+  //                  or the vector of vertices, edges, or pool nodes
+  //
+  // The longest search, and the vertex whose incidence list it examined,
+  // are also recorded.
+  //
+  // Each thread counts into its own counters, without synchronization, and
+  // graph_counters() sums the counters of all threads on demand, including
+  // those that have exited. When ORIGIN_GRAPH_INSTRUMENT is not defined the
+  // hooks in the containers expand to nothing, and the counters stay 0.
+  enum class graph_event : std::size_t
+  {
+    add_edge,
+    remove_edge,
+    search,
+    probe,
+    pool_append,
+    pool_reuse,
+    reallocation
+  };
+
+  // The number of kinds of events.
+  constexpr std::size_t graph_events = 7;
+
+  // The totals of the counters of all threads.
+  struct graph_event_counts
+  {
+    std::uint64_t operator[](graph_event e) const
+    {
+      return count[static_cast<std::size_t>(e)];
+    }
+
+    std::uint64_t count[graph_events];
+    std::size_t longest_search;        // The probes of the longest search
+    std::size_t longest_search_vertex; // The vertex of the longest search
+  };
+
+
+  namespace instrument_impl
+  {
+    // The counters of one thread, which only that thread increments. The
+    // counters are atomic so that other threads can read them; increments
+    // are relaxed loads and stores, not read-modify-write operations.
+    struct thread_counters
+    {
+      thread_counters();
+      ~thread_counters();
+
+      void add(std::size_t i, std::uint64_t n)
+      {
+        auto& c = count[i];
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+      }
+
+      std::atomic<std::uint64_t> count[graph_events];
+      std::atomic<std::size_t> longest;
+      std::atomic<std::size_t> longest_vertex;
+    };
+
+    // The registry of the counters of the running threads, and the totals
+    // of the threads that have exited. It is never destroyed, so threads
+    // may exit after the end of main.
+    struct registry
+    {
+      registry() : retired() { }
+
+      std::mutex lock;
+      std::vector<thread_counters*> threads;
+      graph_event_counts retired;
+    };
+
+    inline registry&
+    get_registry()
+    {
+      static registry* r = new registry();
+      return *r;
+    }
+
+    // Add the counters of t to r.
+    inline void
+    accumulate(graph_event_counts& r, const thread_counters& t)
+    {
+      for (std::size_t i = 0; i < graph_events; ++i)
+        r.count[i] += t.count[i].load(std::memory_order_relaxed);
+      std::size_t n = t.longest.load(std::memory_order_relaxed);
+      if (n > r.longest_search) {
+        r.longest_search = n;
+        r.longest_search_vertex = t.longest_vertex.load(std::memory_order_relaxed);
+      }
+    }
+
+    inline
+    thread_counters::thread_counters()
+      : longest(0), longest_vertex(0)
+    {
+      for (auto& c : count)
+        c.store(0, std::memory_order_relaxed);
+      registry& r = get_registry();
+      std::lock_guard<std::mutex> g(r.lock);
+      r.threads.push_back(this);
+    }
+
+    inline
+    thread_counters::~thread_counters()
+    {
+      registry& r = get_registry();
+      std::lock_guard<std::mutex> g(r.lock);
+      accumulate(r.retired, *this);
+      for (auto& p : r.threads)
+        if (p == this) {
+          p = r.threads.back();
+          r.threads.pop_back();
+          break;
+        }
+    }
+
+    // Returns the counters of this thread.
+    inline thread_counters&
+    local()
+    {
+      thread_local thread_counters c;
+      return c;
+    }
+
+    inline void
+    count(graph_event e, std::uint64_t n = 1)
+    {
+      local().add(static_cast<std::size_t>(e), n);
+    }
+
+    // Record a search of the incidence list of v that examined n elements.
+    inline void
+    search(std::size_t v, std::size_t n)
+    {
+      thread_counters& t = local();
+      t.add(static_cast<std::size_t>(graph_event::search), 1);
+      t.add(static_cast<std::size_t>(graph_event::probe), n);
+      if (n > t.longest.load(std::memory_order_relaxed)) {
+        t.longest.store(n, std::memory_order_relaxed);
+        t.longest_vertex.store(v, std::memory_order_relaxed);
+      }
+    }
+
+    // Returns the number of elements of seq examined by a linear search that
+    // stopped at i.
+    template<typename S, typename I>
+      inline std::size_t
+      probes(S& seq, I i)
+      {
+        I first = std::begin(seq);
+        I last = std::end(seq);
+        std::size_t n = std::distance(first, i);
+        return i == last ? n : n + 1;
+      }
+
+    // Record an insertion into v, which reallocates if v is full.
+    template<typename C>
+      inline void
+      growth(const C& v)
+      {
+        if (v.size() == v.capacity())
+          count(graph_event::reallocation);
+      }
+
+  } // namespace instrument_impl
+
+
+  // Returns the sums of the event counters of all threads. Counts made
+  // concurrently with the call may or may not be included.
+  inline graph_event_counts
+  graph_counters()
+  {
+    using namespace instrument_impl;
+    registry& r = get_registry();
+    std::lock_guard<std::mutex> g(r.lock);
+    graph_event_counts x = r.retired;
+    for (const thread_counters* t : r.threads)
+      accumulate(x, *t);
+    return x;
+  }
+
+  // Set the event counters of all threads to 0. Counts made concurrently
+  // with the call may be lost or kept.
+  inline void
+  reset_graph_counters()
+  {
+    using namespace instrument_impl;
+    registry& r = get_registry();
+    std::lock_guard<std::mutex> g(r.lock);
+    r.retired = graph_event_counts();
+    for (thread_counters* t : r.threads) {
+      for (auto& c : t->count)
+        c.store(0, std::memory_order_relaxed);
+      t->longest.store(0, std::memory_order_relaxed);
+      t->longest_vertex.store(0, std::memory_order_relaxed);
+    }
+  }
+
+} // namespace origin
+
+
+// The hooks used by the graph containers. Each is a statement.
+//
+//    ORIGIN_GRAPH_COUNT(e, n)     count n events of kind graph_event::e
+//    ORIGIN_GRAPH_SEARCH(v, n)    a search of v's incidence list probed n
+//                                 elements
+//    ORIGIN_GRAPH_GROWTH(x)       an element is about to be appended to the
+//                                 vector x
+//
+// The arguments are not evaluated unless ORIGIN_GRAPH_INSTRUMENT is defined;
+// otherwise they only appear in sizeof, so that variables computed for the
+// hooks are not reported as unused.
+#ifdef ORIGIN_GRAPH_INSTRUMENT
+#  define ORIGIN_GRAPH_COUNT(e, n) \
+     ::origin::instrument_impl::count(::origin::graph_event::e, (n))
+#  define ORIGIN_GRAPH_SEARCH(v, n) \
+     ::origin::instrument_impl::search((v), (n))
+#  define ORIGIN_GRAPH_GROWTH(x) \
+     ::origin::instrument_impl::growth(x)
+#else
+#  define ORIGIN_GRAPH_COUNT(e, n) \
+     ((void)sizeof(::origin::graph_event::e, (n)))
+#  define ORIGIN_GRAPH_SEARCH(v, n) ((void)sizeof((v), (n)))
+#  define ORIGIN_GRAPH_GROWTH(x) ((void)sizeof(x))
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+
+#include <origin/graph/adjacency_list.hpp>
+#include <origin/graph/adjacency_vector.hpp>
+
+using namespace std;
+using namespace origin;
+
+void
+check_edges()
+{
+  cout << "*** edges ***\n";
+  reset_graph_counters();
+  using G = directed_adjacency_list<>;
+  G g;
+  for (int i = 0; i < 4; ++i)
+    g.add_vertex();
+  for (int i = 0; i < 100; ++i)
+    g.add_edge(0, 1);
+  g.add_edge(0, 2);
+  for (int i = 0; i < 200; ++i)
+    g.add_edge(3, 2);
+  graph_event_counts c = graph_counters();
+  assert(c[graph_event::add_edge] == 301);
+  assert(c[graph_event::pool_append] == 4 + 301);
+  assert(c[graph_event::pool_reuse] == 0);
+  assert(c[graph_event::search] == 0);
+  assert(c[graph_event::reallocation] > 0);
+  assert(c[graph_event::reallocation] < 301);
+
+  // The out list of 0 is shorter than the in list of 2, and is searched to
+  // its last element.
+  reset_graph_counters();
+  assert(g(0, 2));
+  c = graph_counters();
+  assert(c[graph_event::search] == 1 && c[graph_event::probe] == 101);
+  assert(c.longest_search == 101 && c.longest_search_vertex == 0);
+
+  // Removing an edge searches both of its incidence lists, and a later
+  // insertion reuses its index.
+  reset_graph_counters();
+  g.remove_edge(G::edge(100));
+  c = graph_counters();
+  assert(c[graph_event::remove_edge] == 1 && c[graph_event::search] == 2);
+  assert(c[graph_event::probe] == 101 + 1);
+  g.add_edge(1, 0);
+  c = graph_counters();
+  assert(c[graph_event::pool_reuse] == 1);
+  assert(c[graph_event::pool_append] == 0);
+
+  // A failed search examines the whole list, here the empty in list of 3.
+  reset_graph_counters();
+  assert(!g(1, 3));
+  c = graph_counters();
+  assert(c[graph_event::search] == 1 && c[graph_event::probe] == 0);
+}
+
+void
+check_undirected()
+{
+  cout << "*** undirected ***\n";
+  reset_graph_counters();
+  using G = undirected_adjacency_list<>;
+  G g;
+  for (int i = 0; i < 3; ++i)
+    g.add_vertex();
+  for (int i = 0; i < 10; ++i)
+    g.add_edge(0, 1);
+  g.add_edge(1, 1);
+  g.remove_edge(0, 1);
+  g.remove_edge(1, 1);
+  g.remove_edge(0, 2);
+  graph_event_counts c = graph_counters();
+  assert(c[graph_event::add_edge] == 11);
+  assert(c[graph_event::remove_edge] == 2);
+  assert(c[graph_event::search] > 0);
+
+  using U = undirected_adjacency_vector<>;
+  reset_graph_counters();
+  U u;
+  for (int i = 0; i < 3; ++i)
+    u.add_vertex();
+  u.add_edge(0, 1);
+  u.add_edge(1, 2);
+  assert(u(2, 1) && !u(0, 2));
+  c = graph_counters();
+  assert(c[graph_event::add_edge] == 2);
+  assert(c[graph_event::search] == 2);
+  assert(c[graph_event::pool_append] == 0);
+}
+
+void
+check_vector()
+{
+  cout << "*** vector ***\n";
+  reset_graph_counters();
+  using G = directed_adjacency_vector<empty_t, int>;
+  G g;
+  for (int i = 0; i < 10; ++i)
+    g.add_vertex();
+  for (int i = 0; i < 50; ++i)
+    g.add_edge(i % 10, (i + 1) % 10, i);
+  g.apply_batch({G::edge_insertion(0, 9, 50), G::edge_insertion(1, 9, 51)},
+                {{0, 1}, {5, 5}});
+  graph_event_counts c = graph_counters();
+  assert(c[graph_event::add_edge] == 52);
+  assert(c[graph_event::remove_edge] == 1);
+  assert(c[graph_event::reallocation] > 0);
+}
+
+void
+check_threads()
+{
+  cout << "*** threads ***\n";
+  reset_graph_counters();
+
+  // Each thread counts its own events, which are kept after it exits.
+  vector<thread> ts;
+  for (int t = 0; t < 4; ++t)
+    ts.emplace_back([] {
+      directed_adjacency_vector<> g;
+      g.add_vertex();
+      g.add_vertex();
+      for (int i = 0; i < 1000; ++i)
+        g.add_edge(0, 1);
+    });
+  for (auto& t : ts)
+    t.join();
+  graph_event_counts c = graph_counters();
+  assert(c[graph_event::add_edge] == 4000);
+
+  reset_graph_counters();
+  c = graph_counters();
+  for (size_t i = 0; i < graph_events; ++i)
+    assert(c.count[i] == 0);
+  assert(c.longest_search == 0);
+}
+
+int main()
+{
+  check_edges();
+  check_undirected();
+  check_vector();
+  check_threads();
+}
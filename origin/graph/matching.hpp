@@ -0,0 +1,239 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_MATCHING_HPP
+#define ORIGIN_GRAPH_MATCHING_HPP
+
+#include <cassert>
+
+#include <vector>
+
+#include <origin/graph/graph.hpp>
+
+namespace origin
+{
+  namespace matching_impl
+  {
+    // ---------------------------------------------------------------------- //
+    //                           Hopcroft-Karp
+    //
+    // The Hopcroft-Karp state holds a compact copy of the bipartite graph,
+    // in which the neighbors of the ith left vertex are the right vertices
+    // adj[first[i]] through adj[first[i + 1] - 1], and the mate and distance
+    // arrays, which are indexed by vertex handle.
+    //
+    // Each phase computes the distance of each left vertex from the free left
+    // vertices along alternating paths by breadth-first search, and then
+    // finds a maximal set of vertex-disjoint shortest augmenting paths by
+    // depth-first search. The search is iterative, and each left vertex has
+    // a current arc so that no edge is examined twice in a phase.
+    template<typename G>
+      class hopcroft_karp
+      {
+        static constexpr std::size_t none = -1;
+      public:
+        template<typename P>
+          hopcroft_karp(const G& g, P left);
+
+        std::vector<Vertex<G>> run();
+
+      private:
+        void greedy();
+        bool search();
+        bool augment(std::size_t u);
+
+      private:
+        std::size_t n;
+        std::vector<std::size_t> left;    // The left vertices
+        std::vector<std::size_t> index;   // The position of each left vertex
+        std::vector<std::size_t> first;   // Offsets of adjacent right vertices
+        std::vector<std::size_t> adj;     // Right vertices adjacent to left
+        std::vector<std::size_t> mate;    // The mate of each vertex, or none
+        std::vector<std::size_t> dist;    // The layer of each left vertex
+        std::vector<std::size_t> current; // The current arc of each left vertex
+        std::size_t limit;                // The layer of the nearest free right
+
+        std::vector<std::size_t> queue;
+        std::vector<std::size_t> stack;
+      };
+
+    template<typename G>
+      constexpr std::size_t hopcroft_karp<G>::none;
+
+    // Edges whose endpoints are on the same side of the partition, including
+    // loops, cannot be matched and are ignored.
+    template<typename G>
+      template<typename P>
+        hopcroft_karp<G>::hopcroft_karp(const G& g, P is_left)
+          : n(g.order()), index(n, none), mate(n, none), dist(n, none),
+            current(n, 0)
+        {
+          first.push_back(0);
+          for (auto v : g.vertices()) {
+            if (!is_left(v))
+              continue;
+            left.push_back(v);
+            for (auto e : g.edges(v)) {
+              Vertex<G> w = opposite(g, e, v);
+              if (!is_left(w))
+                adj.push_back(w);
+            }
+            index[v] = left.size() - 1;
+            first.push_back(adj.size());
+          }
+        }
+
+    template<typename G>
+      std::vector<Vertex<G>>
+      hopcroft_karp<G>::run()
+      {
+        greedy();
+        while (search()) {
+          for (std::size_t u : left)
+            if (mate[u] == none && dist[u] == 0)
+              augment(u);
+        }
+        return std::vector<Vertex<G>>(mate.begin(), mate.end());
+      }
+
+    // Match each left vertex to its first free neighbor, if any. This
+    // usually matches most vertices before the first phase.
+    template<typename G>
+      void
+      hopcroft_karp<G>::greedy()
+      {
+        for (std::size_t i = 0; i < left.size(); ++i) {
+          std::size_t u = left[i];
+          for (std::size_t j = first[i]; j < first[i + 1]; ++j) {
+            std::size_t w = adj[j];
+            if (mate[w] == none) {
+              mate[u] = w;
+              mate[w] = u;
+              break;
+            }
+          }
+        }
+      }
+
+    // Compute the layer of each left vertex by breadth-first search from the
+    // free left vertices, and reset the current arcs. Returns true if an
+    // augmenting path exists, in which case limit is the layer of the free
+    // right vertices nearest a free left vertex.
+    template<typename G>
+      bool
+      hopcroft_karp<G>::search()
+      {
+        queue.clear();
+        for (std::size_t u : left) {
+          current[u] = first[index[u]];
+          if (mate[u] == none) {
+            dist[u] = 0;
+            queue.push_back(u);
+          } else {
+            dist[u] = none;
+          }
+        }
+
+        limit = none;
+        for (std::size_t k = 0; k < queue.size(); ++k) {
+          std::size_t u = queue[k];
+          if (dist[u] >= limit)
+            break;
+          std::size_t i = index[u];
+          for (std::size_t j = first[i]; j < first[i + 1]; ++j) {
+            std::size_t x = mate[adj[j]];
+            if (x == none) {
+              if (limit == none)
+                limit = dist[u] + 1;
+            } else if (dist[x] == none) {
+              dist[x] = dist[u] + 1;
+              queue.push_back(x);
+            }
+          }
+        }
+        return limit != none;
+      }
+
+    // Search for a shortest augmenting path from the free left vertex u, and
+    // flip the matching along it. Each left vertex on the stack is in a
+    // different layer, and its current arc points at the right vertex through
+    // which the search continued. Vertices from which no augmenting path can
+    // be found and vertices on an augmenting path are removed from the layered
+    // graph, so the paths found in a phase are vertex-disjoint.
+    template<typename G>
+      bool
+      hopcroft_karp<G>::augment(std::size_t u)
+      {
+        stack.assign(1, u);
+        while (!stack.empty()) {
+          u = stack.back();
+          std::size_t& j = current[u];
+          if (j == first[index[u] + 1]) {
+            dist[u] = none;
+            stack.pop_back();
+            if (!stack.empty())
+              ++current[stack.back()];
+            continue;
+          }
+
+          std::size_t w = adj[j];
+          std::size_t x = mate[w];
+          if (x == none) {
+            if (dist[u] + 1 == limit) {
+              for (std::size_t a : stack) {
+                std::size_t b = adj[current[a]];
+                mate[a] = b;
+                mate[b] = a;
+                dist[a] = none;
+              }
+              return true;
+            }
+          } else if (dist[x] == dist[u] + 1) {
+            stack.push_back(x);
+            continue;
+          }
+          ++j;
+        }
+        return false;
+      }
+
+  } // namespace matching_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                                                            [graph.matching]
+  //                          Bipartite Matching
+  //
+  // Compute a maximum cardinality matching in the bipartite graph g using the
+  // Hopcroft-Karp algorithm. The bipartition is given either by a predicate
+  // that returns true for the vertices on the left side, or by a vector of
+  // bools indexed by vertex handle. The result maps each vertex to its mate,
+  // or to an invalid vertex handle if it is unmatched.
+  //
+  //    hopcroft_karp_matching(g, left)
+  //
+  // The algorithm runs in O(m sqrt(n)) time, and requires the vertex handles
+  // of g to be the integers in [0, g.order()).
+  template<typename G, typename P>
+    std::vector<Vertex<G>>
+    hopcroft_karp_matching(const G& g, P left)
+    {
+      matching_impl::hopcroft_karp<G> alg(g, left);
+      return alg.run();
+    }
+
+  template<typename G>
+    inline std::vector<Vertex<G>>
+    hopcroft_karp_matching(const G& g, const std::vector<bool>& left)
+    {
+      assert(left.size() == g.order());
+      return hopcroft_karp_matching(g, [&left](Vertex<G> v) { return left[v]; });
+    }
+
+} // namespace origin
+
+#endif
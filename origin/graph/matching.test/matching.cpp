@@ -0,0 +1,126 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/matching.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using G = undirected_adjacency_vector<>;
+
+// Check that mate describes a matching in g, and return its size.
+size_t
+check_matching(const G& g, const vector<Vertex<G>>& mate)
+{
+  assert(mate.size() == g.order());
+  size_t n = 0;
+  for (auto v : g.vertices()) {
+    if (!mate[v])
+      continue;
+    Vertex<G> w = mate[v];
+    assert(mate[w] == v);
+    assert(g(v, w));
+    ++n;
+  }
+  return n / 2;
+}
+
+// Returns true if there is an augmenting path from the left vertex u,
+// flipping the matching along it.
+bool
+kuhn(const G& g, Vertex<G> u, vector<Vertex<G>>& mate, vector<bool>& seen)
+{
+  for (auto e : g.edges(u)) {
+    Vertex<G> w = opposite(g, e, u);
+    if (seen[w])
+      continue;
+    seen[w] = true;
+    if (!mate[w] || kuhn(g, mate[w], mate, seen)) {
+      mate[u] = w;
+      mate[w] = u;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Compute the size of a maximum matching by repeated augmentation.
+size_t
+simple_matching(const G& g, size_t l)
+{
+  vector<Vertex<G>> mate(g.order());
+  size_t n = 0;
+  for (size_t u = 0; u < l; ++u) {
+    vector<bool> seen(g.order(), false);
+    if (kuhn(g, u, mate, seen))
+      ++n;
+  }
+  return n;
+}
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // Greedy matching takes 0-3 and 1-4, and the algorithm must augment along
+  // 2-3-0-4-1-5 to match every vertex.
+  G g;
+  for (int i = 0; i < 6; ++i)
+    g.add_vertex();
+  g.add_edge(0, 3);
+  g.add_edge(0, 4);
+  g.add_edge(1, 4);
+  g.add_edge(1, 5);
+  g.add_edge(2, 3);
+  g.add_edge(2, 2);
+
+  vector<bool> left {true, true, true, false, false, false};
+  auto mate = hopcroft_karp_matching(g, left);
+  assert(check_matching(g, mate) == 3);
+  assert(mate[2] == Vertex<G>(3));
+  assert(mate[0] == Vertex<G>(4));
+  assert(mate[1] == Vertex<G>(5));
+}
+
+void
+check_random()
+{
+  cout << "*** random ***\n";
+  for (unsigned seed = 1; seed <= 50; ++seed) {
+    size_t l = 50 + seed, r = 80 - seed;
+    G g = random_bipartite_graph<G>(l, r, 2 * (l + r), seed);
+    auto mate = hopcroft_karp_matching(g, [l](Vertex<G> v) { return size_t(v) < l; });
+    assert(check_matching(g, mate) == simple_matching(g, l));
+  }
+}
+
+void
+check_large()
+{
+  cout << "*** large ***\n";
+  // A perfect matching hidden under random edges.
+  size_t n = 100000;
+  G g = random_bipartite_graph<G>(n, n, n, 1);
+  for (size_t i = 0; i < n; ++i)
+    g.add_edge(i, n + (i * 7919) % n);
+  auto mate = hopcroft_karp_matching(g, [n](Vertex<G> v) { return size_t(v) < n; });
+  assert(check_matching(g, mate) == n);
+}
+
+int main()
+{
+  check_small();
+  check_random();
+  check_large();
+}
@@ -0,0 +1,610 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_MAX_FLOW_HPP
+#define ORIGIN_GRAPH_MAX_FLOW_HPP
+
+#include <cassert>
+
+#include <algorithm>
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+#include <origin/graph/graph.hpp>
+
+namespace origin
+{
+  // The capacity type of a capacity map C over the edges of G.
+  template<typename G, typename C>
+    using Capacity_type = typename std::decay<
+      decltype(std::declval<const C&>()(std::declval<Edge<G>>()))
+    >::type;
+
+
+  // The result of a maximum flow algorithm: the value of the flow, and the
+  // flow on each edge, indexed by edge handle.
+  template<typename T>
+    struct network_flow
+    {
+      T value;
+      std::vector<T> flow;
+    };
+
+  // The result of a minimum cut computation: the vertices on the source side
+  // of the cut, indexed by vertex handle, and the edges crossing the cut from
+  // the source side to the sink side.
+  template<typename G>
+    struct network_cut
+    {
+      std::vector<bool> source_side;
+      std::vector<Edge<G>> edges;
+    };
+
+
+  namespace max_flow_impl
+  {
+    // ---------------------------------------------------------------------- //
+    //                            Residual Network
+    //
+    // The residual network of a directed graph g has two arcs for each edge
+    // e = (u, v): a forward arc 2e from u to v whose residual capacity is
+    // initially the capacity of e, and a reverse arc 2e + 1 from v to u whose
+    // residual capacity is initially 0. The arcs a and a ^ 1 are paired, so
+    // no lookup structure is needed to find the reverse of an arc.
+    //
+    // The arcs leaving each vertex are stored contiguously: the arcs of v
+    // are arcs[first[v]] through arcs[first[v + 1] - 1]. These are the
+    // forward arcs of the out edges of v followed by the reverse arcs of the
+    // in edges of v.
+    template<typename G, typename T>
+      struct residual_network
+      {
+        template<typename C>
+          residual_network(const G& g, C cap);
+
+        std::size_t order() const { return first.size() - 1; }
+
+        // Returns the vertex at the head of arc a.
+        std::size_t head(std::size_t a) const { return to[a]; }
+
+        // Returns the flow on edge e.
+        T flow(std::size_t e) const { return res[2 * e + 1]; }
+
+        // Move d units of flow along arc a.
+        void push(std::size_t a, T d)
+        {
+          res[a] -= d;
+          res[a ^ 1] += d;
+        }
+
+        std::vector<std::size_t> first; // Offset of each vertex's arcs
+        std::vector<std::size_t> arcs;  // Arcs grouped by tail vertex
+        std::vector<std::size_t> to;    // Head vertex of each arc
+        std::vector<T> res;             // Residual capacity of each arc
+      };
+
+    template<typename G, typename T>
+      template<typename C>
+        residual_network<G, T>::residual_network(const G& g, C cap)
+          : first(g.order() + 1, 0), to(2 * g.size()), res(2 * g.size())
+        {
+          arcs.reserve(2 * g.size());
+          for (auto v : g.vertices()) {
+            first[v] = arcs.size();
+            for (auto e : g.out_edges(v))
+              arcs.push_back(2 * e);
+            for (auto e : g.in_edges(v))
+              arcs.push_back(2 * e + 1);
+          }
+          first[g.order()] = arcs.size();
+
+          for (auto e : g.edges()) {
+            to[2 * e] = g.target(e);
+            to[2 * e + 1] = g.source(e);
+            res[2 * e] = cap(e);
+            res[2 * e + 1] = T(0);
+          }
+        }
+
+    // Returns the flow found in the residual network r.
+    template<typename G, typename T>
+      network_flow<T>
+      make_flow(const residual_network<G, T>& r, T value)
+      {
+        std::size_t m = r.res.size() / 2;
+        network_flow<T> f {value, std::vector<T>(m)};
+        for (std::size_t e = 0; e < m; ++e)
+          f.flow[e] = r.flow(e);
+        return f;
+      }
+
+
+    // ---------------------------------------------------------------------- //
+    //                              Push-Relabel
+    //
+    // The push-relabel state holds the labels, excesses, and active vertices
+    // of the push-relabel algorithm. Labels are at most 2n - 1. A vertex is
+    // active if it has positive excess and is neither the source nor the
+    // sink.
+    template<typename G, typename T>
+      class push_relabel
+      {
+      public:
+        push_relabel(residual_network<G, T>& r, std::size_t s, std::size_t t,
+                     bool highest);
+
+        T run();
+
+      private:
+        bool active(std::size_t v) const;
+        void activate(std::size_t v);
+        std::size_t next_active();
+        void rebuild_active();
+
+        void discharge(std::size_t v);
+        void relabel(std::size_t v);
+        void gap(std::size_t k);
+        void global_relabel();
+
+      private:
+        residual_network<G, T>& net;
+        std::size_t n;
+        std::size_t source;
+        std::size_t sink;
+        bool highest; // Select highest label instead of FIFO
+
+        std::vector<T> excess;
+        std::vector<std::size_t> label;
+        std::vector<std::size_t> count;   // Number of vertices with each label
+        std::vector<std::size_t> current; // Current arc of each vertex
+
+        // Active vertices, either in label buckets or in a FIFO queue.
+        std::vector<std::vector<std::size_t>> buckets;
+        std::size_t top;
+        std::deque<std::size_t> queue;
+
+        std::size_t relabels; // Relabels since the last global relabeling
+      };
+
+    template<typename G, typename T>
+      push_relabel<G, T>::push_relabel(residual_network<G, T>& r,
+                                       std::size_t s, std::size_t t,
+                                       bool h)
+        : net(r), n(r.order()), source(s), sink(t), highest(h),
+          excess(n, T(0)), label(n, 0), count(2 * n + 1, 0), current(n),
+          buckets(highest ? 2 * n : 0), top(0), relabels(0)
+      { }
+
+    template<typename G, typename T>
+      T
+      push_relabel<G, T>::run()
+      {
+        // Saturate every arc leaving the source.
+        for (std::size_t i = net.first[source]; i < net.first[source + 1]; ++i) {
+          std::size_t a = net.arcs[i];
+          T d = net.res[a];
+          if (d > T(0)) {
+            net.push(a, d);
+            excess[net.head(a)] += d;
+            excess[source] -= d;
+          }
+        }
+
+        global_relabel();
+        for (std::size_t v = next_active(); v != n; v = next_active()) {
+          discharge(v);
+          if (relabels >= n) {
+            global_relabel();
+          }
+        }
+        return excess[sink];
+      }
+
+    template<typename G, typename T>
+      inline bool
+      push_relabel<G, T>::active(std::size_t v) const
+      {
+        return v != source && v != sink && excess[v] > T(0) && label[v] < 2 * n;
+      }
+
+    template<typename G, typename T>
+      inline void
+      push_relabel<G, T>::activate(std::size_t v)
+      {
+        if (highest) {
+          buckets[label[v]].push_back(v);
+          top = std::max(top, label[v]);
+        } else {
+          queue.push_back(v);
+        }
+      }
+
+    // Return the next active vertex to discharge, or n if there are none.
+    // Vertices whose labels changed after they were activated are found in
+    // the wrong bucket and skipped; they are always re-activated when their
+    // labels change.
+    template<typename G, typename T>
+      std::size_t
+      push_relabel<G, T>::next_active()
+      {
+        if (highest) {
+          while (true) {
+            while (buckets[top].empty()) {
+              if (top == 0)
+                return n;
+              --top;
+            }
+            std::size_t v = buckets[top].back();
+            buckets[top].pop_back();
+            if (active(v) && label[v] == top)
+              return v;
+          }
+        } else {
+          while (!queue.empty()) {
+            std::size_t v = queue.front();
+            queue.pop_front();
+            if (active(v))
+              return v;
+          }
+          return n;
+        }
+      }
+
+    // Re-activate every active vertex after labels have been recomputed.
+    template<typename G, typename T>
+      void
+      push_relabel<G, T>::rebuild_active()
+      {
+        if (highest) {
+          for (auto& b : buckets)
+            b.clear();
+          top = 0;
+        } else {
+          queue.clear();
+        }
+        for (std::size_t v = 0; v < n; ++v)
+          if (active(v))
+            activate(v);
+      }
+
+    // Push the excess of v along admissible arcs, relabeling v whenever it
+    // has no admissible arcs left.
+    template<typename G, typename T>
+      void
+      push_relabel<G, T>::discharge(std::size_t v)
+      {
+        std::size_t end = net.first[v + 1];
+        while (excess[v] > T(0)) {
+          if (current[v] == end) {
+            relabel(v);
+            if (label[v] >= 2 * n)
+              return;
+            continue;
+          }
+
+          std::size_t a = net.arcs[current[v]];
+          std::size_t w = net.head(a);
+          if (net.res[a] > T(0) && label[v] == label[w] + 1) {
+            T d = std::min(excess[v], net.res[a]);
+            bool was_idle = !(excess[w] > T(0));
+            net.push(a, d);
+            excess[v] -= d;
+            excess[w] += d;
+            if (was_idle && active(w))
+              activate(w);
+          } else {
+            ++current[v];
+          }
+        }
+      }
+
+    // Relabel v to one more than the least label of a vertex reachable by a
+    // residual arc. If v was the last vertex with its label, the label is a
+    // gap, and every vertex above it is cut off from the sink.
+    template<typename G, typename T>
+      void
+      push_relabel<G, T>::relabel(std::size_t v)
+      {
+        ++relabels;
+        std::size_t old = label[v];
+        std::size_t d = 2 * n;
+        for (std::size_t i = net.first[v]; i < net.first[v + 1]; ++i) {
+          std::size_t a = net.arcs[i];
+          if (net.res[a] > T(0))
+            d = std::min(d, label[net.head(a)] + 1);
+        }
+        --count[old];
+        label[v] = d;
+        ++count[d];
+        current[v] = net.first[v];
+        if (count[old] == 0 && old < n)
+          gap(old);
+      }
+
+    // Apply the gap heuristic: no vertex with a label above k (and below n)
+    // can reach the sink, so those vertices are lifted above n, from where
+    // they can only return their excess to the source.
+    template<typename G, typename T>
+      void
+      push_relabel<G, T>::gap(std::size_t k)
+      {
+        bool changed = false;
+        for (std::size_t v = 0; v < n; ++v) {
+          if (label[v] > k && label[v] < n) {
+            --count[label[v]];
+            label[v] = n + 1;
+            ++count[label[v]];
+            current[v] = net.first[v];
+            changed = true;
+          }
+        }
+        if (changed)
+          rebuild_active();
+      }
+
+    // Recompute exact labels: the distance to the sink in the residual
+    // network or, for vertices that cannot reach the sink, n plus the
+    // distance to the source.
+    template<typename G, typename T>
+      void
+      push_relabel<G, T>::global_relabel()
+      {
+        relabels = 0;
+        const std::size_t none = -1;
+        std::fill(label.begin(), label.end(), none);
+
+        // Search backwards from root, following arcs that have residual
+        // capacity towards the vertex being expanded.
+        std::vector<std::size_t> q;
+        auto search = [&](std::size_t root, std::size_t base) {
+          q.clear();
+          label[root] = base;
+          q.push_back(root);
+          for (std::size_t i = 0; i < q.size(); ++i) {
+            std::size_t v = q[i];
+            for (std::size_t j = net.first[v]; j < net.first[v + 1]; ++j) {
+              std::size_t a = net.arcs[j];
+              std::size_t w = net.head(a);
+              if (label[w] == none && net.res[a ^ 1] > T(0)) {
+                label[w] = label[v] + 1;
+                q.push_back(w);
+              }
+            }
+          }
+        };
+        search(sink, 0);
+        if (label[source] == none)
+          search(source, n);
+        else
+          label[source] = n;
+
+        std::fill(count.begin(), count.end(), 0);
+        for (std::size_t v = 0; v < n; ++v) {
+          if (label[v] == none || label[v] > 2 * n - 1)
+            label[v] = 2 * n - 1;
+          ++count[label[v]];
+          current[v] = net.first[v];
+        }
+        rebuild_active();
+      }
+
+
+    // ---------------------------------------------------------------------- //
+    //                                 Dinic
+    //
+    // Dinic's algorithm repeatedly builds a level graph by breadth-first
+    // search from the source and saturates it with a blocking flow. The
+    // blocking flow is found by an iterative depth-first search with current
+    // arc pointers.
+    template<typename G, typename T>
+      T
+      dinic(residual_network<G, T>& net, std::size_t s, std::size_t t)
+      {
+        std::size_t n = net.order();
+        const std::size_t none = -1;
+        std::vector<std::size_t> level(n);
+        std::vector<std::size_t> current(n);
+        std::vector<std::size_t> path;
+        std::vector<std::size_t> q;
+        T value = T(0);
+
+        while (true) {
+          // Build the level graph.
+          std::fill(level.begin(), level.end(), none);
+          level[s] = 0;
+          q.assign(1, s);
+          for (std::size_t i = 0; i < q.size(); ++i) {
+            std::size_t v = q[i];
+            for (std::size_t j = net.first[v]; j < net.first[v + 1]; ++j) {
+              std::size_t a = net.arcs[j];
+              std::size_t w = net.head(a);
+              if (level[w] == none && net.res[a] > T(0)) {
+                level[w] = level[v] + 1;
+                q.push_back(w);
+              }
+            }
+          }
+          if (level[t] == none)
+            return value;
+
+          // Find a blocking flow.
+          for (std::size_t v = 0; v < n; ++v)
+            current[v] = net.first[v];
+          path.clear();
+          std::size_t v = s;
+          while (true) {
+            if (v == t) {
+              // Augment along the path by its bottleneck capacity, and
+              // retreat to the tail of the first saturated arc.
+              T d = net.res[path[0]];
+              for (std::size_t a : path)
+                d = std::min(d, net.res[a]);
+              std::size_t k = path.size();
+              for (std::size_t i = 0; i < path.size(); ++i) {
+                net.push(path[i], d);
+                if (k == path.size() && !(net.res[path[i]] > T(0)))
+                  k = i;
+              }
+              value += d;
+              path.resize(k);
+              v = k == 0 ? s : net.head(path[k - 1]);
+              continue;
+            }
+
+            // Advance along an admissible arc, if there is one.
+            std::size_t end = net.first[v + 1];
+            while (current[v] != end) {
+              std::size_t a = net.arcs[current[v]];
+              std::size_t w = net.head(a);
+              if (net.res[a] > T(0) && level[w] == level[v] + 1)
+                break;
+              ++current[v];
+            }
+            if (current[v] != end) {
+              std::size_t a = net.arcs[current[v]];
+              path.push_back(a);
+              v = net.head(a);
+              continue;
+            }
+
+            // Otherwise, v is a dead end. Remove it from the level graph and
+            // retreat.
+            if (v == s)
+              break;
+            level[v] = none;
+            std::size_t a = path.back();
+            path.pop_back();
+            v = net.head(a ^ 1);
+            ++current[v];
+          }
+        }
+      }
+
+  } // namespace max_flow_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                                                            [graph.max_flow]
+  //                              Maximum Flow
+  //
+  // The maximum flow algorithms compute a maximum flow from s to t in a
+  // directed graph g whose edge capacities are given by cap(e), or by the
+  // edge values g(e) when no capacity map is given. The result contains the
+  // value of the flow and the flow on each edge.
+  //
+  //    push_relabel_max_flow(g, s, t)
+  //    push_relabel_max_flow(g, s, t, cap, sel)
+  //    dinic_max_flow(g, s, t)
+  //    dinic_max_flow(g, s, t, cap)
+  //    min_cut(g, s, cap, f)
+  //
+  // These algorithms require the vertex and edge handles of g to be the
+  // integers in [0, g.order()) and [0, g.size()), as in the adjacency vector
+  // classes. Capacities must be non-negative.
+
+
+  // The vertex selection rule used by the push-relabel algorithm.
+  enum class push_relabel_selection
+  {
+    highest_label, // Discharge an active vertex with the highest label
+    fifo           // Discharge active vertices in first-in, first-out order
+  };
+
+  // Compute a maximum flow using the push-relabel algorithm with the given
+  // selection rule. The implementation uses the global relabeling heuristic
+  // (exact labels are recomputed by breadth-first search after every n
+  // relabels) and the gap heuristic.
+  template<typename G, typename C>
+    network_flow<Capacity_type<G, C>>
+    push_relabel_max_flow(const G& g, Vertex<G> s, Vertex<G> t, C cap,
+                          push_relabel_selection sel
+                            = push_relabel_selection::highest_label)
+    {
+      using T = Capacity_type<G, C>;
+      assert(s != t);
+      max_flow_impl::residual_network<G, T> net(g, cap);
+      bool highest = sel == push_relabel_selection::highest_label;
+      max_flow_impl::push_relabel<G, T> alg(net, s, t, highest);
+      T value = alg.run();
+      return max_flow_impl::make_flow(net, value);
+    }
+
+  template<typename G>
+    inline network_flow<Capacity_type<G, edge_value<G>>>
+    push_relabel_max_flow(const G& g, Vertex<G> s, Vertex<G> t)
+    {
+      return push_relabel_max_flow(g, s, t, edge_value<G>(g));
+    }
+
+
+  // Compute a maximum flow using Dinic's algorithm.
+  template<typename G, typename C>
+    network_flow<Capacity_type<G, C>>
+    dinic_max_flow(const G& g, Vertex<G> s, Vertex<G> t, C cap)
+    {
+      using T = Capacity_type<G, C>;
+      assert(s != t);
+      max_flow_impl::residual_network<G, T> net(g, cap);
+      T value = max_flow_impl::dinic(net, s, t);
+      return max_flow_impl::make_flow(net, value);
+    }
+
+  template<typename G>
+    inline network_flow<Capacity_type<G, edge_value<G>>>
+    dinic_max_flow(const G& g, Vertex<G> s, Vertex<G> t)
+    {
+      return dinic_max_flow(g, s, t, edge_value<G>(g));
+    }
+
+
+  // Return the minimum s-t cut corresponding to a maximum flow f from s. The
+  // source side of the cut is the set of vertices reachable from s in the
+  // residual network of f, and the cut edges are the edges leaving it.
+  template<typename G, typename C, typename T>
+    network_cut<G>
+    min_cut(const G& g, Vertex<G> s, C cap, const network_flow<T>& f)
+    {
+      network_cut<G> cut;
+      cut.source_side.assign(g.order(), false);
+      std::vector<Vertex<G>> q {s};
+      cut.source_side[s] = true;
+      for (std::size_t i = 0; i < q.size(); ++i) {
+        Vertex<G> v = q[i];
+        for (auto e : g.out_edges(v)) {
+          Vertex<G> w = g.target(e);
+          if (!cut.source_side[w] && f.flow[e] < cap(e)) {
+            cut.source_side[w] = true;
+            q.push_back(w);
+          }
+        }
+        for (auto e : g.in_edges(v)) {
+          Vertex<G> w = g.source(e);
+          if (!cut.source_side[w] && f.flow[e] > T(0)) {
+            cut.source_side[w] = true;
+            q.push_back(w);
+          }
+        }
+      }
+
+      for (Vertex<G> v : q)
+        for (auto e : g.out_edges(v))
+          if (!cut.source_side[g.target(e)])
+            cut.edges.push_back(e);
+      return cut;
+    }
+
+  template<typename G, typename T>
+    inline network_cut<G>
+    min_cut(const G& g, Vertex<G> s, const network_flow<T>& f)
+    {
+      return min_cut(g, s, edge_value<G>(g), f);
+    }
+
+} // namespace origin
+
+#endif
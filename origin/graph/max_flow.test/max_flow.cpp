@@ -0,0 +1,146 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/max_flow.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using G = directed_adjacency_vector<empty_t, int>;
+
+// Check that f is a feasible flow from s to t, and that the minimum cut
+// computed from f has the same capacity as the flow.
+void
+check_flow(const G& g, Vertex<G> s, Vertex<G> t, const network_flow<int>& f)
+{
+  assert(f.flow.size() == g.size());
+  vector<int> net(g.order(), 0);
+  for (auto e : g.edges()) {
+    assert(0 <= f.flow[e] && f.flow[e] <= g(e));
+    net[g.source(e)] -= f.flow[e];
+    net[g.target(e)] += f.flow[e];
+  }
+  for (auto v : g.vertices())
+    if (v != s && v != t)
+      assert(net[v] == 0);
+  assert(net[t] == f.value);
+  assert(net[s] == -f.value);
+
+  auto cut = min_cut(g, s, f);
+  assert(cut.source_side[s]);
+  assert(!cut.source_side[t]);
+  int c = 0;
+  for (auto e : cut.edges) {
+    assert(cut.source_side[g.source(e)]);
+    assert(!cut.source_side[g.target(e)]);
+    c += g(e);
+  }
+  assert(c == f.value);
+}
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // The flow network from CLRS, whose maximum flow is 23.
+  G g;
+  for (int i = 0; i < 6; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1, 16);
+  g.add_edge(0, 2, 13);
+  g.add_edge(1, 3, 12);
+  g.add_edge(2, 1, 4);
+  g.add_edge(2, 4, 14);
+  g.add_edge(3, 2, 9);
+  g.add_edge(3, 5, 20);
+  g.add_edge(4, 3, 7);
+  g.add_edge(4, 5, 4);
+
+  auto f1 = push_relabel_max_flow(g, 0, 5);
+  auto f2 = push_relabel_max_flow(g, 0, 5, edge_value<G>(g),
+                                  push_relabel_selection::fifo);
+  auto f3 = dinic_max_flow(g, 0, 5);
+  assert(f1.value == 23);
+  assert(f2.value == 23);
+  assert(f3.value == 23);
+  check_flow(g, 0, 5, f1);
+  check_flow(g, 0, 5, f2);
+  check_flow(g, 0, 5, f3);
+
+  // The cut separates {0, 1, 2, 4} from {3, 5}.
+  auto cut = min_cut(g, 0, f1);
+  assert(cut.edges.size() == 3);
+  assert(!cut.source_side[3] && cut.source_side[4]);
+}
+
+void
+check_disconnected()
+{
+  cout << "*** disconnected ***\n";
+  // The sink is unreachable, so all excess must return to the source.
+  G g;
+  for (int i = 0; i < 4; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1, 5);
+  g.add_edge(1, 2, 3);
+  g.add_edge(3, 2, 1);
+
+  auto f1 = push_relabel_max_flow(g, 0, 3);
+  auto f2 = dinic_max_flow(g, 0, 3);
+  assert(f1.value == 0);
+  assert(f2.value == 0);
+  check_flow(g, 0, 3, f1);
+  check_flow(g, 0, 3, f2);
+}
+
+void
+check_random()
+{
+  cout << "*** random ***\n";
+  for (unsigned seed = 1; seed <= 50; ++seed) {
+    G g = random_graph<G>(40 + seed, 6 * (40 + seed), seed, uniform_values(0, 20));
+    Vertex<G> s = 0, t = g.order() - 1;
+    auto f1 = push_relabel_max_flow(g, s, t);
+    auto f2 = push_relabel_max_flow(g, s, t, edge_value<G>(g),
+                                    push_relabel_selection::fifo);
+    auto f3 = dinic_max_flow(g, s, t);
+    assert(f1.value == f3.value);
+    assert(f2.value == f3.value);
+    check_flow(g, s, t, f1);
+    check_flow(g, s, t, f2);
+    check_flow(g, s, t, f3);
+  }
+}
+
+void
+check_capacity_map()
+{
+  cout << "*** capacity map ***\n";
+  // Unit capacities count edge-disjoint paths.
+  G g = random_graph<G>(100, 800, 7, uniform_values(0, 10));
+  auto unit = [](Edge<G>) { return 1; };
+  auto f1 = push_relabel_max_flow(g, 0, 99, unit);
+  auto f2 = dinic_max_flow(g, 0, 99, unit);
+  assert(f1.value == f2.value);
+  auto cut = min_cut(g, 0, unit, f1);
+  assert(cut.edges.size() == size_t(f1.value));
+}
+
+int main()
+{
+  check_small();
+  check_disconnected();
+  check_random();
+  check_capacity_map();
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_MEMORY_HPP
+#define ORIGIN_GRAPH_MEMORY_HPP
+
+#include <cstddef>
+
+#include <type_traits>
+#include <vector>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                              [graph.memory]
+  //                            Memory Usage
+  //
+  // A memory block counts the bytes of some part of a data structure that
+  // are in use, and the bytes that are reserved for it, which include the
+  // used bytes. The difference is the slack that could be reclaimed, for
+  // example by shrink_to_fit().
+  struct memory_block
+  {
+    memory_block& operator+=(const memory_block& x)
+    {
+      used += x.used;
+      reserved += x.reserved;
+      return *this;
+    }
+
+    std::size_t used;
+    std::size_t reserved;
+  };
+
+  inline memory_block
+  operator+(memory_block a, const memory_block& b)
+  {
+    return a += b;
+  }
+
+
+  // The memory usage of a graph, as returned by g.memory_usage(), is broken
+  // down into the parts of its representation:
+  //
+  //    vertices    vertex nodes, excluding their values and incidence lists
+  //    edges       edge nodes (or arcs), excluding their values
+  //    incidence   the elements of incidence lists
+  //    free_list   the bookkeeping of pools: links between live nodes, free
+  //                index queues, and change tracking
+  //    payload     vertex and edge values
+  //
+  // A value counts sizeof(V) bytes, or none if V is empty; memory owned by a
+  // value is not counted. Neither is memory shared with committed versions
+  // of a graph, nor the graph object itself.
+  struct graph_memory
+  {
+    graph_memory& operator+=(const graph_memory& x)
+    {
+      vertices += x.vertices;
+      edges += x.edges;
+      incidence += x.incidence;
+      free_list += x.free_list;
+      payload += x.payload;
+      return *this;
+    }
+
+    memory_block total() const
+    {
+      return vertices + edges + incidence + free_list + payload;
+    }
+
+    memory_block vertices;
+    memory_block edges;
+    memory_block incidence;
+    memory_block free_list;
+    memory_block payload;
+  };
+
+
+  namespace memory_impl
+  {
+    // Returns the number of bytes stored for a value of type T.
+    template<typename T>
+      constexpr std::size_t
+      payload_size()
+      {
+        return std::is_empty<T>::value ? 0 : sizeof(T);
+      }
+
+    // Returns the memory of the elements of v, each counted as size bytes.
+    template<typename T, typename A>
+      inline memory_block
+      block(const std::vector<T, A>& v, std::size_t size = sizeof(T))
+      {
+        return {v.size() * size, v.capacity() * size};
+      }
+
+    // Returns the part of b that holds part bytes of each object of size
+    // whole.
+    inline memory_block
+    share(const memory_block& b, std::size_t part, std::size_t whole)
+    {
+      return {b.used / whole * part, b.reserved / whole * part};
+    }
+
+  } // namespace memory_impl
+
+} // namespace origin
+
+#endif
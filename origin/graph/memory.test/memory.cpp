@@ -0,0 +1,180 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_list.hpp>
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/compressed.hpp>
+#include <origin/graph/csr.hpp>
+#include <origin/graph/temporal.hpp>
+
+using namespace std;
+using namespace origin;
+
+// Every part of the report uses no more than it reserves.
+void
+check_blocks(const graph_memory& m)
+{
+  for (auto b : {m.vertices, m.edges, m.incidence, m.free_list, m.payload})
+    assert(b.used <= b.reserved);
+  auto t = m.total();
+  assert(t.used == m.vertices.used + m.edges.used + m.incidence.used
+                 + m.free_list.used + m.payload.used);
+}
+
+// Build a graph on n vertices with a few edges per vertex.
+template<typename G>
+  G
+  make_graph(size_t n)
+  {
+    G g;
+    for (size_t i = 0; i < n; ++i)
+      g.add_vertex();
+    for (size_t i = 0; i < 3 * n; ++i)
+      g.add_edge(i % n, (i * 7 + 1) % n);
+    return g;
+  }
+
+void
+check_vector()
+{
+  cout << "*** vector ***\n";
+  using D = directed_adjacency_vector<double, int>;
+  using H = Edge<D>;
+  D g = make_graph<D>(100);
+  graph_memory m = g.memory_usage();
+  check_blocks(m);
+  assert(m.payload.used == 100 * sizeof(double) + 300 * sizeof(int));
+  assert(m.incidence.used == 2 * 300 * sizeof(H));
+  assert(m.free_list.reserved == 0);
+
+  g.shrink_to_fit();
+  m = g.memory_usage();
+  check_blocks(m);
+  assert(m.incidence.reserved == m.incidence.used);
+  assert(m.vertices.reserved == m.vertices.used);
+  assert(m.edges.reserved == m.edges.used);
+
+  // Values of empty types are not counted.
+  using U = undirected_adjacency_vector<>;
+  U u = make_graph<U>(50);
+  graph_memory mu = u.memory_usage();
+  check_blocks(mu);
+  assert(mu.payload.reserved == 0);
+  assert(mu.incidence.used == 2 * 150 * sizeof(Edge<U>));
+  u.shrink_to_fit();
+  mu = u.memory_usage();
+  assert(mu.total().used == mu.total().reserved);
+}
+
+void
+check_list()
+{
+  cout << "*** list ***\n";
+  using D = directed_adjacency_list<double, int>;
+  D g = make_graph<D>(100);
+  g.commit();
+  graph_memory m = g.memory_usage();
+  check_blocks(m);
+  assert(m.payload.used == 100 * sizeof(double) + 300 * sizeof(int));
+
+  // Removed edges leave dead nodes, which are reserved but not used, and
+  // free indexes.
+  for (auto v : g.vertices())
+    if (v % 2 == 0)
+      g.remove_edges(v);
+  graph_memory r = g.memory_usage();
+  check_blocks(r);
+  assert(r.edges.used < m.edges.used);
+  assert(r.edges.reserved == m.edges.reserved);
+  assert(r.free_list.used > m.free_list.used);
+
+  g.shrink_to_fit();
+  r = g.memory_usage();
+  check_blocks(r);
+  assert(r.incidence.reserved == r.incidence.used);
+
+  // The graph still works, and its changes can be committed.
+  g.add_edge(0, 1);
+  g.commit();
+  assert(g.snapshot().size() == g.size());
+
+  using U = undirected_adjacency_list<>;
+  U u = make_graph<U>(50);
+  u.remove_vertex(7);
+  graph_memory mu = u.memory_usage();
+  check_blocks(mu);
+  assert(mu.payload.reserved == 0);
+  u.shrink_to_fit();
+  assert(u.memory_usage().incidence.reserved == u.memory_usage().incidence.used);
+
+  // The pool accounts for every byte of its node vector.
+  using P = adjacency_list_impl::pool<int>;
+  P p;
+  for (int i = 0; i < 10; ++i)
+    p.insert(i);
+  p.erase(3);
+  auto pm = p.memory_usage();
+  assert(pm.elements.used == 9 * sizeof(int));
+  assert(pm.elements.reserved + pm.links.reserved
+         == p.capacity() * sizeof(P::node_type));
+  assert(pm.free_list.used == sizeof(size_t));
+}
+
+void
+check_compact()
+{
+  cout << "*** compact ***\n";
+  using D = directed_adjacency_vector<>;
+  D g = make_graph<D>(100);
+  csr_graph c(g);
+  graph_memory m = c.memory_usage();
+  check_blocks(m);
+  assert(m.incidence.used == 300 * sizeof(size_t));
+  assert(m.vertices.used == 101 * sizeof(size_t));
+
+  directed_compressed_graph d(g);
+  assert(d.memory_usage().total().used == d.bytes());
+  undirected_compressed_graph u(make_graph<undirected_adjacency_vector<>>(100));
+  assert(u.memory_usage().total().used == u.bytes());
+}
+
+void
+check_temporal()
+{
+  cout << "*** temporal ***\n";
+  using G = temporal_graph<empty_t, int, int>;
+  G g;
+  for (int i = 0; i < 10; ++i)
+    g.add_vertex();
+  for (int t = 0; t < 100; ++t)
+    g.add_edge(t % 10, (t * 3) % 10, t, t);
+
+  // Expired edges are not used until they are released.
+  g.expire(40);
+  graph_memory m = g.memory_usage();
+  check_blocks(m);
+  assert(m.payload.used == 60 * sizeof(int));
+  assert(m.payload.reserved >= 100 * sizeof(int));
+  assert(m.incidence.used < m.incidence.reserved);
+
+  g.shrink_to_fit();
+  m = g.memory_usage();
+  check_blocks(m);
+  assert(m.total().used == m.total().reserved);
+  assert(g.size() == 60 && g.out_degree(0) == 6);
+}
+
+int main()
+{
+  check_vector();
+  check_list();
+  check_compact();
+  check_temporal();
+}
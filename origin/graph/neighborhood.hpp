@@ -0,0 +1,287 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_NEIGHBORHOOD_HPP
+#define ORIGIN_GRAPH_NEIGHBORHOOD_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+#include <origin/sequence/range.hpp>
+
+#include <origin/graph/graph.hpp>
+#include <origin/graph/parallel.hpp>
+#include <origin/graph/traversal.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                        [graph.neighborhood]
+  //                          Neighborhood Set
+  //
+  // A neighborhood set stores the k-hop neighborhoods of a sequence of seed
+  // vertices: for each seed, the vertices within k hops of it, ordered by
+  // distance and then by handle. The seed itself is at distance 0. The
+  // vertices at distance d from the ith seed are ring(i, d), and all of its
+  // neighborhood is neighborhood(i).
+  struct neighborhood_set
+  {
+    using vertex_range = bounded_range<const std::size_t*>;
+
+    // Returns the number of seeds.
+    std::size_t count() const { return (level.size() - 1) / (hops + 1); }
+
+    vertex_range neighborhood(std::size_t i) const
+    {
+      return slice(level[i * (hops + 1)], level[(i + 1) * (hops + 1)]);
+    }
+
+    vertex_range ring(std::size_t i, std::size_t d) const
+    {
+      assert(d <= hops);
+      std::size_t j = i * (hops + 1) + d;
+      return slice(level[j], level[j + 1]);
+    }
+
+    vertex_range slice(std::size_t b, std::size_t e) const
+    {
+      return {vertices.data() + b, vertices.data() + e};
+    }
+
+    std::size_t hops;
+    std::vector<std::size_t> level;    // The start of each ring, and the end
+    std::vector<std::size_t> vertices;
+  };
+
+
+  namespace neighborhood_impl
+  {
+    // The number of seeds searched together, one per bit of a lane word.
+    constexpr std::size_t lanes = 64;
+
+    // Returns the index of the lowest set bit of x, which is not 0.
+    inline std::size_t
+    lowest_bit(std::uint64_t x)
+    {
+#if defined(__GNUC__)
+      return __builtin_ctzll(x);
+#else
+      std::size_t n = 0;
+      while (!(x & 1)) {
+        x >>= 1;
+        ++n;
+      }
+      return n;
+#endif
+    }
+
+    // The search state of one thread. Each vertex has a lane word for the
+    // seeds that have seen it, for the seeds whose frontier it is on, and
+    // for the seeds that reach it next. The words are cleared after each
+    // batch by visiting only the vertices that were touched, and grow to
+    // hold the largest handle reached.
+    struct lane_search
+    {
+      // Make the words large enough to hold handle v.
+      void fit(std::size_t v)
+      {
+        if (v < seen.size())
+          return;
+        std::size_t n = std::max(v + 1, 2 * seen.size());
+        seen.resize(n, 0);
+        visit.resize(n, 0);
+        next.resize(n, 0);
+      }
+
+      std::vector<std::uint64_t> seen;
+      std::vector<std::uint64_t> visit;
+      std::vector<std::uint64_t> next;
+      std::vector<std::size_t> frontier;
+      std::vector<std::size_t> reached;
+      std::vector<std::size_t> touched;
+
+      // The vertices found by each seed at each distance.
+      std::vector<std::vector<std::size_t>> rings;
+    };
+
+    // The neighborhoods of one batch of seeds, in the layout of a
+    // neighborhood set.
+    struct batch_result
+    {
+      std::vector<std::size_t> level;
+      std::vector<std::size_t> vertices;
+    };
+
+    // Search from the seeds [first, first + m) for k hops, with one lane per
+    // seed. Each level expands the union of the frontiers once: a vertex on
+    // the frontier of several seeds has its edges read once, and passes the
+    // lanes of all of them to its neighbors.
+    template<typename G>
+      void
+      search(const G& g, const Vertex<G>* first, std::size_t m, std::size_t k,
+             lane_search& s, batch_result& r)
+      {
+        assert(m <= lanes);
+        auto& rings = s.rings;
+        rings.resize(m * (k + 1));
+        for (auto& x : rings)
+          x.clear();
+        s.frontier.clear();
+        s.touched.clear();
+        for (std::size_t j = 0; j < m; ++j) {
+          std::size_t v = first[j];
+          std::uint64_t b = std::uint64_t(1) << j;
+          s.fit(v);
+          if (!s.seen[v])
+            s.touched.push_back(v);
+          if (!s.visit[v])
+            s.frontier.push_back(v);
+          s.seen[v] |= b;
+          s.visit[v] |= b;
+          rings[j * (k + 1)].push_back(v);
+        }
+        std::sort(s.frontier.begin(), s.frontier.end());
+
+        for (std::size_t d = 1; d <= k && !s.frontier.empty(); ++d) {
+          s.reached.clear();
+          for (std::size_t v : s.frontier) {
+            std::uint64_t x = s.visit[v];
+            Vertex<G> u(v);
+            for (auto e : traversal_impl::leaving(g, u)) {
+              std::size_t w = traversal_impl::head(g, e, u);
+              s.fit(w);
+              std::uint64_t y = x & ~s.seen[w];
+              if (y) {
+                if (!s.next[w])
+                  s.reached.push_back(w);
+                s.next[w] |= y;
+              }
+            }
+          }
+          for (std::size_t v : s.frontier)
+            s.visit[v] = 0;
+
+          std::sort(s.reached.begin(), s.reached.end());
+          for (std::size_t w : s.reached) {
+            std::uint64_t y = s.next[w];
+            if (!s.seen[w])
+              s.touched.push_back(w);
+            s.seen[w] |= y;
+            s.visit[w] = y;
+            s.next[w] = 0;
+            for (; y; y &= y - 1)
+              rings[lowest_bit(y) * (k + 1) + d].push_back(w);
+          }
+          s.frontier.swap(s.reached);
+        }
+        for (std::size_t v : s.frontier)
+          s.visit[v] = 0;
+        for (std::size_t v : s.touched)
+          s.seen[v] = 0;
+
+        r.level.clear();
+        r.vertices.clear();
+        for (std::size_t i = 0; i < m * (k + 1); ++i) {
+          auto& x = rings[i];
+          r.level.push_back(r.vertices.size());
+          r.vertices.insert(r.vertices.end(), x.begin(), x.end());
+        }
+      }
+
+  } // namespace neighborhood_impl
+
+
+  // The search state of k_hop_neighborhoods, one lane state per thread. A
+  // state kept across calls is reused without being cleared or resized,
+  // since every search leaves the words it touched at zero.
+  class neighborhood_state
+  {
+  public:
+    // Returns the lane state of the ith thread.
+    neighborhood_impl::lane_search& lane(std::size_t i)
+    {
+      if (i >= lanes_.size())
+        lanes_.resize(i + 1);
+      return lanes_[i];
+    }
+
+  private:
+    std::vector<neighborhood_impl::lane_search> lanes_;
+  };
+
+
+  // ------------------------------------------------------------------------ //
+  //                        K-Hop Neighborhoods
+  //
+  // Compute the k-hop neighborhoods of a batch of seeds: the vertices that
+  // can be reached from each seed by a path of at most k edges (out edges
+  // of a directed graph, or incident edges of an undirected graph).
+  //
+  //    k_hop_neighborhoods(g, seeds, k, threads)
+  //    k_hop_neighborhoods(g, seeds, k, state, threads)
+  //
+  // Seeds are searched 64 at a time, each assigned one bit of a lane word,
+  // following the multi-source breadth-first search of Then et al. Each
+  // vertex holds a word of the seeds that have seen it, so a vertex reached
+  // by many seeds in the same level is expanded once for all of them, and
+  // its edge list is read once per level rather than once per seed. Groups
+  // of 64 seeds are distributed over threads, each of which keeps three
+  // words per vertex. The result does not depend on the number of threads.
+  //
+  // The words grow with the handles reached, and a caller that searches
+  // many batches can keep them in a neighborhood state, so that each batch
+  // costs only the vertices it touches. Seeds may repeat.
+  template<typename G>
+    neighborhood_set
+    k_hop_neighborhoods(const G& g, const std::vector<Vertex<G>>& seeds,
+                        std::size_t k, neighborhood_state& state,
+                        std::size_t threads = 0)
+    {
+      using namespace neighborhood_impl;
+      std::size_t batches = (seeds.size() + lanes - 1) / lanes;
+      std::vector<batch_result> parts(batches);
+
+      // Take the lane states before starting the threads, so that the
+      // state is not resized concurrently.
+      std::size_t t = thread_count(batches, threads, 1);
+      state.lane(t - 1);
+      parallel_blocks(batches, [&](std::size_t i, std::size_t b, std::size_t e) {
+        lane_search& s = state.lane(i);
+        for (std::size_t j = b; j != e; ++j) {
+          std::size_t first = j * lanes;
+          std::size_t m = std::min(lanes, seeds.size() - first);
+          search(g, seeds.data() + first, m, k, s, parts[j]);
+        }
+      }, threads, 1);
+
+      neighborhood_set r {k, {}, {}};
+      r.level.reserve(seeds.size() * (k + 1) + 1);
+      for (auto& p : parts) {
+        std::size_t base = r.vertices.size();
+        for (std::size_t x : p.level)
+          r.level.push_back(base + x);
+        r.vertices.insert(r.vertices.end(), p.vertices.begin(), p.vertices.end());
+      }
+      r.level.push_back(r.vertices.size());
+      return r;
+    }
+
+  template<typename G>
+    inline neighborhood_set
+    k_hop_neighborhoods(const G& g, const std::vector<Vertex<G>>& seeds,
+                        std::size_t k, std::size_t threads = 0)
+    {
+      neighborhood_state state;
+      return k_hop_neighborhoods(g, seeds, k, state, threads);
+    }
+
+} // namespace origin
+
+#endif
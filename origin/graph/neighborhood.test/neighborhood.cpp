@@ -0,0 +1,170 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <random>
+
+#include <origin/graph/adjacency_list.hpp>
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/neighborhood.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using D = directed_adjacency_vector<>;
+using U = undirected_adjacency_vector<>;
+using L = undirected_adjacency_list<>;
+
+// Returns the vertices at each distance up to k from s, each sorted by
+// handle, by a breadth-first search.
+template<typename G>
+  vector<vector<size_t>>
+  rings(const G& g, Vertex<G> s, size_t k)
+  {
+    vector<size_t> dist(vertex_bound(g), size_t(-1));
+    vector<vector<size_t>> r(k + 1);
+    dist[s] = 0;
+    r[0].push_back(s);
+    for (size_t d = 1; d <= k; ++d) {
+      for (size_t v : r[d - 1]) {
+        Vertex<G> u(v);
+        for (auto e : traversal_impl::leaving(g, u)) {
+          size_t w = traversal_impl::head(g, e, u);
+          if (dist[w] == size_t(-1)) {
+            dist[w] = d;
+            r[d].push_back(w);
+          }
+        }
+      }
+      sort(r[d].begin(), r[d].end());
+    }
+    return r;
+  }
+
+template<typename R>
+  vector<size_t>
+  collect(const R& r)
+  {
+    return vector<size_t>(r.begin(), r.end());
+  }
+
+// Check the neighborhoods of the seeds against one search per seed.
+template<typename G>
+  void
+  check_against_bfs(const G& g, const vector<Vertex<G>>& seeds, size_t k)
+  {
+    auto r = k_hop_neighborhoods(g, seeds, k, 4);
+    assert(r.count() == seeds.size() && r.hops == k);
+    for (size_t i = 0; i < seeds.size(); ++i) {
+      auto x = rings(g, seeds[i], k);
+      vector<size_t> all;
+      for (size_t d = 0; d <= k; ++d) {
+        assert(collect(r.ring(i, d)) == x[d]);
+        all.insert(all.end(), x[d].begin(), x[d].end());
+      }
+      assert(collect(r.neighborhood(i)) == all);
+    }
+    auto r1 = k_hop_neighborhoods(g, seeds, k, 1);
+    assert(r1.vertices == r.vertices && r1.level == r.level);
+  }
+
+template<typename G>
+  vector<Vertex<G>>
+  random_seeds(const G& g, size_t m, unsigned seed)
+  {
+    minstd_rand prng(seed);
+    vector<Vertex<G>> seeds;
+    while (seeds.size() < m) {
+      size_t v = prng() % vertex_bound(g);
+      for (auto u : g.vertices())
+        if (size_t(u) == v)
+          seeds.push_back(u);
+    }
+    return seeds;
+  }
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // A directed path 0 -> 1 -> 2 -> 3, with a shortcut 0 -> 2.
+  D g;
+  for (int i = 0; i < 4; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1);
+  g.add_edge(1, 2);
+  g.add_edge(2, 3);
+  g.add_edge(0, 2);
+  vector<Vertex<D>> seeds {0, 3, 1, 0};
+  auto r = k_hop_neighborhoods(g, seeds, 2);
+  assert(r.count() == 4);
+  assert(collect(r.neighborhood(0)) == vector<size_t>({0, 1, 2, 3}));
+  assert(collect(r.ring(0, 1)) == vector<size_t>({1, 2}));
+  assert(collect(r.ring(0, 2)) == vector<size_t>({3}));
+  assert(collect(r.neighborhood(1)) == vector<size_t>({3}));
+  assert(collect(r.neighborhood(2)) == vector<size_t>({1, 2, 3}));
+  assert(collect(r.neighborhood(3)) == collect(r.neighborhood(0)));
+
+  auto z = k_hop_neighborhoods(g, seeds, 0);
+  assert(collect(z.neighborhood(1)) == vector<size_t>({3}));
+  assert(k_hop_neighborhoods(g, {}, 2).count() == 0);
+}
+
+void
+check_random()
+{
+  cout << "*** random ***\n";
+  for (unsigned seed = 1; seed <= 5; ++seed) {
+    D d = random_graph<D>(500, 1500, seed);
+    U u = random_graph<U>(500, 800, seed);
+    for (size_t k : {1, 2, 3}) {
+      check_against_bfs(d, random_seeds(d, 150, seed), k);
+      check_against_bfs(u, random_seeds(u, 150, seed), k);
+    }
+  }
+}
+
+void
+check_list()
+{
+  cout << "*** list ***\n";
+  // Removing vertices leaves holes in the handle space.
+  L g = random_graph<L>(300, 600, 3);
+  for (size_t v = 0; v < 300; v += 7)
+    g.remove_vertex(v);
+  check_against_bfs(g, random_seeds(g, 200, 3), 2);
+}
+
+void
+check_state()
+{
+  cout << "*** state ***\n";
+  // One state serves batches on graphs of growing size and with varying
+  // numbers of threads, and gives the same result as a fresh one.
+  neighborhood_state state;
+  for (size_t n : {50, 2000, 300}) {
+    U g = random_graph<U>(n, 3 * n, unsigned(n));
+    auto seeds = random_seeds(g, 200, 7);
+    for (size_t t : {1, 3, 2}) {
+      auto a = k_hop_neighborhoods(g, seeds, 2, state, t);
+      auto b = k_hop_neighborhoods(g, seeds, 2, t);
+      assert(a.vertices == b.vertices && a.level == b.level);
+    }
+  }
+}
+
+int main()
+{
+  check_small();
+  check_random();
+  check_list();
+  check_state();
+}
@@ -0,0 +1,442 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_NUMA_HPP
+#define ORIGIN_GRAPH_NUMA_HPP
+
+#include <cassert>
+#include <cstdlib>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#  include <sched.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+#include <origin/graph/parallel.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                                [graph.numa]
+  //                            NUMA Placement
+  //
+  // On a machine with several NUMA nodes, a page of memory is placed on the
+  // node of the thread that first writes it. A graph built by one thread
+  // therefore lives entirely on one node, and a parallel traversal is limited
+  // by the memory bandwidth of that node.
+  //
+  // The facilities here place large arrays by first touch, without requiring
+  // a NUMA library:
+  //
+  //    numa_topology     the CPUs of each node, read from sysfs
+  //    bind_thread       restrict the calling thread to the CPUs of a node
+  //    numa_blocks       a parallel loop whose blocks run on bound threads
+  //    numa_owner        the node that owns an index under partitioning
+  //    numa_allocator    an allocator that places large arrays on allocation
+  //    numa_place        place an adjacency vector allocated by numa_allocator
+  //
+  // An array is placed by one of the policies:
+  //
+  //    local         pages are placed where they are first written
+  //    interleave    pages are spread round robin across the nodes
+  //    partition     the array is split into one contiguous range per node,
+  //                  as for numa_blocks, so that the threads of a node read
+  //                  the elements that they own from local memory
+  //
+  // On a machine with one node, or where the topology cannot be read, every
+  // facility degrades to its plain equivalent: there is one node, threads
+  // are not bound, and arrays are allocated normally.
+  enum class numa_policy { local, interleave, partition };
+
+  namespace numa_impl
+  {
+#if defined(__linux__)
+    constexpr bool supported = true;
+#else
+    constexpr bool supported = false;
+#endif
+
+    // Arrays smaller than this are never placed.
+    constexpr std::size_t min_bytes = 1 << 20;
+
+    // Parse a sysfs CPU or node list such as "0-3,8,10-11".
+    inline std::vector<unsigned>
+    parse_list(const std::string& s)
+    {
+      std::vector<unsigned> r;
+      const char* p = s.c_str();
+      while (*p) {
+        char* q;
+        unsigned long a = std::strtoul(p, &q, 10);
+        if (q == p)
+          break;
+        unsigned long b = a;
+        if (*q == '-')
+          b = std::strtoul(q + 1, &q, 10);
+        for (unsigned long x = a; x <= b; ++x)
+          r.push_back(x);
+        p = *q == ',' ? q + 1 : q;
+      }
+      return r;
+    }
+
+    // Read the first line of a file, or the empty string.
+    inline std::string
+    read_line(const std::string& path)
+    {
+      std::ifstream f(path);
+      std::string s;
+      std::getline(f, s);
+      return s;
+    }
+
+  } // namespace numa_impl
+
+
+  // The CPUs of each NUMA node. Nodes without CPUs, such as memory-only
+  // nodes, are omitted, since no thread can be bound to them. A topology
+  // has at least one node; an empty CPU list means any CPU.
+  class numa_topology
+  {
+  public:
+    // Read the topology of the machine.
+    numa_topology();
+
+    // Describe a topology explicitly, one CPU list per node.
+    explicit numa_topology(std::vector<std::vector<unsigned>> cpus);
+
+    std::size_t nodes() const { return cpus_.size(); }
+
+    const std::vector<unsigned>& cpus(std::size_t k) const { return cpus_[k]; }
+
+  private:
+    std::vector<std::vector<unsigned>> cpus_;
+  };
+
+  inline
+  numa_topology::numa_topology()
+  {
+    if (numa_impl::supported) {
+      std::string dir = "/sys/devices/system/node/";
+      std::string online = numa_impl::read_line(dir + "online");
+      for (unsigned k : numa_impl::parse_list(online)) {
+        std::string path = dir + "node" + std::to_string(k) + "/cpulist";
+        std::vector<unsigned> c = numa_impl::parse_list(numa_impl::read_line(path));
+        if (!c.empty())
+          cpus_.push_back(std::move(c));
+      }
+    }
+    if (cpus_.size() < 2)
+      cpus_.assign(1, {});
+  }
+
+  inline
+  numa_topology::numa_topology(std::vector<std::vector<unsigned>> cpus)
+    : cpus_(std::move(cpus))
+  {
+    if (cpus_.empty())
+      cpus_.assign(1, {});
+  }
+
+  namespace numa_impl
+  {
+    // The topology of the machine, shared by the allocators that use it.
+    inline const std::shared_ptr<const numa_topology>&
+    system_topology()
+    {
+      static const std::shared_ptr<const numa_topology> topo =
+        std::make_shared<numa_topology>();
+      return topo;
+    }
+
+  } // namespace numa_impl
+
+  // Returns the topology of the machine, which is read once.
+  inline const numa_topology&
+  numa_system()
+  {
+    return *numa_impl::system_topology();
+  }
+
+
+  // Restrict the calling thread to the CPUs of node k. Returns false, and
+  // leaves the thread unchanged, if the node has no CPU list or binding is
+  // not supported.
+  inline bool
+  bind_thread(const numa_topology& topo, std::size_t k)
+  {
+    assert(k < topo.nodes());
+#if defined(__linux__)
+    const std::vector<unsigned>& c = topo.cpus(k);
+    if (c.empty())
+      return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (unsigned x : c)
+      if (x < CPU_SETSIZE)
+        CPU_SET(x, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+  }
+
+  namespace numa_impl
+  {
+    // Restores the CPU affinity of the calling thread on destruction.
+    class affinity_guard
+    {
+    public:
+#if defined(__linux__)
+      affinity_guard() : saved_(sched_getaffinity(0, sizeof(set_), &set_) == 0) { }
+      ~affinity_guard()
+      {
+        if (saved_)
+          sched_setaffinity(0, sizeof(set_), &set_);
+      }
+
+    private:
+      cpu_set_t set_;
+      bool saved_;
+#endif
+    };
+
+  } // namespace numa_impl
+
+
+  // Returns the node that owns index i of a range of n elements partitioned
+  // across the nodes: node k owns [n * k / nodes, n * (k + 1) / nodes).
+  inline std::size_t
+  numa_owner(std::size_t i, std::size_t n, std::size_t nodes)
+  {
+    assert(i < n);
+    return ((i + 1) * nodes - 1) / n;
+  }
+
+  // Call f(k, t, first, last) for each of the blocks partitioning [0, n),
+  // where k is the node that owns the block. The number of threads is
+  // rounded up to a multiple of the number of nodes, and the threads of
+  // node k, which are bound to it, run exactly the blocks in the range that
+  // node k owns under numa_owner (unless there are fewer elements than
+  // threads). The calling thread's affinity is restored before returning.
+  template<typename F>
+    void
+    numa_blocks(std::size_t n, F f, const numa_topology& topo,
+                std::size_t threads = 0)
+    {
+      std::size_t k = topo.nodes();
+      std::size_t t = thread_count(n, threads);
+      if (k == 1) {
+        parallel_blocks(n, [&](std::size_t i, std::size_t b, std::size_t e) {
+          f(std::size_t(0), i, b, e);
+        }, t);
+        return;
+      }
+
+      t = std::min((t + k - 1) / k * k, std::max<std::size_t>(n, 1));
+      parallel_blocks(n, [&](std::size_t i, std::size_t b, std::size_t e) {
+        numa_impl::affinity_guard guard;
+        std::size_t node = i * k / t;
+        bind_thread(topo, node);
+        f(node, i, b, e);
+      }, t, 1);
+    }
+
+  namespace numa_impl
+  {
+    // Returns the size of a page.
+    inline std::size_t
+    page_size()
+    {
+#if defined(__linux__)
+      long n = sysconf(_SC_PAGESIZE);
+      return n > 0 ? n : 4096;
+#else
+      return 4096;
+#endif
+    }
+
+    // Write the first byte of each page in [p, p + bytes) from a thread
+    // bound to the node that the policy places it on. Pages containing
+    // elements of several nodes under partitioning go to the lowest node.
+    inline void
+    touch(void* p, std::size_t bytes, std::size_t size, numa_policy policy,
+          const numa_topology& topo)
+    {
+      std::size_t k = topo.nodes();
+      std::size_t page = page_size();
+      std::size_t pages = (bytes + page - 1) / page;
+      std::size_t n = bytes / size;
+      volatile char* base = static_cast<char*>(p);
+      std::vector<std::thread> ts;
+      for (std::size_t node = 0; node < k; ++node)
+        ts.emplace_back([=, &topo] {
+          bind_thread(topo, node);
+          if (policy == numa_policy::interleave) {
+            for (std::size_t i = node; i < pages; i += k)
+              base[i * page] = 0;
+          } else {
+            std::size_t b = (n * node / k * size + page - 1) / page;
+            std::size_t e = (n * (node + 1) / k * size + page - 1) / page;
+            if (node + 1 == k)
+              e = pages;
+            for (std::size_t i = b; i < e; ++i)
+              base[i * page] = 0;
+          }
+        });
+      for (auto& x : ts)
+        x.join();
+    }
+
+  } // namespace numa_impl
+
+
+  // An allocator that places each array of at least 1 MiB by first touch,
+  // according to its policy, before returning it. Smaller arrays, arrays
+  // under the local policy, and all arrays on a machine with one node are
+  // allocated by operator new.
+  //
+  // The allocator keeps a copy of its topology, shared by its copies, so
+  // that it may be given a temporary one. It moves with the array, so that
+  // an array assigned or swapped into a container keeps its placement. Two
+  // allocators are equal when they have the same policy and number of
+  // nodes, since each can then free the arrays of the other.
+  template<typename T>
+    class numa_allocator
+    {
+    public:
+      using value_type = T;
+      using propagate_on_container_copy_assignment = std::true_type;
+      using propagate_on_container_move_assignment = std::true_type;
+      using propagate_on_container_swap = std::true_type;
+
+      numa_allocator(numa_policy p = numa_policy::local,
+                     const numa_topology& topo = numa_system());
+
+      template<typename U>
+        numa_allocator(const numa_allocator<U>& x)
+          : policy_(x.policy_), topo_(x.topo_)
+        { }
+
+      numa_policy policy() const { return policy_; }
+      const numa_topology& topology() const { return *topo_; }
+
+      T* allocate(std::size_t n);
+      void deallocate(T* p, std::size_t n);
+
+    private:
+      // Returns true if an array of n elements is placed.
+      bool placed(std::size_t n) const
+      {
+        return numa_impl::supported && policy_ != numa_policy::local
+            && topo_->nodes() > 1 && n * sizeof(T) >= numa_impl::min_bytes;
+      }
+
+      template<typename U>
+        friend class numa_allocator;
+
+      numa_policy policy_;
+      std::shared_ptr<const numa_topology> topo_;
+    };
+
+  template<typename T>
+    inline
+    numa_allocator<T>::numa_allocator(numa_policy p, const numa_topology& topo)
+      : policy_(p),
+        topo_(&topo == &numa_system() ? numa_impl::system_topology()
+                                      : std::make_shared<numa_topology>(topo))
+    { }
+
+  template<typename T>
+    T*
+    numa_allocator<T>::allocate(std::size_t n)
+    {
+#if defined(__linux__)
+      if (placed(n)) {
+        std::size_t bytes = n * sizeof(T);
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+          throw std::bad_alloc();
+        numa_impl::touch(p, bytes, sizeof(T), policy_, *topo_);
+        return static_cast<T*>(p);
+      }
+#endif
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+  template<typename T>
+    void
+    numa_allocator<T>::deallocate(T* p, std::size_t n)
+    {
+#if defined(__linux__)
+      if (placed(n)) {
+        munmap(p, n * sizeof(T));
+        return;
+      }
+#endif
+      ::operator delete(p);
+    }
+
+  template<typename T, typename U>
+    inline bool
+    operator==(const numa_allocator<T>& a, const numa_allocator<U>& b)
+    {
+      return a.policy() == b.policy()
+          && a.topology().nodes() == b.topology().nodes();
+    }
+
+  template<typename T, typename U>
+    inline bool
+    operator!=(const numa_allocator<T>& a, const numa_allocator<U>& b)
+    {
+      return !(a == b);
+    }
+
+  // A vector placed by a NUMA allocator.
+  template<typename T>
+    using numa_vector = std::vector<T, numa_allocator<T>>;
+
+
+  // Place an adjacency vector whose allocator is a numa_allocator across the
+  // nodes of topo. The vertex array is partitioned, so that node k holds the
+  // vertices in the range that numa_owner assigns to it, and the edge array,
+  // which is reached through handles from any vertex, is interleaved. The
+  // incidence lists of each vertex are then reallocated from a thread bound
+  // to the node that holds it, so that the lists of a vertex range are local
+  // to the threads that traverse it with numa_blocks. The arrays keep their
+  // placement as the graph grows. This does nothing on a machine with one
+  // node.
+  template<typename G>
+    void
+    numa_place(G& g, const numa_topology& topo = numa_system(),
+               std::size_t threads = 0)
+    {
+      using Alloc = typename G::allocator_type;
+      if (topo.nodes() == 1)
+        return;
+      g.relocate(Alloc(numa_policy::partition, topo),
+                 Alloc(numa_policy::interleave, topo));
+      numa_blocks(g.order(), [&g](std::size_t, std::size_t,
+                                  std::size_t b, std::size_t e) {
+        g.relocate_incidence(b, e);
+      }, topo, threads);
+    }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,156 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <mutex>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/csr.hpp>
+#include <origin/graph/generator.hpp>
+#include <origin/graph/numa.hpp>
+
+using namespace std;
+using namespace origin;
+
+// Three nodes whose threads may run on any CPU. Placement follows the same
+// paths as on a NUMA machine, without binding.
+const numa_topology fake {{{}, {}, {}}};
+
+void
+check_topology()
+{
+  cout << "*** topology ***\n";
+  assert(numa_impl::parse_list("0-3,8,10-11")
+         == (vector<unsigned> {0, 1, 2, 3, 8, 10, 11}));
+  assert(numa_impl::parse_list("").empty());
+
+  // The machine has at least one node, and the CPUs of every node when
+  // there are several.
+  const numa_topology& sys = numa_system();
+  assert(sys.nodes() >= 1);
+  for (size_t k = 0; k < sys.nodes() && sys.nodes() > 1; ++k)
+    assert(!sys.cpus(k).empty());
+
+  assert(numa_topology(vector<vector<unsigned>>()).nodes() == 1);
+  assert(!bind_thread(fake, 1));
+}
+
+void
+check_blocks()
+{
+  cout << "*** blocks ***\n";
+  for (const numa_topology* topo : {&numa_system(), &fake}) {
+    for (size_t n : {0, 5, 10000, 100001}) {
+      for (size_t t : {1, 2, 4, 7}) {
+        vector<int> seen(n);
+        mutex m;
+        size_t blocks = 0;
+        numa_blocks(n, [&](size_t k, size_t, size_t b, size_t e) {
+          lock_guard<mutex> lock(m);
+          ++blocks;
+          for (size_t i = b; i != e; ++i) {
+            ++seen[i];
+            if (n >= t * topo->nodes())
+              assert(numa_owner(i, n, topo->nodes()) == k);
+          }
+        }, *topo, t);
+        for (int x : seen)
+          assert(x == 1);
+        assert(blocks >= 1);
+      }
+    }
+  }
+  assert(numa_owner(0, 10, 3) == 0 && numa_owner(2, 10, 3) == 0);
+  assert(numa_owner(3, 10, 3) == 1 && numa_owner(9, 10, 3) == 2);
+}
+
+void
+check_allocator()
+{
+  cout << "*** allocator ***\n";
+  for (numa_policy p : {numa_policy::local, numa_policy::interleave,
+                        numa_policy::partition}) {
+    numa_vector<size_t> v(numa_allocator<size_t>(p, fake));
+    for (size_t i = 0; i < (1 << 20); ++i)
+      v.push_back(i);
+    numa_vector<size_t> w = v;
+    assert(w == v && w.get_allocator() == v.get_allocator());
+    v.clear();
+    v.shrink_to_fit();
+    assert(w.back() == (1 << 20) - 1);
+  }
+  assert(numa_allocator<int>(numa_policy::interleave, fake)
+         != numa_allocator<long>(numa_policy::partition, fake));
+
+  // An allocator keeps its own copy of a temporary topology, which its
+  // arrays use after the topology is gone.
+  numa_vector<size_t> v(numa_allocator<size_t>(numa_policy::partition,
+                                               numa_topology({{}, {}})));
+  v.assign(1 << 18, 1);
+  numa_vector<size_t> w = v;
+  w.push_back(2);
+  assert(w.size() == v.size() + 1 && w.get_allocator() == v.get_allocator());
+  assert(numa_allocator<int>(numa_policy::partition, fake)
+         != numa_allocator<int>(numa_policy::partition, numa_topology({{}, {}})));
+}
+
+void
+check_graphs()
+{
+  cout << "*** graphs ***\n";
+  using P = directed_adjacency_vector<empty_t, empty_t, size_t,
+                                      numa_allocator<empty_t>>;
+  P g = generate_graph<P>(gnm_generator(1 << 15, 1 << 18, 4, true));
+  csr_graph a(g);
+  for (numa_policy p : {numa_policy::interleave, numa_policy::partition}) {
+    csr_graph b(g, p, fake);
+    assert(b.order() == a.order() && b.size() == a.size());
+    for (size_t v = 0; v < a.order(); ++v)
+      assert(equal(a.out_neighbors(v).begin(), a.out_neighbors(v).end(),
+                   b.out_neighbors(v).begin()));
+  }
+
+  // Placing a graph allocated by a NUMA allocator keeps it unchanged, and
+  // it can grow and be copied afterwards.
+  vector<size_t> targets;
+  for (auto v : g.vertices())
+    for (auto e : g.out_edges(v))
+      targets.push_back(g.target(e));
+  numa_place(g, fake, 4);
+  assert(g.get_allocator().policy() == numa_policy::partition);
+  numa_place(g);
+  size_t i = 0;
+  for (auto v : g.vertices())
+    for (auto e : g.out_edges(v))
+      assert(g.target(e) == targets[i++]);
+  assert(g.in_degree(0) + g.out_degree(0) > 0);
+  P h = g;
+  auto x = h.add_vertex();
+  h.add_edge(x, 0);
+  assert(h.order() == g.order() + 1 && h.size() == g.size() + 1);
+  assert(h(x, 0));
+
+  using U = undirected_adjacency_vector<empty_t, empty_t, size_t,
+                                        numa_allocator<empty_t>>;
+  U u {numa_allocator<empty_t>(numa_policy::interleave, fake)};
+  for (auto e : generate_edges(grid_generator(100, 100))) {
+    while (u.order() <= max(e.first, e.second))
+      u.add_vertex();
+    u.add_edge(e.first, e.second);
+  }
+  numa_place(u, fake);
+  assert(u.size() == 2 * 99 * 100 && u(0, 1) && u(0, 100));
+}
+
+int main()
+{
+  check_topology();
+  check_blocks();
+  check_allocator();
+  check_graphs();
+}
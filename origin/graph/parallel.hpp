@@ -0,0 +1,213 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_PARALLEL_HPP
+#define ORIGIN_GRAPH_PARALLEL_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                            [graph.parallel]
+  //                            Parallel Loops
+  //
+  // The parallel loops are a minimal fork-join facility used by the graph
+  // algorithms. Each loop statically partitions an index range into one
+  // contiguous block per thread, runs the blocks on separate threads, and
+  // joins them before returning. The calling thread executes the first block.
+  //
+  // Every algorithm that runs in parallel takes the number of threads as its
+  // last argument. Passing 1 runs the algorithm on the calling thread only.
+  // Passing 0 selects the default concurrency.
+
+
+  // Returns the default number of threads used by parallel algorithms.
+  inline std::size_t
+  concurrency()
+  {
+    std::size_t n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+  }
+
+  // Returns the number of threads to use for a loop over n elements when
+  // t threads are requested. Each thread is given at least grain elements.
+  inline std::size_t
+  thread_count(std::size_t n, std::size_t t, std::size_t grain = 1024)
+  {
+    if (t == 0)
+      t = concurrency();
+    std::size_t m = (n + grain - 1) / grain;
+    return std::max<std::size_t>(1, std::min(t, m));
+  }
+
+
+  // Call f(t, first, last) for each of the t blocks partitioning [0, n). The
+  // block boundaries depend only on n and the number of threads. No block is
+  // smaller than grain elements unless there is only one block.
+  template<typename F>
+    void
+    parallel_blocks(std::size_t n, F f, std::size_t threads = 0, 
+                    std::size_t grain = 1024)
+    {
+      std::size_t t = thread_count(n, threads, grain);
+      if (t == 1) {
+        f(std::size_t(0), std::size_t(0), n);
+        return;
+      }
+
+      std::vector<std::thread> ts;
+      ts.reserve(t - 1);
+      for (std::size_t i = 1; i < t; ++i)
+        ts.emplace_back(f, i, n * i / t, n * (i + 1) / t);
+      f(std::size_t(0), std::size_t(0), n / t);
+      for (auto& x : ts)
+        x.join();
+    }
+
+  // Call f(i) for each i in [first, last).
+  template<typename F>
+    void
+    parallel_for(std::size_t first, std::size_t last, F f, 
+                 std::size_t threads = 0)
+    {
+      assert(first <= last);
+      auto body = [first, &f](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i != e; ++i)
+          f(first + i);
+      };
+      parallel_blocks(last - first, body, threads);
+    }
+
+
+  // Return the elements of v that satisfy pred, in their original order.
+  template<typename T, typename P>
+    std::vector<T>
+    parallel_filter(const std::vector<T>& v, P pred, std::size_t threads = 0)
+    {
+      std::size_t n = v.size();
+      std::size_t t = thread_count(n, threads);
+
+      // Count the selected elements in each block, and compute the offset
+      // of each block in the output.
+      std::vector<std::size_t> offset(t + 1, 0);
+      parallel_blocks(n, [&](std::size_t i, std::size_t b, std::size_t e) {
+        for (std::size_t j = b; j != e; ++j)
+          if (pred(v[j]))
+            ++offset[i + 1];
+      }, t);
+      for (std::size_t i = 0; i < t; ++i)
+        offset[i + 1] += offset[i];
+
+      // Copy the selected elements of each block into place.
+      std::vector<T> r(offset[t]);
+      parallel_blocks(n, [&](std::size_t i, std::size_t b, std::size_t e) {
+        std::size_t k = offset[i];
+        for (std::size_t j = b; j != e; ++j)
+          if (pred(v[j]))
+            r[k++] = v[j];
+      }, t);
+      return r;
+    }
+
+
+  // Sort [first, last) according to comp. The range is split into one block
+  // per thread, the blocks are sorted concurrently, and then sorted blocks
+  // are merged pairwise, also concurrently.
+  template<typename I, typename C>
+    void
+    parallel_sort(I first, I last, C comp, std::size_t threads = 0)
+    {
+      std::size_t n = last - first;
+      std::size_t t = thread_count(n, threads, 1 << 14);
+
+      // Sort each block.
+      std::vector<std::size_t> bounds(t + 1);
+      for (std::size_t i = 0; i <= t; ++i)
+        bounds[i] = n * i / t;
+      parallel_blocks(t, [&](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i != e; ++i)
+          std::sort(first + bounds[i], first + bounds[i + 1], comp);
+      }, t, 1);
+
+      // Merge adjacent runs until only one remains.
+      for (std::size_t w = 1; w < t; w *= 2) {
+        std::size_t m = (t + 2 * w - 1) / (2 * w);
+        parallel_blocks(m, [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t i = b; i != e; ++i) {
+            std::size_t lo = 2 * w * i;
+            std::size_t mid = std::min(lo + w, t);
+            std::size_t hi = std::min(lo + 2 * w, t);
+            if (mid < hi)
+              std::inplace_merge(first + bounds[lo],
+                                 first + bounds[mid],
+                                 first + bounds[hi],
+                                 comp);
+          }
+        }, m, 1);
+      }
+    }
+
+
+  // Sort keys by their low bits bits, permuting values in the same way. The
+  // sort is stable: equal keys keep their relative order. It is an LSD radix
+  // sort with 8 bit digits; in each pass, every thread counts the digits of
+  // its block, and then scatters its block to the offsets computed from the
+  // counts of all blocks.
+  template<typename T>
+    void
+    parallel_radix_sort(std::vector<std::uint64_t>& keys, std::vector<T>& values,
+                        unsigned bits, std::size_t threads = 0)
+    {
+      assert(keys.size() == values.size());
+      assert(bits <= 64);
+      constexpr std::size_t radix = 256;
+      std::size_t n = keys.size();
+      std::size_t t = thread_count(n, threads);
+      std::vector<std::uint64_t> k(n);
+      std::vector<T> v(n);
+      std::vector<std::size_t> count(t * radix);
+      for (unsigned shift = 0; shift < bits; shift += 8) {
+        std::fill(count.begin(), count.end(), 0);
+        parallel_blocks(n, [&](std::size_t i, std::size_t b, std::size_t e) {
+          std::size_t* c = &count[i * radix];
+          for (std::size_t j = b; j != e; ++j)
+            ++c[(keys[j] >> shift) & (radix - 1)];
+        }, t);
+
+        // The offset of digit d in block i follows the digits less than d,
+        // and the digits equal to d in blocks before i.
+        std::size_t sum = 0;
+        for (std::size_t d = 0; d < radix; ++d)
+          for (std::size_t i = 0; i < t; ++i) {
+            std::size_t x = count[i * radix + d];
+            count[i * radix + d] = sum;
+            sum += x;
+          }
+
+        parallel_blocks(n, [&](std::size_t i, std::size_t b, std::size_t e) {
+          std::size_t* c = &count[i * radix];
+          for (std::size_t j = b; j != e; ++j) {
+            std::size_t p = c[(keys[j] >> shift) & (radix - 1)]++;
+            k[p] = keys[j];
+            v[p] = std::move(values[j]);
+          }
+        }, t);
+        keys.swap(k);
+        values.swap(v);
+      }
+    }
+
+} // namespace origin
+
+#endif
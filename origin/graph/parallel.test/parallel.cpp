@@ -0,0 +1,107 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <origin/graph/parallel.hpp>
+
+using namespace std;
+using namespace origin;
+
+void
+check_for()
+{
+  cout << "*** parallel for ***\n";
+  for (size_t t : {1, 2, 3, 8}) {
+    vector<int> v(10000, 0);
+    parallel_for(0, v.size(), [&](size_t i) { v[i] += int(i); }, t);
+    for (size_t i = 0; i < v.size(); ++i)
+      assert(v[i] == int(i));
+  }
+}
+
+void
+check_blocks()
+{
+  cout << "*** parallel blocks ***\n";
+  std::atomic<size_t> n(0);
+  parallel_blocks(100000, [&](size_t, size_t b, size_t e) { n += e - b; }, 7);
+  assert(n == 100000);
+}
+
+void
+check_filter()
+{
+  cout << "*** parallel filter ***\n";
+  vector<int> v(50000);
+  for (size_t i = 0; i < v.size(); ++i)
+    v[i] = int(i);
+  for (size_t t : {1, 4}) {
+    vector<int> r = parallel_filter(v, [](int x) { return x % 3 == 0; }, t);
+    assert(r.size() == (v.size() + 2) / 3);
+    for (size_t i = 0; i < r.size(); ++i)
+      assert(r[i] == int(3 * i));
+  }
+}
+
+void
+check_sort()
+{
+  cout << "*** parallel sort ***\n";
+  minstd_rand prng;
+  for (size_t t : {1, 2, 3, 5, 8}) {
+    vector<int> v(100000);
+    for (auto& x : v)
+      x = prng() % 1000;
+    vector<int> w = v;
+    parallel_sort(v.begin(), v.end(), less<int>(), t);
+    sort(w.begin(), w.end());
+    assert(v == w);
+  }
+}
+
+void
+check_radix_sort()
+{
+  cout << "*** parallel radix sort ***\n";
+  minstd_rand prng;
+  for (size_t t : {1, 2, 3, 8}) {
+    for (unsigned bits : {0, 7, 16, 40, 64}) {
+      vector<uint64_t> k(50000);
+      vector<size_t> v(k.size());
+      for (size_t i = 0; i < k.size(); ++i) {
+        k[i] = (uint64_t(prng()) << 32 ^ prng()) % 5000;
+        if (bits < 64)
+          k[i] &= (uint64_t(1) << bits) - 1;
+        v[i] = i;
+      }
+      vector<pair<uint64_t, size_t>> w(k.size());
+      for (size_t i = 0; i < k.size(); ++i)
+        w[i] = {k[i], i};
+      parallel_radix_sort(k, v, bits, t);
+      stable_sort(w.begin(), w.end(), [](const pair<uint64_t, size_t>& a,
+                                         const pair<uint64_t, size_t>& b) {
+        return a.first < b.first;
+      });
+      for (size_t i = 0; i < k.size(); ++i)
+        assert(k[i] == w[i].first && v[i] == w[i].second);
+    }
+  }
+}
+
+int main()
+{
+  check_for();
+  check_blocks();
+  check_filter();
+  check_sort();
+  check_radix_sort();
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_RANDOM_HPP
+#define ORIGIN_GRAPH_RANDOM_HPP
+
+#include <cstdint>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                              [graph.random]
+  //                        Counter-Based Generator
+  //
+  // A counter-based generator computes its nth output as a hash of a key, a
+  // stream number, and n. Streams are independent, can be created in O(1)
+  // time, and produce the same values no matter which thread draws them.
+  // Parallel algorithms give each unit of work (e.g., each random walk) its
+  // own stream, so their results do not depend on the number of threads.
+  //
+  // The outputs of a stream are the outputs of a SplitMix64 generator whose
+  // state is seeded by hashing the key and stream. The class satisfies the
+  // requirements of a uniform random bit generator, and so can be used with
+  // the standard distributions.
+  class counter_rng
+  {
+  public:
+    using result_type = std::uint64_t;
+
+    counter_rng(std::uint64_t key = 0, std::uint64_t stream = 0);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    // Returns the next output.
+    result_type operator()();
+
+    // Skip the next n outputs.
+    void discard(std::uint64_t n) { count_ += n; }
+
+    // Returns a value uniformly distributed in [0, 1).
+    double uniform();
+
+    // Returns a value uniformly distributed in [0, n), for n > 0.
+    std::uint64_t below(std::uint64_t n);
+
+    static std::uint64_t mix(std::uint64_t x);
+
+  private:
+    static constexpr std::uint64_t golden = 0x9e3779b97f4a7c15ull;
+
+    std::uint64_t base_;
+    std::uint64_t count_;
+  };
+
+  inline
+  counter_rng::counter_rng(std::uint64_t key, std::uint64_t stream)
+    : base_(mix(key ^ mix(stream + golden))), count_(0)
+  { }
+
+  inline auto
+  counter_rng::operator()() -> result_type
+  {
+    return mix(base_ + golden * ++count_);
+  }
+
+  // The result has 53 random bits.
+  inline double
+  counter_rng::uniform()
+  {
+    return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  // Map a 64 bit output into [0, n) by taking the high word of the product,
+  // which avoids a division. The bias is at most n / 2^64.
+  inline std::uint64_t
+  counter_rng::below(std::uint64_t n)
+  {
+#if defined(__SIZEOF_INT128__)
+    return (unsigned __int128)(*this)() * n >> 64;
+#else
+    return (*this)() % n;
+#endif
+  }
+
+  // The SplitMix64 finalizer.
+  inline std::uint64_t
+  counter_rng::mix(std::uint64_t x)
+  {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+  }
+
+} // namespace origin
+
+#endif
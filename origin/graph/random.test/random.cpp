@@ -0,0 +1,69 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <origin/graph/random.hpp>
+
+using namespace std;
+using namespace origin;
+
+void
+check_streams()
+{
+  cout << "*** streams ***\n";
+  // The same key and stream give the same outputs; different streams do
+  // not.
+  counter_rng a(1, 2), b(1, 2), c(1, 3), d(2, 2);
+  for (int i = 0; i < 100; ++i) {
+    auto x = a();
+    assert(x == b());
+    assert(x != c());
+    assert(x != d());
+  }
+
+  // Skipping n outputs is the same as drawing them.
+  counter_rng e(5, 5), f(5, 5);
+  for (int i = 0; i < 10; ++i)
+    e();
+  f.discard(10);
+  assert(e() == f());
+}
+
+void
+check_uniform()
+{
+  cout << "*** uniform ***\n";
+  counter_rng r(7);
+  vector<int> counts(10, 0);
+  const int n = 100000;
+  for (int i = 0; i < n; ++i) {
+    double x = r.uniform();
+    assert(0 <= x && x < 1);
+    std::uint64_t k = r.below(10);
+    assert(k < 10);
+    ++counts[k];
+  }
+  for (int c : counts)
+    assert(c > n / 10 * 0.95 && c < n / 10 * 1.05);
+
+  // The generator works with the standard distributions.
+  uniform_int_distribution<int> dist(1, 6);
+  for (int i = 0; i < 100; ++i) {
+    int x = dist(r);
+    assert(1 <= x && x <= 6);
+  }
+}
+
+int main()
+{
+  check_streams();
+  check_uniform();
+}
@@ -0,0 +1,275 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_RANDOM_WALK_HPP
+#define ORIGIN_GRAPH_RANDOM_WALK_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+#include <origin/sequence/range.hpp>
+
+#include <origin/graph/csr.hpp>
+#include <origin/graph/parallel.hpp>
+#include <origin/graph/random.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                         [graph.random_walk]
+  //                              Walk Buffer
+  //
+  // A walk buffer stores a set of random walks in a single array. Every walk
+  // occupies length consecutive slots; a walk that reaches a vertex with no
+  // out edges stops early, and its remaining slots hold vertex_handle::npos.
+  // The ith walk is the range walk(i), which excludes those slots.
+  struct walk_buffer
+  {
+    using walk_range = bounded_range<const std::size_t*>;
+
+    std::size_t count() const { return sizes.size(); }
+
+    walk_range walk(std::size_t i) const
+    {
+      const std::size_t* p = vertices.data() + i * length;
+      return {p, p + sizes[i]};
+    }
+
+    std::size_t length;
+    std::vector<std::size_t> vertices;
+    std::vector<std::size_t> sizes;
+  };
+
+
+  // ------------------------------------------------------------------------ //
+  //                             Random Walker
+  //
+  // The random walker generates random walks over a CSR graph. It supports
+  // three kinds of walk:
+  //
+  //  - uniform walks, which follow an out edge chosen uniformly at random;
+  //  - weighted walks, which choose an out edge with probability
+  //    proportional to its weight, using an alias table built once per
+  //    vertex so that each step takes O(1) time; and
+  //  - node2vec walks, which bias each step by the previous vertex t: the
+  //    weight of the edge to x is scaled by 1/p if x is t, by 1 if x is
+  //    adjacent to t, and by 1/q otherwise.
+  //
+  // node2vec steps are sampled by rejection: a first-order step is proposed
+  // and accepted with probability equal to its bias divided by the largest
+  // bias. This needs no per-edge tables, and tests adjacency by binary
+  // search in the sorted neighbors of t.
+  //
+  // Each walk draws from its own counter-based random stream, identified by
+  // the seed and the index of the walk, so the walks do not depend on the
+  // number of threads used to generate them.
+  class random_walker
+  {
+  public:
+    static constexpr std::size_t npos = -1;
+
+    explicit random_walker(const csr_graph& g);
+
+    template<typename W>
+      random_walker(const csr_graph& g, W weight);
+
+    // Make walks second-order with the node2vec return parameter p and the
+    // in-out parameter q. Both must be positive.
+    void node2vec(double p, double q);
+
+    bool weighted() const { return !prob_.empty(); }
+    bool second_order() const { return second_; }
+
+    // Generate one walk of the given length from each start vertex.
+    walk_buffer walks(const std::vector<std::size_t>& starts,
+                      std::size_t length,
+                      std::uint64_t seed,
+                      std::size_t threads = 0) const;
+
+    // Generate r walks of the given length from every vertex. The walks
+    // from vertex v are the walks v * r through v * r + r - 1.
+    walk_buffer walks(std::size_t r,
+                      std::size_t length,
+                      std::uint64_t seed,
+                      std::size_t threads = 0) const;
+
+  private:
+    void walk(std::size_t* out, std::size_t& size, std::size_t start,
+              std::size_t length, counter_rng& rng) const;
+
+    std::size_t step(std::size_t v, counter_rng& rng) const;
+    std::size_t step(std::size_t t, std::size_t v, counter_rng& rng) const;
+
+  private:
+    const csr_graph& g_;
+    std::vector<double> prob_;       // Acceptance probability of each arc
+    std::vector<std::size_t> alias_; // Alias of each arc, relative to first
+    bool second_;
+    double return_;                  // The node2vec bias 1 / p
+    double inout_;                   // The node2vec bias 1 / q
+    double bound_;                   // The greatest of 1, 1 / p, and 1 / q
+  };
+
+  inline
+  random_walker::random_walker(const csr_graph& g)
+    : g_(g), second_(false), return_(1), inout_(1), bound_(1)
+  { }
+
+  // Build an alias table for the arcs of each vertex, using Vose's method,
+  // where the weight of arc a is weight(g.edge_of(a)). Weights must be
+  // non-negative. The arcs of a vertex whose weights are all 0 are chosen
+  // uniformly.
+  template<typename W>
+    random_walker::random_walker(const csr_graph& g, W weight)
+      : g_(g), prob_(g.size()), alias_(g.size()),
+        second_(false), return_(1), inout_(1), bound_(1)
+    {
+      std::vector<double> scaled;
+      std::vector<std::size_t> small;
+      std::vector<std::size_t> large;
+      for (std::size_t v = 0; v < g.order(); ++v) {
+        std::size_t b = g.first(v);
+        std::size_t n = g.out_degree(v);
+        double sum = 0;
+        scaled.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+          scaled[i] = weight(g.edge_of(b + i));
+          assert(scaled[i] >= 0);
+          sum += scaled[i];
+        }
+        small.clear();
+        large.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+          scaled[i] = sum > 0 ? scaled[i] * n / sum : 1.0;
+          (scaled[i] < 1.0 ? small : large).push_back(i);
+        }
+        while (!small.empty() && !large.empty()) {
+          std::size_t s = small.back();
+          std::size_t l = large.back();
+          small.pop_back();
+          prob_[b + s] = scaled[s];
+          alias_[b + s] = l;
+          scaled[l] -= 1.0 - scaled[s];
+          if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+          }
+        }
+
+        // Whatever remains has probability 1, up to rounding.
+        for (std::size_t i : large) {
+          prob_[b + i] = 1.0;
+          alias_[b + i] = i;
+        }
+        for (std::size_t i : small) {
+          prob_[b + i] = 1.0;
+          alias_[b + i] = i;
+        }
+      }
+    }
+
+  inline void
+  random_walker::node2vec(double p, double q)
+  {
+    assert(p > 0 && q > 0);
+    second_ = true;
+    return_ = 1 / p;
+    inout_ = 1 / q;
+    bound_ = std::max(1.0, std::max(return_, inout_));
+  }
+
+  inline walk_buffer
+  random_walker::walks(const std::vector<std::size_t>& starts,
+                       std::size_t length,
+                       std::uint64_t seed,
+                       std::size_t threads) const
+  {
+    std::size_t n = starts.size();
+    walk_buffer buf {length, std::vector<std::size_t>(n * length),
+                     std::vector<std::size_t>(n)};
+    parallel_blocks(n, [&](std::size_t, std::size_t b, std::size_t e) {
+      for (std::size_t i = b; i != e; ++i) {
+        counter_rng rng(seed, i);
+        std::size_t* out = buf.vertices.data() + i * length;
+        walk(out, buf.sizes[i], starts[i], length, rng);
+      }
+    }, threads, 64);
+    return buf;
+  }
+
+  inline walk_buffer
+  random_walker::walks(std::size_t r,
+                       std::size_t length,
+                       std::uint64_t seed,
+                       std::size_t threads) const
+  {
+    std::vector<std::size_t> starts(g_.order() * r);
+    for (std::size_t i = 0; i < starts.size(); ++i)
+      starts[i] = i / r;
+    return walks(starts, length, seed, threads);
+  }
+
+  // Write a walk from start into out, and its length into size.
+  inline void
+  random_walker::walk(std::size_t* out, std::size_t& size, std::size_t start,
+                      std::size_t length, counter_rng& rng) const
+  {
+    const std::size_t none = npos;
+    std::fill(out, out + length, none);
+    size = 0;
+    if (length == 0)
+      return;
+    out[size++] = start;
+    std::size_t prev = npos;
+    std::size_t v = start;
+    while (size < length) {
+      std::size_t a = (second_ && prev != npos) ? step(prev, v, rng)
+                                                : step(v, rng);
+      if (a == npos)
+        return;
+      prev = v;
+      v = g_.target(a);
+      out[size++] = v;
+    }
+  }
+
+  // Returns an arc leaving v, chosen by its first-order probability, or npos
+  // if v has no out edges.
+  inline std::size_t
+  random_walker::step(std::size_t v, counter_rng& rng) const
+  {
+    std::size_t n = g_.out_degree(v);
+    if (n == 0)
+      return npos;
+    std::size_t a = g_.first(v) + rng.below(n);
+    if (weighted() && rng.uniform() >= prob_[a])
+      a = g_.first(v) + alias_[a];
+    return a;
+  }
+
+  // Returns an arc leaving v, chosen by its node2vec probability given that
+  // the walk arrived at v from t.
+  inline std::size_t
+  random_walker::step(std::size_t t, std::size_t v, counter_rng& rng) const
+  {
+    while (true) {
+      std::size_t a = step(v, rng);
+      if (a == npos)
+        return npos;
+      std::size_t x = g_.target(a);
+      double bias = x == t ? return_ : g_.adjacent(t, x) ? 1.0 : inout_;
+      if (rng.uniform() * bound_ < bias)
+        return a;
+    }
+  }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,137 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/random_walk.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using G = directed_adjacency_vector<empty_t, int>;
+
+// Check that every step of every walk follows an arc of c.
+void
+check_walks(const csr_graph& c, const walk_buffer& w)
+{
+  for (size_t i = 0; i < w.count(); ++i) {
+    auto r = w.walk(i);
+    assert(r.begin() != r.end());
+    for (auto p = r.begin(); p + 1 < r.end(); ++p)
+      assert(c.adjacent(*p, *(p + 1)));
+
+    // A short walk ends at a vertex without out edges.
+    size_t n = r.end() - r.begin();
+    if (n < w.length)
+      assert(c.out_degree(*(r.end() - 1)) == 0);
+    for (size_t k = n; k < w.length; ++k)
+      assert(w.vertices[i * w.length + k] == random_walker::npos);
+  }
+}
+
+void
+check_uniform()
+{
+  cout << "*** uniform ***\n";
+  G g = random_graph<G>(200, 600, 1, uniform_values(1, 6));
+  csr_graph c(g);
+  random_walker r(c);
+  auto w1 = r.walks(3, 20, 42, 1);
+  auto w2 = r.walks(3, 20, 42, 4);
+  assert(w1.count() == 600);
+  assert(w1.vertices == w2.vertices);
+  assert(w1.sizes == w2.sizes);
+  check_walks(c, w1);
+  for (size_t i = 0; i < w1.count(); ++i)
+    assert(*w1.walk(i).begin() == i / 3);
+
+  auto w3 = r.walks(3, 20, 43, 4);
+  assert(w1.vertices != w3.vertices);
+}
+
+void
+check_weighted()
+{
+  cout << "*** weighted ***\n";
+  // From vertex 0, the edges to 1, 2, and 3 have weights 1, 2, and 5, and
+  // the edge to 4 has weight 0.
+  G g;
+  for (int i = 0; i < 5; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1, 1);
+  g.add_edge(0, 2, 2);
+  g.add_edge(0, 3, 5);
+  g.add_edge(0, 4, 0);
+  csr_graph c(g);
+  random_walker r(c, edge_value<G>(g));
+  assert(r.weighted());
+
+  vector<size_t> starts(80000, 0);
+  auto w = r.walks(starts, 2, 1);
+  check_walks(c, w);
+  vector<double> counts(5, 0);
+  for (size_t i = 0; i < w.count(); ++i)
+    ++counts[*(w.walk(i).begin() + 1)];
+  assert(counts[4] == 0);
+  assert(abs(counts[1] / 10000 - 1) < 0.05);
+  assert(abs(counts[2] / 20000 - 1) < 0.05);
+  assert(abs(counts[3] / 50000 - 1) < 0.05);
+}
+
+void
+check_node2vec()
+{
+  cout << "*** node2vec ***\n";
+  // In a triangle 0, 1, 2 with a pendant vertex 3 attached to 1 (all edges
+  // in both directions), a walk arriving at 1 from 0 returns to 0 with
+  // weight 1/p, moves to 2 (adjacent to 0) with weight 1, and moves to 3
+  // with weight 1/q.
+  G g;
+  for (int i = 0; i < 4; ++i)
+    g.add_vertex();
+  for (auto e : {make_pair(0, 1), make_pair(1, 2), make_pair(2, 0),
+                 make_pair(1, 3)}) {
+    g.add_edge(e.first, e.second, 1);
+    g.add_edge(e.second, e.first, 1);
+  }
+  csr_graph c(g);
+  random_walker r(c);
+  r.node2vec(0.5, 4);
+  assert(r.second_order());
+
+  // Force the first step by starting many walks at 0 and keeping those
+  // that move to 1.
+  auto w = r.walks(vector<size_t>(200000, 0), 3, 9, 4);
+  check_walks(c, w);
+  vector<double> counts(4, 0);
+  double total = 0;
+  for (size_t i = 0; i < w.count(); ++i) {
+    auto p = w.walk(i).begin();
+    if (p[1] == 1) {
+      ++counts[p[2]];
+      ++total;
+    }
+  }
+
+  // The biases are 2, 1, and 1/4, which sum to 3.25.
+  assert(abs(counts[0] / total - 2 / 3.25) < 0.01);
+  assert(abs(counts[2] / total - 1 / 3.25) < 0.01);
+  assert(abs(counts[3] / total - 0.25 / 3.25) < 0.01);
+}
+
+int main()
+{
+  check_uniform();
+  check_weighted();
+  check_node2vec();
+}
@@ -0,0 +1,353 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_SHARDED_HPP
+#define ORIGIN_GRAPH_SHARDED_HPP
+
+#include <cassert>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <origin/type/empty.hpp>
+#include <origin/sequence/range.hpp>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/parallel.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                             [graph.sharded]
+  //                            Sharded Graph
+  //
+  // A sharded graph partitions a directed graph across a number of shards,
+  // each an ordinary directed adjacency vector. Vertices are identified by
+  // global indexes in [0, order()); each is owned by one shard, where it has
+  // a local handle. An edge is stored in the shard of its source. When the
+  // target is owned by another shard, the edge leads to a ghost vertex: a
+  // local stand-in for the remote vertex, with no out edges and no value of
+  // its own. Each shard has at most one ghost per remote vertex.
+  //
+  // The global-to-local map gives the owner and local handle of every
+  // vertex, and each shard maps its local handles, including ghosts, back to
+  // global indexes. Threads working on different shards never share a graph
+  // object, so a vertex-centric algorithm can run one thread per shard
+  // without contention (see pregel below).
+  template<typename V = empty_t, typename E = empty_t>
+    class sharded_graph
+    {
+    public:
+      using shard_type = directed_adjacency_vector<V, E>;
+      using vertex = std::size_t;
+      using local_vertex = typename shard_type::vertex;
+      using edge = typename shard_type::edge;
+
+      explicit sharded_graph(std::size_t shards);
+
+      // Observers
+      bool        null() const   { return where_.empty(); }
+      std::size_t order() const  { return where_.size(); }
+      std::size_t size() const;
+      std::size_t shards() const { return parts_.size(); }
+
+      // Shard access
+      shard_type&       shard(std::size_t s)       { return parts_[s].graph; }
+      const shard_type& shard(std::size_t s) const { return parts_[s].graph; }
+
+      // Handle maps
+      std::size_t  owner(vertex v) const { return where_[v].first; }
+      local_vertex local(vertex v) const { return where_[v].second; }
+      vertex       global(std::size_t s, local_vertex x) const;
+      bool         is_ghost(std::size_t s, local_vertex x) const;
+      std::size_t  ghosts(std::size_t s) const { return parts_[s].ghost.size(); }
+
+      // Vertex observers
+      std::size_t out_degree(vertex v) const;
+
+      // Data access
+      V&       operator()(vertex v)       { return shard(owner(v))(local(v)); }
+      const V& operator()(vertex v) const { return shard(owner(v))(local(v)); }
+
+      // Vertex set
+      vertex add_vertex(const V& x = V());
+      vertex add_vertex_to(std::size_t s, const V& x = V());
+
+      // Edge set
+      edge add_edge(vertex u, vertex v, const E& x = E());
+
+    private:
+      struct part
+      {
+        shard_type graph;
+        std::vector<vertex> global;
+        std::unordered_map<vertex, std::size_t> ghost;
+      };
+
+      std::vector<std::pair<std::size_t, std::size_t>> where_;
+      std::vector<part> parts_;
+    };
+
+  template<typename V, typename E>
+    inline
+    sharded_graph<V, E>::sharded_graph(std::size_t shards)
+      : parts_(shards)
+    {
+      assert(shards > 0);
+    }
+
+  // Returns the number of edges in all shards.
+  template<typename V, typename E>
+    std::size_t
+    sharded_graph<V, E>::size() const
+    {
+      std::size_t n = 0;
+      for (const part& p : parts_)
+        n += p.graph.size();
+      return n;
+    }
+
+  template<typename V, typename E>
+    inline auto
+    sharded_graph<V, E>::global(std::size_t s, local_vertex x) const -> vertex
+    {
+      return parts_[s].global[x];
+    }
+
+  template<typename V, typename E>
+    inline bool
+    sharded_graph<V, E>::is_ghost(std::size_t s, local_vertex x) const
+    {
+      return owner(global(s, x)) != s;
+    }
+
+  template<typename V, typename E>
+    inline std::size_t
+    sharded_graph<V, E>::out_degree(vertex v) const
+    {
+      return shard(owner(v)).out_degree(local(v));
+    }
+
+  // Add a vertex to the shards in turn, so that they stay balanced.
+  template<typename V, typename E>
+    inline auto
+    sharded_graph<V, E>::add_vertex(const V& x) -> vertex
+    {
+      return add_vertex_to(order() % shards(), x);
+    }
+
+  // Add a vertex owned by shard s.
+  template<typename V, typename E>
+    auto
+    sharded_graph<V, E>::add_vertex_to(std::size_t s, const V& x) -> vertex
+    {
+      assert(s < shards());
+      part& p = parts_[s];
+      vertex v = order();
+      local_vertex l = p.graph.add_vertex(x);
+      p.global.push_back(v);
+      where_.emplace_back(s, l);
+      return v;
+    }
+
+  // Add an edge to the shard that owns u, creating a ghost for v if it is
+  // owned by another shard and has none there yet.
+  template<typename V, typename E>
+    auto
+    sharded_graph<V, E>::add_edge(vertex u, vertex v, const E& x) -> edge
+    {
+      std::size_t s = owner(u);
+      part& p = parts_[s];
+      std::size_t t = local(v);
+      if (owner(v) != s) {
+        auto i = p.ghost.find(v);
+        if (i == p.ghost.end()) {
+          t = p.graph.add_vertex();
+          p.global.push_back(v);
+          p.ghost.emplace(v, t);
+        } else {
+          t = i->second;
+        }
+      }
+      return p.graph.add_edge(local(u), t, x);
+    }
+
+
+  // ------------------------------------------------------------------------ //
+  //                                                              [graph.pregel]
+  //                        Bulk Synchronous Vertex Programs
+  //
+  // The pregel runner executes a vertex program on a sharded graph in
+  // supersteps. In each superstep, the program is called for every vertex
+  // that is active or has received messages, as compute(ctx, messages),
+  // where messages is a range of the messages sent to the vertex in the
+  // previous superstep, and ctx is a pregel_context. Through the context,
+  // the program reads and updates the value of its vertex, sends messages
+  // to any vertex, and votes to halt. A halted vertex is reactivated by a
+  // message. The run ends when every vertex has halted and no messages are
+  // in transit, or after a maximum number of supersteps.
+  //
+  // Shards are computed in parallel, each by one thread. Messages are
+  // appended to a buffer for each pair of sending and receiving shards, so
+  // no message is sent through shared state during a superstep. Between
+  // supersteps, each shard gathers the buffers addressed to it into its
+  // inbox, in order of sending shard, so the messages a vertex receives,
+  // and the results of a deterministic program, do not depend on the
+  // number of threads.
+  namespace pregel_impl
+  {
+    template<typename M>
+      struct shard_state
+      {
+        std::vector<char> active;
+        std::vector<std::size_t> first;
+        std::vector<M> inbox;
+        std::vector<std::vector<std::pair<std::size_t, M>>> outbox;
+        std::size_t busy;
+      };
+
+  } // namespace pregel_impl
+
+  template<typename V, typename E, typename M>
+    class pregel_context
+    {
+      using graph_type = sharded_graph<V, E>;
+      using local_vertex = typename graph_type::local_vertex;
+      using state_type = std::vector<pregel_impl::shard_state<M>>;
+    public:
+      using vertex = typename graph_type::vertex;
+
+      pregel_context(graph_type& g, state_type& state, std::size_t step,
+                     std::size_t s, local_vertex x)
+        : g_(g), state_(state), step_(step), shard_(s), local_(x),
+          v_(g.global(s, x)), halted_(false)
+      { }
+
+      // Returns the current superstep, counting from 0.
+      std::size_t superstep() const { return step_; }
+
+      // Returns the vertex being computed, and its value.
+      vertex id() const { return v_; }
+      V&     value()    { return g_(v_); }
+
+      std::size_t out_degree() const { return g_.shard(shard_).out_degree(local_); }
+
+      // Call f(w) for the target w of each out edge of the vertex.
+      template<typename F>
+        void for_each_target(F f) const
+        {
+          const auto& h = g_.shard(shard_);
+          for (auto e : h.out_edges(local_))
+            f(g_.global(shard_, h.target(e)));
+        }
+
+      // Send m to the vertex w, to be received in the next superstep.
+      void send(vertex w, const M& m)
+      {
+        state_[shard_].outbox[g_.owner(w)].emplace_back(g_.local(w), m);
+      }
+
+      // Send m along each out edge of the vertex.
+      void send_to_targets(const M& m)
+      {
+        for_each_target([&](vertex w) { send(w, m); });
+      }
+
+      void vote_to_halt()  { halted_ = true; }
+      bool halted() const { return halted_; }
+
+    private:
+      graph_type& g_;
+      state_type& state_;
+      std::size_t step_;
+      std::size_t shard_;
+      local_vertex local_;
+      vertex v_;
+      bool halted_;
+    };
+
+  // Run the vertex program compute, with messages of type M, for at most
+  // max_steps supersteps, and return the number of supersteps executed.
+  // Every vertex is active in the first superstep.
+  template<typename M, typename V, typename E, typename F>
+    std::size_t
+    pregel(sharded_graph<V, E>& g, F compute,
+           std::size_t max_steps = std::numeric_limits<std::size_t>::max(),
+           std::size_t threads = 0)
+    {
+      using context = pregel_context<V, E, M>;
+      using message_range = bounded_range<const M*>;
+
+      std::size_t k = g.shards();
+      std::vector<pregel_impl::shard_state<M>> state(k);
+      for (std::size_t s = 0; s < k; ++s) {
+        std::size_t n = g.shard(s).order();
+        state[s].active.assign(n, 1);
+        state[s].first.assign(n + 1, 0);
+        state[s].outbox.resize(k);
+      }
+
+      std::size_t step = 0;
+      while (step < max_steps) {
+        // Compute each shard, buffering its messages by receiving shard.
+        parallel_blocks(k, [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t s = b; s != e; ++s) {
+            pregel_impl::shard_state<M>& st = state[s];
+            st.busy = 0;
+            std::size_t n = st.active.size();
+            for (std::size_t x = 0; x < n; ++x) {
+              bool mail = st.first[x] != st.first[x + 1];
+              if (g.is_ghost(s, x) || !(st.active[x] || mail))
+                continue;
+              context ctx(g, state, step, s, x);
+              const M* p = st.inbox.data();
+              compute(ctx, message_range {p + st.first[x], p + st.first[x + 1]});
+              st.active[x] = !ctx.halted();
+              st.busy += st.active[x];
+            }
+            for (auto& out : st.outbox)
+              st.busy += out.size();
+          }
+        }, threads, 1);
+        ++step;
+
+        bool busy = false;
+        for (auto& st : state)
+          busy |= st.busy != 0;
+        if (!busy)
+          break;
+
+        // Gather the messages addressed to each shard, by vertex.
+        parallel_blocks(k, [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t t = b; t != e; ++t) {
+            pregel_impl::shard_state<M>& st = state[t];
+            std::fill(st.first.begin(), st.first.end(), 0);
+            for (std::size_t s = 0; s < k; ++s)
+              for (auto& m : state[s].outbox[t])
+                ++st.first[m.first + 1];
+            for (std::size_t x = 1; x < st.first.size(); ++x)
+              st.first[x] += st.first[x - 1];
+
+            std::vector<std::size_t> next(st.first.begin(), st.first.end() - 1);
+            st.inbox.resize(st.first.back());
+            for (std::size_t s = 0; s < k; ++s) {
+              for (auto& m : state[s].outbox[t])
+                st.inbox[next[m.first]++] = std::move(m.second);
+              state[s].outbox[t].clear();
+            }
+          }
+        }, threads, 1);
+      }
+      return step;
+    }
+
+} // namespace origin
+
+#endif
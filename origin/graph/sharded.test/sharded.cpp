@@ -0,0 +1,153 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+
+#include <origin/graph/generator.hpp>
+#include <origin/graph/sharded.hpp>
+#include <origin/graph/traversal.hpp>
+
+using namespace std;
+using namespace origin;
+
+const size_t infinity = numeric_limits<size_t>::max();
+
+void
+check_graph()
+{
+  cout << "*** graph ***\n";
+  sharded_graph<int> g(3);
+  for (int i = 0; i < 7; ++i)
+    assert(g.add_vertex(10 * i) == size_t(i));
+  assert(g.order() == 7 && g.owner(4) == 1 && g.local(4) == 1);
+  assert(g(4) == 40 && g.shard(1).order() == 2);
+
+  // Edges from 0 to 1 and 2, owned by other shards, lead to ghosts, and
+  // a second edge to 1 reuses its ghost.
+  g.add_edge(0, 1);
+  g.add_edge(0, 2);
+  g.add_edge(0, 1);
+  g.add_edge(0, 3);
+  assert(g.size() == 4 && g.out_degree(0) == 4);
+  assert(g.shard(0).order() == 3 + 2 && g.ghosts(0) == 2 && g.ghosts(1) == 0);
+  for (auto e : g.shard(0).out_edges(g.local(0))) {
+    auto t = g.shard(0).target(e);
+    assert(g.is_ghost(0, t) == (g.global(0, t) != 3));
+  }
+
+  // A vertex can be placed explicitly.
+  assert(g.add_vertex_to(2, 70) == 7 && g.owner(7) == 2 && g(7) == 70);
+}
+
+// Breadth-first distances from s, as a vertex program. A vertex takes the
+// least distance it is sent, and forwards it along its out edges when it
+// improves.
+template<typename G>
+  size_t
+  pregel_bfs(G& g, size_t s, size_t threads)
+  {
+    for (size_t v = 0; v < g.order(); ++v)
+      g(v) = infinity;
+    using context = pregel_context<size_t, empty_t, size_t>;
+    return pregel<size_t>(g, [s](context& ctx, bounded_range<const size_t*> msgs) {
+      size_t d = ctx.superstep() == 0 && ctx.id() == s ? 0 : infinity;
+      for (size_t m : msgs)
+        d = min(d, m);
+      if (d < ctx.value()) {
+        ctx.value() = d;
+        ctx.send_to_targets(d + 1);
+      }
+      ctx.vote_to_halt();
+    }, numeric_limits<size_t>::max(), threads);
+  }
+
+void
+check_pregel()
+{
+  cout << "*** pregel ***\n";
+  using D = directed_adjacency_vector<>;
+  gnm_generator gen(2000, 6000, 9, true);
+  vector<edge_pair> edges = generate_edges(gen);
+  D d = generate_graph<D>(gen);
+
+  // The expected distances, from a plain breadth-first search.
+  vector<size_t> dist(d.order(), infinity);
+  dist[0] = 0;
+  size_t levels = 0;
+  for (auto v : bfs_range(d, 0))
+    for (auto e : d.out_edges(v)) {
+      size_t t = d.target(e);
+      if (dist[t] == infinity) {
+        dist[t] = dist[v] + 1;
+        levels = max(levels, dist[t]);
+      }
+    }
+
+  for (size_t k : {1, 3, 8}) {
+    sharded_graph<size_t> g(k);
+    for (size_t v = 0; v < gen.order(); ++v)
+      g.add_vertex();
+    for (const edge_pair& e : edges)
+      g.add_edge(e.first, e.second);
+    assert(g.size() == edges.size());
+
+    for (size_t t : {1, 4}) {
+      // One superstep per level, one in which the last level receives its
+      // distances, and one in which nothing changes.
+      size_t steps = pregel_bfs(g, 0, t);
+      assert(steps == levels + 2);
+      for (size_t v = 0; v < g.order(); ++v)
+        assert(g(v) == dist[v]);
+    }
+  }
+}
+
+void
+check_halting()
+{
+  cout << "*** halting ***\n";
+  // A ring of 10 vertices passes a token around; only the holder is active.
+  sharded_graph<int> g(4);
+  for (int i = 0; i < 10; ++i)
+    g.add_vertex();
+  for (size_t i = 0; i < 10; ++i)
+    g.add_edge(i, (i + 1) % 10);
+  using context = pregel_context<int, empty_t, int>;
+  auto token = [](context& ctx, bounded_range<const int*> msgs) {
+    for (int m : msgs) {
+      ++ctx.value();
+      if (m > 0)
+        ctx.send_to_targets(m - 1);
+    }
+    if (ctx.superstep() == 0 && ctx.id() == 0)
+      ctx.send(1, 24);
+    ctx.vote_to_halt();
+  };
+  assert(pregel<int>(g, token) == 26);
+  for (size_t v = 0; v < 10; ++v)
+    assert(g(v) == (v >= 1 && v <= 5 ? 3 : 2));
+
+  // The run stops at the step limit.
+  assert(pregel<int>(g, token, 5, 2) == 5);
+
+  // Vertices that never halt keep running.
+  sharded_graph<int> h(2);
+  h.add_vertex();
+  assert(pregel<int>(h, [](context& ctx, bounded_range<const int*>) {
+    ++ctx.value();
+  }, 7) == 7 && h(0) == 7);
+}
+
+int main()
+{
+  check_graph();
+  check_pregel();
+  check_halting();
+}
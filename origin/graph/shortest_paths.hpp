@@ -0,0 +1,366 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_SHORTEST_PATHS_HPP
+#define ORIGIN_GRAPH_SHORTEST_PATHS_HPP
+
+#include <cassert>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <origin/math/matrix/matrix.hpp>
+
+#include <origin/graph/graph.hpp>
+#include <origin/graph/parallel.hpp>
+#include <origin/graph/traversal.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                                [graph.apsp]
+  //                     All-Pairs Shortest Paths
+  //
+  // The all-pairs shortest path algorithms compute the matrix of distances
+  // d(u, v) between every pair of vertices of g, following out edges of a
+  // directed graph or incident edges of an undirected graph. The length of
+  // an edge e is weight(e); when no weight function is given, the length is
+  // the edge's value, g(e). The distance from a vertex to itself is 0, and
+  // the distance to an unreachable vertex is infinite_distance<T>().
+  //
+  //    distance_matrix(g, weight)
+  //    floyd_warshall(d, threads)
+  //    floyd_warshall_shortest_paths(g, weight, threads)
+  //    johnson_shortest_paths(g, weight, threads)
+  //    has_negative_cycle(d)
+  //
+  // Lengths may be negative. If g has a cycle of negative length, some
+  // distances are undefined, and has_negative_cycle returns true for the
+  // result of either algorithm.
+  //
+  // These algorithms require the vertex handles of g to be the integers in
+  // [0, g.order()), as in the adjacency vector classes.
+
+
+  // Returns the distance to an unreachable vertex: infinity for floating
+  // point types, and otherwise half the greatest value, so that the sum of
+  // two infinite distances does not overflow. Finite distances must be less
+  // than a quarter of the greatest value.
+  template<typename T>
+    constexpr T
+    infinite_distance()
+    {
+      return std::numeric_limits<T>::has_infinity
+        ? std::numeric_limits<T>::infinity()
+        : std::numeric_limits<T>::max() / 2;
+    }
+
+
+  namespace apsp_impl
+  {
+    // The distance type of a weight map W over the edges of G.
+    template<typename G, typename W>
+      using Distance_type = typename std::decay<
+        decltype(std::declval<const W&>()(std::declval<Edge<G>>()))
+      >::type;
+
+    // The side of the tiles processed by blocked Floyd-Warshall. A tile of
+    // doubles occupies 32KB, so the three tiles of an update fit in L2.
+    constexpr std::size_t tile = 64;
+
+    // Set c[j] to the lesser of c[j] and a + b[j], for j in [0, n). This is
+    // the min-plus inner kernel; it is written without branches so that the
+    // compiler can vectorize it.
+    template<typename T>
+      inline void
+      relax_row(T* c, T a, const T* b, std::size_t n)
+      {
+        for (std::size_t j = 0; j < n; ++j) {
+          T x = a + b[j];
+          c[j] = x < c[j] ? x : c[j];
+        }
+      }
+
+    // Relax the tile C of d through the tile A and the tile B, where the
+    // tiles are given by their row and column offsets and extents. Paths
+    // through each intermediate vertex k of the tiles are considered in
+    // turn, so C may be A or B.
+    template<typename T>
+      void
+      relax_tile(matrix<T, 2>& d, std::size_t ci, std::size_t cj,
+                 std::size_t ak, std::size_t rows, std::size_t cols,
+                 std::size_t depth)
+      {
+        const T inf = infinite_distance<T>();
+        std::size_t n = d.cols();
+        T* p = d.data();
+        for (std::size_t k = ak; k < ak + depth; ++k) {
+          const T* b = p + k * n + cj;
+          for (std::size_t i = ci; i < ci + rows; ++i) {
+            T a = p[i * n + k];
+            if (a != inf)
+              relax_row(p + i * n + cj, a, b, cols);
+          }
+        }
+      }
+
+    // The arcs of g in compressed form, with their lengths.
+    template<typename T>
+      struct weighted_arcs
+      {
+        std::vector<std::size_t> offset;
+        std::vector<std::size_t> target;
+        std::vector<T> length;
+      };
+
+    template<typename T, typename G, typename W>
+      weighted_arcs<T>
+      make_arcs(const G& g, W weight)
+      {
+        std::size_t n = g.order();
+        weighted_arcs<T> r;
+        r.offset.assign(n + 1, 0);
+        for (std::size_t v = 0; v < n; ++v) {
+          Vertex<G> u(v);
+          for (auto e : traversal_impl::leaving(g, u)) {
+            r.target.push_back(traversal_impl::head(g, e, u));
+            r.length.push_back(weight(e));
+          }
+          r.offset[v + 1] = r.target.size();
+        }
+        return r;
+      }
+
+    // Compute potentials h for the arcs by the Bellman-Ford algorithm from
+    // a virtual source joined to every vertex by an arc of length 0, so that
+    // length(u, v) + h(u) - h(v) >= 0 for every arc. Returns false if there
+    // is a negative cycle.
+    template<typename T>
+      bool
+      potentials(const weighted_arcs<T>& g, std::vector<T>& h)
+      {
+        std::size_t n = g.offset.size() - 1;
+        h.assign(n, T(0));
+        for (std::size_t round = 0; round <= n; ++round) {
+          bool changed = false;
+          for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t a = g.offset[u]; a != g.offset[u + 1]; ++a) {
+              T x = h[u] + g.length[a];
+              if (x < h[g.target[a]]) {
+                h[g.target[a]] = x;
+                changed = true;
+              }
+            }
+          if (!changed)
+            return true;
+        }
+        return false;
+      }
+
+    // Compute the distances from s, with the arc lengths adjusted by the
+    // potentials h, into row s of d.
+    template<typename T>
+      void
+      dijkstra(const weighted_arcs<T>& g, const std::vector<T>& h,
+               std::size_t s, T* row)
+      {
+        using entry = std::pair<T, std::size_t>;
+        const T inf = infinite_distance<T>();
+        std::size_t n = g.offset.size() - 1;
+        std::vector<T> dist(n, inf);
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> q;
+        dist[s] = T(0);
+        q.emplace(T(0), s);
+        while (!q.empty()) {
+          entry x = q.top();
+          q.pop();
+          std::size_t u = x.second;
+          if (dist[u] < x.first)
+            continue;
+          for (std::size_t a = g.offset[u]; a != g.offset[u + 1]; ++a) {
+            std::size_t v = g.target[a];
+            T y = dist[u] + (g.length[a] + h[u] - h[v]);
+            if (y < dist[v]) {
+              dist[v] = y;
+              q.emplace(y, v);
+            }
+          }
+        }
+        for (std::size_t v = 0; v < n; ++v)
+          row[v] = dist[v] == inf ? inf : T(dist[v] - h[s] + h[v]);
+      }
+
+  } // namespace apsp_impl
+
+
+  // Returns the matrix of edge lengths of g: the length of the shortest
+  // edge from u to v, 0 on the diagonal (unless a loop is shorter), and
+  // infinite_distance<T>() where there is no edge.
+  template<typename T, typename G, typename W>
+    matrix<T, 2>
+    distance_matrix(const G& g, W weight)
+    {
+      std::size_t n = g.order();
+      const T inf = infinite_distance<T>();
+      matrix<T, 2> d(n, n);
+      std::fill(d.data(), d.data() + n * n, inf);
+      for (std::size_t v = 0; v < n; ++v)
+        d(v, v) = T(0);
+      for (std::size_t v = 0; v < n; ++v) {
+        Vertex<G> u(v);
+        for (auto e : traversal_impl::leaving(g, u)) {
+          std::size_t w = traversal_impl::head(g, e, u);
+          d(v, w) = std::min(d(v, w), T(weight(e)));
+        }
+      }
+      return d;
+    }
+
+
+  // Replace the edge lengths in the square matrix d with the lengths of the
+  // shortest paths, using the blocked Floyd-Warshall algorithm of
+  // Venkataraman et al. The matrix is processed in tiles. For each block
+  // of intermediate vertices, the diagonal tile is relaxed first, then the
+  // tiles in its row and column, concurrently, and then all other tiles,
+  // concurrently. Each update reads and writes tiles that stay in cache, and
+  // its inner loop is a min-plus kernel over contiguous rows.
+  template<typename T>
+    void
+    floyd_warshall(matrix<T, 2>& d, std::size_t threads = 0)
+    {
+      using namespace apsp_impl;
+      assert(d.rows() == d.cols());
+      std::size_t n = d.rows();
+      std::size_t nb = (n + tile - 1) / tile;
+      auto extent = [&](std::size_t b) { return std::min(tile, n - b * tile); };
+
+      for (std::size_t kb = 0; kb < nb; ++kb) {
+        std::size_t k0 = kb * tile;
+        std::size_t kn = extent(kb);
+
+        // The diagonal tile depends only on itself.
+        relax_tile(d, k0, k0, k0, kn, kn, kn);
+
+        // The tiles in row and column kb depend on the diagonal tile.
+        parallel_blocks(2 * nb, [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t x = b; x != e; ++x) {
+            std::size_t j = x / 2;
+            if (j == kb)
+              continue;
+            if (x % 2)
+              relax_tile(d, k0, j * tile, k0, kn, extent(j), kn);
+            else
+              relax_tile(d, j * tile, k0, k0, extent(j), kn, kn);
+          }
+        }, threads, 1);
+
+        // The remaining tiles depend on those in row and column kb.
+        parallel_blocks(nb * nb, [&](std::size_t, std::size_t b, std::size_t e) {
+          for (std::size_t x = b; x != e; ++x) {
+            std::size_t i = x / nb;
+            std::size_t j = x % nb;
+            if (i == kb || j == kb)
+              continue;
+            relax_tile(d, i * tile, j * tile, k0, extent(i), extent(j), kn);
+          }
+        }, threads, 1);
+      }
+
+      // Without an infinite value, an unreachable entry may have been
+      // reduced by a negative length. Restore it.
+      if (!std::numeric_limits<T>::has_infinity) {
+        const T inf = infinite_distance<T>();
+        T* p = d.data();
+        for (std::size_t i = 0; i < n * n; ++i)
+          if (p[i] > inf / 2)
+            p[i] = inf;
+      }
+    }
+
+  // Compute the distances between all pairs of vertices of g by the
+  // blocked Floyd-Warshall algorithm, in O(n^3) time. This is preferred for
+  // dense graphs.
+  template<typename G, typename W>
+    matrix<apsp_impl::Distance_type<G, W>, 2>
+    floyd_warshall_shortest_paths(const G& g, W weight, std::size_t threads = 0)
+    {
+      using T = apsp_impl::Distance_type<G, W>;
+      matrix<T, 2> d = distance_matrix<T>(g, weight);
+      floyd_warshall(d, threads);
+      return d;
+    }
+
+  template<typename G>
+    inline matrix<apsp_impl::Distance_type<G, edge_value<G>>, 2>
+    floyd_warshall_shortest_paths(const G& g)
+    {
+      return floyd_warshall_shortest_paths(g, edge_value<G>(g));
+    }
+
+
+  // Compute the distances between all pairs of vertices of g by Johnson's
+  // algorithm, in O(nm log n) time. If any length is negative, potentials
+  // are computed by the Bellman-Ford algorithm and used to make the lengths
+  // non-negative. A Dijkstra search is then run from each vertex, the
+  // searches running concurrently, each writing one row of the result. This
+  // is preferred for sparse graphs.
+  //
+  // If g has a negative cycle, the result is that of Floyd-Warshall.
+  template<typename G, typename W>
+    matrix<apsp_impl::Distance_type<G, W>, 2>
+    johnson_shortest_paths(const G& g, W weight, std::size_t threads = 0)
+    {
+      using namespace apsp_impl;
+      using T = Distance_type<G, W>;
+      std::size_t n = g.order();
+      weighted_arcs<T> arcs = make_arcs<T>(g, weight);
+
+      std::vector<T> h(n, T(0));
+      bool negative = false;
+      for (T x : arcs.length)
+        if (x < T(0))
+          negative = true;
+      if (negative && !potentials(arcs, h))
+        return floyd_warshall_shortest_paths(g, weight, threads);
+
+      matrix<T, 2> d(n, n);
+      parallel_blocks(n, [&](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t s = b; s != e; ++s)
+          dijkstra(arcs, h, s, d.data() + s * n);
+      }, threads, 16);
+      return d;
+    }
+
+  template<typename G>
+    inline matrix<apsp_impl::Distance_type<G, edge_value<G>>, 2>
+    johnson_shortest_paths(const G& g)
+    {
+      return johnson_shortest_paths(g, edge_value<G>(g));
+    }
+
+
+  // Returns true if the distance matrix d, computed by one of the above
+  // algorithms, shows a negative cycle: a vertex whose distance to itself is
+  // negative.
+  template<typename T>
+    bool
+    has_negative_cycle(const matrix<T, 2>& d)
+    {
+      for (std::size_t i = 0; i < d.rows(); ++i)
+        if (d(i, i) < T(0))
+          return true;
+      return false;
+    }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,153 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/shortest_paths.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using D = directed_adjacency_vector<empty_t, int>;
+using U = undirected_adjacency_vector<empty_t, int>;
+using F = directed_adjacency_vector<empty_t, double>;
+
+// Build a random graph with n vertices and m edges. Each edge (u, v) has
+// length x + h[u] - h[v] for x drawn from [0, 20), and h drawn from
+// [0, spread), so that lengths may be negative but cycles are not.
+template<typename G>
+  G
+  reweighted_graph(size_t n, size_t m, int spread, unsigned seed)
+  {
+    minstd_rand prng(seed);
+    vector<int> h(n);
+    for (auto& x : h)
+      x = spread ? prng() % spread : 0;
+    auto length = [&h](minstd_rand& r, size_t u, size_t v) {
+      return int(r() % 20) + h[u] - h[v];
+    };
+    return random_graph<G>(n, m, seed + 1, length);
+  }
+
+// The textbook triple loop.
+template<typename T>
+  void
+  simple_floyd_warshall(matrix<T, 2>& d)
+  {
+    const T inf = infinite_distance<T>();
+    size_t n = d.rows();
+    for (size_t k = 0; k < n; ++k)
+      for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+          if (d(i, k) != inf && d(k, j) != inf && d(i, k) + d(k, j) < d(i, j))
+            d(i, j) = d(i, k) + d(k, j);
+  }
+
+template<typename T>
+  bool
+  same(const matrix<T, 2>& a, const matrix<T, 2>& b)
+  {
+    if (a.rows() != b.rows() || a.cols() != b.cols())
+      return false;
+    for (size_t i = 0; i < a.rows() * a.cols(); ++i)
+      if (a.data()[i] != b.data()[i])
+        return false;
+    return true;
+  }
+
+template<typename G>
+  void
+  check_graph(const G& g)
+  {
+    auto w = edge_value<G>(g);
+    auto d0 = distance_matrix<int>(g, w);
+    simple_floyd_warshall(d0);
+    auto d1 = floyd_warshall_shortest_paths(g, w, 4);
+    auto d2 = johnson_shortest_paths(g, w, 4);
+    assert(same(d0, d1));
+    assert(same(d0, d2));
+    assert(same(d1, floyd_warshall_shortest_paths(g)));
+    assert(!has_negative_cycle(d1));
+  }
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // 0 -> 1 -> 2 is shorter than 0 -> 2, and 3 is unreachable from 0.
+  D g;
+  for (int i = 0; i < 4; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1, 2);
+  g.add_edge(1, 2, -1);
+  g.add_edge(0, 2, 5);
+  g.add_edge(3, 0, 1);
+  const int inf = infinite_distance<int>();
+  for (auto d : {floyd_warshall_shortest_paths(g), johnson_shortest_paths(g)}) {
+    assert(d(0, 2) == 1 && d(3, 2) == 2 && d(2, 2) == 0);
+    assert(d(0, 3) == inf && d(2, 0) == inf);
+  }
+
+  // A negative cycle.
+  g.add_edge(2, 0, -2);
+  assert(has_negative_cycle(floyd_warshall_shortest_paths(g)));
+  assert(has_negative_cycle(johnson_shortest_paths(g)));
+
+  D e;
+  assert(floyd_warshall_shortest_paths(e).rows() == 0);
+  assert(johnson_shortest_paths(e).rows() == 0);
+}
+
+void
+check_random()
+{
+  cout << "*** random ***\n";
+  // Sizes that are and are not multiples of the tile size.
+  for (size_t n : {1, 63, 64, 150}) {
+    for (unsigned seed = 1; seed <= 3; ++seed) {
+      check_graph(reweighted_graph<D>(n, 4 * n, 0, seed));
+      check_graph(reweighted_graph<D>(n, 4 * n, 30, seed));
+      check_graph(reweighted_graph<D>(n, n * n / 4, 30, seed));
+      check_graph(reweighted_graph<U>(n, 2 * n, 0, seed));
+    }
+  }
+}
+
+void
+check_double()
+{
+  cout << "*** double ***\n";
+  F g;
+  minstd_rand prng(1);
+  uniform_real_distribution<double> u(0, 1);
+  size_t n = 200;
+  for (size_t i = 0; i < n; ++i)
+    g.add_vertex();
+  for (size_t i = 0; i < 2000; ++i)
+    g.add_edge(prng() % n, prng() % n, u(prng));
+  auto d1 = floyd_warshall_shortest_paths(g);
+  auto d2 = johnson_shortest_paths(g);
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j) {
+      assert(isinf(d1(i, j)) == isinf(d2(i, j)));
+      assert(isinf(d1(i, j)) || abs(d1(i, j) - d2(i, j)) < 1e-9);
+    }
+}
+
+int main()
+{
+  check_small();
+  check_random();
+  check_double();
+}
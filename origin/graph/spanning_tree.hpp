@@ -0,0 +1,261 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_SPANNING_TREE_HPP
+#define ORIGIN_GRAPH_SPANNING_TREE_HPP
+
+#include <cassert>
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <origin/graph/graph.hpp>
+#include <origin/graph/parallel.hpp>
+
+namespace origin
+{
+  namespace spanning_tree_impl
+  {
+    // ---------------------------------------------------------------------- //
+    //                              Disjoint Sets
+    //
+    // A disjoint set forest over the integers [0, n) using union by rank and
+    // path halving.
+    class disjoint_sets
+    {
+    public:
+      disjoint_sets(std::size_t n)
+        : parent(n), rank(n, 0)
+      { 
+        std::iota(parent.begin(), parent.end(), std::size_t(0));
+      }
+
+      // Returns the representative of x, compressing the path from x.
+      std::size_t find(std::size_t x);
+
+      // Returns the representative of x without modifying the forest. This
+      // may be called concurrently, provided that nothing is being merged.
+      std::size_t root(std::size_t x) const;
+
+      // Merge the sets containing x and y. Returns false if x and y were
+      // already in the same set.
+      bool unite(std::size_t x, std::size_t y);
+
+    private:
+      std::vector<std::size_t> parent;
+      std::vector<unsigned char> rank;
+    };
+
+    inline std::size_t
+    disjoint_sets::find(std::size_t x)
+    {
+      while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+      }
+      return x;
+    }
+
+    inline std::size_t
+    disjoint_sets::root(std::size_t x) const
+    {
+      while (parent[x] != x)
+        x = parent[x];
+      return x;
+    }
+
+    inline bool
+    disjoint_sets::unite(std::size_t x, std::size_t y)
+    {
+      x = find(x);
+      y = find(y);
+      if (x == y)
+        return false;
+      if (rank[x] < rank[y])
+        std::swap(x, y);
+      parent[y] = x;
+      if (rank[x] == rank[y])
+        ++rank[x];
+      return true;
+    }
+
+
+    // The lighter relation orders edges by weight, breaking ties by their
+    // handles. The result is a strict total order, which guarantees that the
+    // edges selected by each round of Boruvka's algorithm cannot form a cycle.
+    template<typename G, typename W>
+      struct lighter
+      {
+        lighter(W w)
+          : weight(w)
+        { }
+
+        bool
+        operator()(Edge<G> a, Edge<G> b) const
+        {
+          auto wa = weight(a);
+          auto wb = weight(b);
+          if (wa < wb)
+            return true;
+          if (wb < wa)
+            return false;
+          return std::size_t(a) < std::size_t(b);
+        }
+
+        W weight;
+      };
+
+  } // namespace spanning_tree_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                                                                 [graph.msf]
+  //                        Minimum Spanning Forest
+  //
+  // A minimum spanning forest is a set of edges of an undirected graph that
+  // spans each connected component with a tree of minimum total weight. The
+  // following algorithms compute a minimum spanning forest of g, returning
+  // its edges. Loops are ignored. The weight of an edge e is weight(e); when
+  // no weight function is given, the weight is the edge's value, g(e).
+  //
+  //    boruvka_msf(g)
+  //    boruvka_msf(g, weight, threads)
+  //    kruskal_msf(g)
+  //    kruskal_msf(g, weight, threads)
+  //
+  // These algorithms require the vertex handles of g to be the integers in
+  // [0, g.order()), as in the adjacency vector classes.
+  //
+  // When several edges have the same weight, edges with smaller handles are
+  // preferred. Both algorithms therefore compute the same forest, and the
+  // result does not depend on the number of threads.
+
+
+  // Compute a minimum spanning forest using Boruvka's algorithm. Each round
+  // finds, in parallel, the lightest edge leaving each component by an atomic
+  // minimum on the component's candidate edge. The selected edges are then
+  // used to merge components in a disjoint set forest, and edges internal to
+  // a component are discarded before the next round. There are at most
+  // O(log n) rounds.
+  template<typename G, typename W>
+    std::vector<Edge<G>>
+    boruvka_msf(const G& g, W weight, std::size_t threads = 0)
+    {
+      using namespace spanning_tree_impl;
+      using E = Edge<G>;
+      static constexpr std::size_t npos = -1;
+
+      std::size_t n = g.order();
+      lighter<G, W> less(weight);
+      disjoint_sets sets(n);
+
+      // The component of each vertex, and the candidate edge of each
+      // component (as an index into the live edge list).
+      std::vector<std::size_t> comp(n);
+      std::unique_ptr<std::atomic<std::size_t>[]> best(
+        new std::atomic<std::size_t>[n]);
+      std::iota(comp.begin(), comp.end(), std::size_t(0));
+
+      // The live edges are those connecting distinct components.
+      std::vector<E> live;
+      live.reserve(g.size());
+      for (E e : g.edges())
+        if (g.source(e) != g.target(e))
+          live.push_back(e);
+
+      // The roots of components that may still have live edges.
+      std::vector<std::size_t> roots(n);
+      std::iota(roots.begin(), roots.end(), std::size_t(0));
+
+      std::vector<E> forest;
+      while (!live.empty()) {
+        parallel_for(0, roots.size(), [&](std::size_t i) {
+          best[roots[i]].store(npos, std::memory_order_relaxed);
+        }, threads);
+
+        // Find the lightest edge leaving each component.
+        auto relax = [&](std::size_t c, std::size_t i) {
+          std::size_t cur = best[c].load(std::memory_order_relaxed);
+          while (cur == npos || less(live[i], live[cur])) {
+            if (best[c].compare_exchange_weak(cur, i, std::memory_order_relaxed))
+              break;
+          }
+        };
+        parallel_for(0, live.size(), [&](std::size_t i) {
+          relax(comp[g.source(live[i])], i);
+          relax(comp[g.target(live[i])], i);
+        }, threads);
+
+        // Merge the components joined by the candidate edges.
+        for (std::size_t c : roots) {
+          std::size_t i = best[c].load(std::memory_order_relaxed);
+          if (i == npos)
+            continue;
+          E e = live[i];
+          if (sets.unite(g.source(e), g.target(e)))
+            forest.push_back(e);
+        }
+
+        // Contract: relabel each vertex with its new component, and discard
+        // the edges and roots that are now internal to a component.
+        parallel_for(0, n, [&](std::size_t v) { comp[v] = sets.root(v); }, threads);
+        live = parallel_filter(live, [&](E e) {
+          return comp[g.source(e)] != comp[g.target(e)];
+        }, threads);
+        roots = parallel_filter(roots, [&](std::size_t c) {
+          return comp[c] == c;
+        }, threads);
+      }
+      return forest;
+    }
+
+  template<typename G>
+    inline std::vector<Edge<G>>
+    boruvka_msf(const G& g)
+    {
+      return boruvka_msf(g, edge_value<G>(g));
+    }
+
+
+  // Compute a minimum spanning forest using Kruskal's algorithm. The edges
+  // are sorted by weight in parallel and then scanned in order, adding each
+  // edge that connects two distinct trees of the forest.
+  template<typename G, typename W>
+    std::vector<Edge<G>>
+    kruskal_msf(const G& g, W weight, std::size_t threads = 0)
+    {
+      using namespace spanning_tree_impl;
+      using E = Edge<G>;
+
+      std::vector<E> es;
+      es.reserve(g.size());
+      for (E e : g.edges())
+        if (g.source(e) != g.target(e))
+          es.push_back(e);
+      parallel_sort(es.begin(), es.end(), lighter<G, W>(weight), threads);
+
+      disjoint_sets sets(g.order());
+      std::vector<E> forest;
+      for (E e : es) {
+        if (sets.unite(g.source(e), g.target(e)))
+          forest.push_back(e);
+      }
+      return forest;
+    }
+
+  template<typename G>
+    inline std::vector<Edge<G>>
+    kruskal_msf(const G& g)
+    {
+      return kruskal_msf(g, edge_value<G>(g));
+    }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,82 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <set>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/spanning_tree.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using G = undirected_adjacency_vector<empty_t, int>;
+
+// Returns the total weight of the forest.
+int
+weight(const G& g, const vector<Edge<G>>& f)
+{
+  int w = 0;
+  for (auto e : f)
+    w += g(e);
+  return w;
+}
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // Two components: a square with a diagonal, and a single edge. There is
+  // also an isolated vertex and a loop.
+  G g;
+  for (int i = 0; i < 7; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1, 1);
+  g.add_edge(1, 2, 2);
+  g.add_edge(2, 3, 1);
+  g.add_edge(3, 0, 4);
+  g.add_edge(0, 2, 3);
+  g.add_edge(4, 5, 7);
+  g.add_edge(4, 4, 0);
+
+  auto b = boruvka_msf(g);
+  auto k = kruskal_msf(g);
+  assert(b.size() == 4);
+  assert(k.size() == 4);
+  assert(weight(g, b) == 11);
+  assert(weight(g, k) == 11);
+}
+
+// Borvuka's algorithm and Kruskal's algorithm must compute the same forest
+// for any number of threads, including when many weights are equal.
+void
+check_random()
+{
+  cout << "*** random ***\n";
+  for (int k : {3, 1000}) {
+    G g = random_graph<G>(5000, 20000, k, uniform_values(0, k));
+    auto w = edge_value<G>(g);
+    auto k1 = kruskal_msf(g, w, 1);
+    set<Edge<G>> expect(k1.begin(), k1.end());
+    for (size_t t : {1, 2, 4}) {
+      auto b = boruvka_msf(g, w, t);
+      auto k = kruskal_msf(g, w, t);
+      assert(set<Edge<G>>(b.begin(), b.end()) == expect);
+      assert(set<Edge<G>>(k.begin(), k.end()) == expect);
+    }
+  }
+}
+
+int main()
+{
+  check_small();
+  check_random();
+}
@@ -0,0 +1,421 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_TEMPORAL_HPP
+#define ORIGIN_GRAPH_TEMPORAL_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include <origin/type/empty.hpp>
+#include <origin/sequence/range.hpp>
+
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/memory.hpp>
+
+namespace origin
+{
+  namespace temporal_graph_impl
+  {
+    // An arc is an entry in an incidence list: an edge and its time. Lists
+    // are sorted by time, so the time is stored with the handle to allow
+    // binary search without touching the edge set.
+    template<typename T>
+      struct arc
+      {
+        T time;
+        edge_handle edge;
+      };
+
+    template<typename T>
+      using arc_list = std::vector<arc<T>>;
+
+    // Order arcs by time, and compare arcs with times.
+    struct arc_time
+    {
+      template<typename T>
+        bool operator()(const arc<T>& a, T t) const { return a.time < t; }
+
+      template<typename T>
+        bool operator()(T t, const arc<T>& a) const { return t < a.time; }
+    };
+
+    // The arc iterator adapts a pointer into an arc list, returning edge
+    // handles when dereferenced.
+    template<typename T>
+      class arc_iterator
+      {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = edge_handle;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const edge_handle*;
+        using reference = edge_handle;
+
+        arc_iterator(const arc<T>* p = nullptr)
+          : ptr(p)
+        { }
+
+        reference operator*() const { return ptr->edge; }
+
+        arc_iterator& operator++() { ++ptr; return *this; }
+        arc_iterator  operator++(int) { arc_iterator i = *this; ++ptr; return i; }
+
+        bool operator==(arc_iterator x) const { return ptr == x.ptr; }
+        bool operator!=(arc_iterator x) const { return ptr != x.ptr; }
+
+        const arc<T>* ptr;
+      };
+
+    template<typename T>
+      using arc_range = bounded_range<arc_iterator<T>>;
+
+    // A vertex stores its time-sorted out and in arcs, and a value.
+    template<typename V, typename T>
+      struct vertex
+      {
+        vertex() = default;
+
+        template<typename... Args>
+          explicit vertex(Args&&... args)
+            : value(std::forward<Args>(args)...)
+          { }
+
+        arc_list<T> out;
+        arc_list<T> in;
+        V value;
+      };
+
+    // An edge stores its endpoints, time, and value.
+    template<typename E, typename T>
+      struct edge
+      {
+        template<typename... Args>
+          edge(vertex_handle s, vertex_handle t, T time, Args&&... args)
+            : source(s), target(t), time(time), value(std::forward<Args>(args)...)
+          { }
+
+        vertex_handle source;
+        vertex_handle target;
+        T time;
+        E value;
+      };
+
+  } // namespace temporal_graph_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                                                            [graph.temporal]
+  //                            Temporal Graph
+  //
+  // A temporal graph is a directed graph whose edges carry a time of type T.
+  // It has the interface of a directed adjacency vector, extended with time
+  // window queries and expiry:
+  //
+  //    g.out_edges(v, t0, t1)    the out edges of v with times in [t0, t1)
+  //    g.in_edges(v, t0, t1)     the in edges of v with times in [t0, t1)
+  //    g.edges(t0, t1)           the edges with times in [t0, t1)
+  //    g.expire(t)               remove every edge with time before t
+  //
+  // Edges are added in order of non-decreasing time, as when a graph is
+  // built from a stream of timestamped interactions. Each incidence list,
+  // and the edge set itself, is therefore sorted by time, and window queries
+  // locate their bounds by binary search, in O(log d) time for a vertex of
+  // degree d.
+  //
+  // Expiry advances a horizon: edges before the horizon are no longer part
+  // of the graph, and the ranges and degrees of the graph exclude them. The
+  // memory of expired edges is reclaimed in bulk, once they outnumber both
+  // the live edges and the vertices, so expiry takes amortized constant time
+  // per edge. Edge handles are assigned in order of insertion and remain
+  // valid until their edge expires.
+  template<typename V = empty_t, typename E = empty_t, typename T = std::int64_t>
+    class temporal_graph
+    {
+      using vertex_node = temporal_graph_impl::vertex<V, T>;
+      using edge_node = temporal_graph_impl::edge<E, T>;
+      using arc_list = temporal_graph_impl::arc_list<T>;
+      using vertex_iter = adjacency_vector_impl::handle_counter<std::size_t, vertex_handle>;
+      using edge_iter = adjacency_vector_impl::handle_counter<std::size_t, edge_handle>;
+    public:
+      using time_type = T;
+
+      using vertex = vertex_handle;
+      using vertex_range = bounded_range<vertex_iter>;
+
+      using edge = edge_handle;
+      using edge_range = bounded_range<edge_iter>;
+
+      using incidence_range = temporal_graph_impl::arc_range<T>;
+
+      temporal_graph()
+        : base_(0), live_(0), horizon_(std::numeric_limits<T>::lowest())
+      { }
+
+      // Observers
+      bool        null() const  { return verts_.empty(); }
+      std::size_t order() const { return verts_.size(); }
+
+      bool        empty() const { return size() == 0; }
+      std::size_t size() const  { return edges_.size() - live_; }
+
+      // Returns the expiry horizon. Edges whose times are before the
+      // horizon have been removed.
+      T horizon() const { return horizon_; }
+
+      // Vertex observers
+      std::size_t out_degree(vertex v) const { return count(live(node(v).out)); }
+      std::size_t in_degree(vertex v) const  { return count(live(node(v).in)); }
+      std::size_t degree(vertex v) const { return out_degree(v) + in_degree(v); }
+
+      // Edge observers
+      vertex source(edge e) const { return get_edge(e).source; }
+      vertex target(edge e) const { return get_edge(e).target; }
+      T      time(edge e) const   { return get_edge(e).time; }
+
+      // Data access
+      V&       operator()(vertex v)       { return node(v).value; }
+      const V& operator()(vertex v) const { return node(v).value; }
+
+      E&       operator()(edge e)       { return get_edge(e).value; }
+      const E& operator()(edge e) const { return get_edge(e).value; }
+
+      // Vertex set
+      template<typename... Args>
+        vertex add_vertex(Args&&... args);
+
+      // Edge set
+
+      // Add an edge from u to v at time t, constructing its value from args.
+      // If t precedes the time of the last edge added, or the horizon, the
+      // edge is rejected and an invalid edge is returned.
+      template<typename... Args>
+        edge add_edge(vertex u, vertex v, T t, Args&&... args);
+
+      // Remove the edges whose times precede t.
+      void expire(T t);
+
+      // Iterators
+      vertex_range vertices() const;
+      edge_range   edges() const;
+      edge_range   edges(T t0, T t1) const;
+
+      incidence_range out_edges(vertex v) const { return range(live(node(v).out)); }
+      incidence_range in_edges(vertex v) const  { return range(live(node(v).in)); }
+
+      incidence_range out_edges(vertex v, T t0, T t1) const
+      {
+        return range(window(node(v).out, t0, t1));
+      }
+
+      incidence_range in_edges(vertex v, T t0, T t1) const
+      {
+        return range(window(node(v).in, t0, t1));
+      }
+
+      // Memory
+      graph_memory memory_usage() const;
+      void         shrink_to_fit();
+
+    private:
+      using arc_span = std::pair<const temporal_graph_impl::arc<T>*,
+                                 const temporal_graph_impl::arc<T>*>;
+
+      vertex_node&       node(vertex v)       { return verts_[v]; }
+      const vertex_node& node(vertex v) const { return verts_[v]; }
+
+      edge_node&       get_edge(edge e)       { return edges_[index(e)]; }
+      const edge_node& get_edge(edge e) const { return edges_[index(e)]; }
+
+      // Returns the position of a live edge in the edge set.
+      std::size_t index(edge e) const
+      {
+        assert(std::size_t(e) >= base_ + live_);
+        assert(std::size_t(e) < base_ + edges_.size());
+        return std::size_t(e) - base_;
+      }
+
+      // Returns the arcs of l with times in [t0, t1), excluding expired arcs.
+      arc_span window(const arc_list& l, T t0, T t1) const;
+
+      // Returns the arcs of l that have not expired.
+      arc_span live(const arc_list& l) const;
+
+      static incidence_range range(arc_span s) { return {s.first, s.second}; }
+      static std::size_t count(arc_span s) { return s.second - s.first; }
+
+      // Release the memory of expired edges.
+      void compact();
+
+    private:
+      std::vector<vertex_node> verts_;
+      std::vector<edge_node> edges_;
+      std::size_t base_; // The handle of edges_[0]
+      std::size_t live_; // The position of the first live edge in edges_
+      T horizon_;
+    };
+
+  template<typename V, typename E, typename T>
+    template<typename... Args>
+      inline auto
+      temporal_graph<V, E, T>::add_vertex(Args&&... args) -> vertex
+      {
+        verts_.emplace_back(std::forward<Args>(args)...);
+        return vertex(verts_.size() - 1);
+      }
+
+  template<typename V, typename E, typename T>
+    template<typename... Args>
+      auto
+      temporal_graph<V, E, T>::add_edge(vertex u, vertex v, T t, Args&&... args)
+        -> edge
+      {
+        assert(u < order() && v < order());
+        if (t < horizon_ || (!edges_.empty() && t < edges_.back().time))
+          return edge();
+        edge e(base_ + edges_.size());
+        edges_.emplace_back(u, v, t, std::forward<Args>(args)...);
+        node(u).out.push_back({t, e});
+        node(v).in.push_back({t, e});
+        return e;
+      }
+
+  // Advance the horizon to t. The expired edges are a prefix of the edge
+  // set, and each incidence list, so they are found without searching.
+  template<typename V, typename E, typename T>
+    void
+    temporal_graph<V, E, T>::expire(T t)
+    {
+      if (!(horizon_ < t))
+        return;
+      horizon_ = t;
+      while (live_ < edges_.size() && edges_[live_].time < t)
+        ++live_;
+      if (live_ > edges_.size() - live_ && live_ >= order())
+        compact();
+    }
+
+  // Erase the expired prefix of the edge set and of each incidence list.
+  // This takes O(n + k) time, where k is the number of expired edges.
+  template<typename V, typename E, typename T>
+    void
+    temporal_graph<V, E, T>::compact()
+    {
+      using temporal_graph_impl::arc_time;
+      for (vertex_node& x : verts_) {
+        for (arc_list* l : {&x.out, &x.in}) {
+          auto i = std::lower_bound(l->begin(), l->end(), horizon_, arc_time{});
+          l->erase(l->begin(), i);
+        }
+      }
+      edges_.erase(edges_.begin(), edges_.begin() + live_);
+      base_ += live_;
+      live_ = 0;
+    }
+
+  // Returns the memory used by the graph, as described in [graph.memory].
+  // Expired edges and arcs that have not yet been released are reserved but
+  // not used.
+  template<typename V, typename E, typename T>
+    graph_memory
+    temporal_graph<V, E, T>::memory_usage() const
+    {
+      using namespace memory_impl;
+      using temporal_graph_impl::arc;
+      constexpr std::size_t pv = payload_size<V>();
+      constexpr std::size_t pe = payload_size<E>();
+      constexpr std::size_t se = sizeof(edge_node);
+      graph_memory m {};
+      m.vertices = block(verts_, sizeof(vertex_node) - pv);
+      m.edges = {size() * (se - pe), edges_.capacity() * (se - pe)};
+      m.payload = block(verts_, pv);
+      m.payload += {size() * pe, edges_.capacity() * pe};
+      for (const vertex_node& n : verts_) {
+        m.incidence.used += (count(live(n.out)) + count(live(n.in))) * sizeof(arc<T>);
+        m.incidence.reserved += block(n.out).reserved + block(n.in).reserved;
+      }
+      return m;
+    }
+
+  // Release the memory of expired edges, and the capacity reserved beyond
+  // the size of the vertex set, the edge set, and each incidence list.
+  template<typename V, typename E, typename T>
+    void
+    temporal_graph<V, E, T>::shrink_to_fit()
+    {
+      compact();
+      verts_.shrink_to_fit();
+      edges_.shrink_to_fit();
+      for (vertex_node& n : verts_) {
+        n.out.shrink_to_fit();
+        n.in.shrink_to_fit();
+      }
+    }
+
+  template<typename V, typename E, typename T>
+    inline auto
+    temporal_graph<V, E, T>::window(const arc_list& l, T t0, T t1) const
+      -> arc_span
+    {
+      using temporal_graph_impl::arc_time;
+      if (t0 < horizon_)
+        t0 = horizon_;
+      const auto* first = l.data();
+      const auto* last = l.data() + l.size();
+      first = std::lower_bound(first, last, t0, arc_time{});
+      last = t1 < t0 ? first : std::lower_bound(first, last, t1, arc_time{});
+      return {first, last};
+    }
+
+  // The live arcs run to the end of the list, so that arcs at the greatest
+  // time are included.
+  template<typename V, typename E, typename T>
+    inline auto
+    temporal_graph<V, E, T>::live(const arc_list& l) const -> arc_span
+    {
+      using temporal_graph_impl::arc_time;
+      const auto* first = l.data();
+      const auto* last = l.data() + l.size();
+      return {std::lower_bound(first, last, horizon_, arc_time{}), last};
+    }
+
+  template<typename V, typename E, typename T>
+    inline auto
+    temporal_graph<V, E, T>::vertices() const -> vertex_range
+    {
+      return {vertex_iter(0), vertex_iter(order())};
+    }
+
+  template<typename V, typename E, typename T>
+    inline auto
+    temporal_graph<V, E, T>::edges() const -> edge_range
+    {
+      return {edge_iter(base_ + live_), edge_iter(base_ + edges_.size())};
+    }
+
+  template<typename V, typename E, typename T>
+    auto
+    temporal_graph<V, E, T>::edges(T t0, T t1) const -> edge_range
+    {
+      auto before = [](const edge_node& x, T t) { return x.time < t; };
+      auto first = edges_.begin() + live_;
+      auto last = edges_.end();
+      first = std::lower_bound(first, last, t0, before);
+      last = t1 < t0 ? first : std::lower_bound(first, last, t1, before);
+      return {edge_iter(base_ + (first - edges_.begin())),
+              edge_iter(base_ + (last - edges_.begin()))};
+    }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,208 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <origin/graph/temporal.hpp>
+#include <origin/graph/traversal.hpp>
+
+using namespace std;
+using namespace origin;
+
+using G = temporal_graph<string, int>;
+
+struct record
+{
+  size_t source, target;
+  long time;
+  int value;
+};
+
+// Build a graph from a random stream of m edges on n vertices, with about
+// k edges per time step, recording the edges in rs.
+G
+random_stream(size_t n, size_t m, size_t k, unsigned seed, vector<record>& rs)
+{
+  minstd_rand prng(seed);
+  G g;
+  for (size_t i = 0; i < n; ++i)
+    g.add_vertex(to_string(i));
+  long t = 0;
+  for (size_t i = 0; i < m; ++i) {
+    if (prng() % k == 0)
+      ++t;
+    record r {prng() % n, prng() % n, t, int(i)};
+    auto e = g.add_edge(r.source, r.target, r.time, r.value);
+    assert(size_t(e) == i);
+    rs.push_back(r);
+  }
+  return g;
+}
+
+// Check the neighbors of each vertex in [t0, t1) against a scan of the
+// recorded edges, ignoring those before the horizon.
+void
+check_windows(const G& g, const vector<record>& rs, long t0, long t1)
+{
+  for (auto v : g.vertices()) {
+    vector<size_t> out, in;
+    for (size_t i = 0; i < rs.size(); ++i) {
+      if (rs[i].time < t0 || rs[i].time >= t1 || rs[i].time < g.horizon())
+        continue;
+      if (rs[i].source == v)
+        out.push_back(i);
+      if (rs[i].target == v)
+        in.push_back(i);
+    }
+    vector<size_t> gout, gin;
+    for (auto e : g.out_edges(v, t0, t1)) {
+      assert(g.source(e) == v);
+      assert(g(e) == rs[e].value && g.time(e) == rs[e].time);
+      gout.push_back(e);
+    }
+    for (auto e : g.in_edges(v, t0, t1)) {
+      assert(g.target(e) == v);
+      gin.push_back(e);
+    }
+    assert(gout == out && gin == in);
+  }
+}
+
+void
+check_windows()
+{
+  cout << "*** windows ***\n";
+  vector<record> rs;
+  G g = random_stream(50, 2000, 10, 1, rs);
+  assert(g.order() == 50 && g.size() == 2000);
+  assert(g(Vertex<G>(7)) == "7");
+  long end = rs.back().time + 1;
+  for (long t0 : {0L, 10L, 50L, end})
+    for (long t1 : {0L, 5L, 60L, end, end + 10})
+      check_windows(g, rs, t0, t1);
+
+  vector<size_t> es;
+  for (auto e : g.edges(20, 40)) {
+    assert(g.time(e) >= 20 && g.time(e) < 40);
+    es.push_back(e);
+  }
+  size_t k = 0;
+  for (auto& r : rs)
+    if (r.time >= 20 && r.time < 40)
+      ++k;
+  assert(es.size() == k);
+}
+
+void
+check_expire()
+{
+  cout << "*** expire ***\n";
+  vector<record> rs;
+  G g = random_stream(20, 5000, 10, 2, rs);
+  long end = rs.back().time + 1;
+  for (long h = 0; h <= end; h += 7) {
+    g.expire(h);
+    assert(g.horizon() == h);
+    size_t live = 0;
+    for (auto& r : rs)
+      if (r.time >= h)
+        ++live;
+    assert(g.size() == live);
+
+    // Handles of live edges survive the reclamation of expired ones.
+    size_t m = 0;
+    for (auto e : g.edges()) {
+      assert(g(e) == rs[e].value && g.time(e) >= h);
+      ++m;
+    }
+    assert(m == live);
+
+    size_t deg = 0;
+    for (auto v : g.vertices())
+      deg += g.out_degree(v);
+    assert(deg == live);
+    check_windows(g, rs, 0, end);
+    check_windows(g, rs, h + 3, h + 20);
+  }
+  g.expire(end);
+  assert(g.empty());
+  check_windows(g, rs, 0, end);
+
+  // Expiring to an earlier time does nothing.
+  long h = g.horizon();
+  g.expire(0);
+  assert(g.horizon() == h);
+  auto e = g.add_edge(0, 1, end + 5, -1);
+  assert(g.size() == 1 && g(e) == -1 && size_t(e) == rs.size());
+}
+
+void
+check_order()
+{
+  cout << "*** order ***\n";
+  G g;
+  for (int i = 0; i < 3; ++i)
+    g.add_vertex();
+
+  // An edge earlier than the last one, or than the horizon, is rejected.
+  assert(g.add_edge(0, 1, 5, 0));
+  assert(!g.add_edge(1, 2, 4, 1));
+  assert(g.add_edge(1, 2, 5, 2));
+  g.expire(8);
+  assert(!g.add_edge(0, 2, 7, 3));
+  assert(g.empty() && g.out_degree(0) == 0);
+
+  // Edges at the greatest time are live.
+  long max = numeric_limits<long>::max();
+  auto e = g.add_edge(0, 2, max, 4);
+  g.add_edge(2, 0, max, 5);
+  assert(e && g(e) == 4 && g.size() == 2);
+  assert(g.out_degree(0) == 1 && g.in_degree(0) == 1 && g.in_degree(2) == 1);
+  for (auto x : g.out_edges(0))
+    assert(g.target(x) == 2 && g.time(x) == max);
+  for (auto x : g.in_edges(0))
+    assert(g.source(x) == 2);
+}
+
+void
+check_search()
+{
+  cout << "*** search ***\n";
+  // A path whose edges expire one at a time.
+  G g;
+  for (int i = 0; i < 10; ++i)
+    g.add_vertex();
+  for (int i = 0; i < 9; ++i)
+    g.add_edge(i, i + 1, i, 0);
+  assert(Directed_graph<G>());
+  size_t n = 0;
+  for (auto v : bfs_range(g, Vertex<G>(0))) {
+    (void)v;
+    ++n;
+  }
+  assert(n == 10);
+  g.expire(4);
+  n = 0;
+  for (auto v : bfs_range(g, Vertex<G>(0))) {
+    (void)v;
+    ++n;
+  }
+  assert(n == 1);
+  assert(g.out_degree(4) == 1 && g.in_degree(4) == 0);
+}
+
+int main()
+{
+  check_windows();
+  check_expire();
+  check_order();
+  check_search();
+}
@@ -0,0 +1,423 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_TRAVERSAL_HPP
+#define ORIGIN_GRAPH_TRAVERSAL_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <origin/graph/graph.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                           [graph.traversal]
+  //                            Vertex Bitmap
+  //
+  // A vertex bitmap is a set of vertex handles stored as one bit per handle.
+  // It remembers which words have been written since it was last cleared, so
+  // clearing a bitmap after a short traversal costs time proportional to the
+  // number of vertices visited, not to the size of the graph. This allows a
+  // single bitmap to be reused by many traversals. The bitmap grows as
+  // handles are inserted, so it need not be sized for the graph in advance.
+  class vertex_bitmap
+  {
+  public:
+    vertex_bitmap() = default;
+    explicit vertex_bitmap(std::size_t n) { reset(n); }
+
+    // Clear the bitmap.
+    void clear();
+
+    // Clear the bitmap, and make it large enough to hold the handles in
+    // [0, n) without growing.
+    void reset(std::size_t n);
+
+    // Returns true if the nth bit is set.
+    bool test(std::size_t n) const;
+
+    // Set the nth bit, returning true if it was not already set.
+    bool insert(std::size_t n);
+
+  private:
+    std::vector<std::uint64_t> bits_;
+    std::vector<std::size_t> dirty_; // Indexes of non-zero words
+  };
+
+  inline void
+  vertex_bitmap::clear()
+  {
+    for (std::size_t i : dirty_)
+      bits_[i] = 0;
+    dirty_.clear();
+  }
+
+  inline void
+  vertex_bitmap::reset(std::size_t n)
+  {
+    clear();
+    std::size_t w = (n + 63) / 64;
+    if (bits_.size() < w)
+      bits_.resize(w, 0);
+  }
+
+  inline bool
+  vertex_bitmap::test(std::size_t n) const
+  {
+    if (n / 64 >= bits_.size())
+      return false;
+    return bits_[n / 64] & (std::uint64_t(1) << (n % 64));
+  }
+
+  inline bool
+  vertex_bitmap::insert(std::size_t n)
+  {
+    if (n / 64 >= bits_.size())
+      bits_.resize(std::max(n / 64 + 1, 2 * bits_.size()), 0);
+    std::uint64_t& w = bits_[n / 64];
+    std::uint64_t b = std::uint64_t(1) << (n % 64);
+    if (w & b)
+      return false;
+    if (w == 0)
+      dirty_.push_back(n / 64);
+    w |= b;
+    return true;
+  }
+
+
+  namespace traversal_impl
+  {
+    // Returns the edges leaving v: the out edges of a directed graph, or
+    // the incident edges of an undirected graph.
+    template<typename G>
+      inline auto
+      leaving(const G& g, Vertex<G> v)
+        -> Requires<Directed_graph<G>(), decltype(g.out_edges(v))>
+      {
+        return g.out_edges(v);
+      }
+
+    template<typename G>
+      inline auto
+      leaving(const G& g, Vertex<G> v)
+        -> Requires<Undirected_graph<G>(), decltype(g.edges(v))>
+      {
+        return g.edges(v);
+      }
+
+    // Returns the endpoint of e, which leaves v, that is not v.
+    template<typename G>
+      inline Requires<Directed_graph<G>(), Vertex<G>>
+      head(const G& g, Edge<G> e, Vertex<G>) { return g.target(e); }
+
+    template<typename G>
+      inline Requires<Undirected_graph<G>(), Vertex<G>>
+      head(const G& g, Edge<G> e, Vertex<G> v) { return opposite(g, e, v); }
+
+    template<typename G>
+      using Leaving_range = decltype(leaving(std::declval<const G&>(),
+                                             std::declval<Vertex<G>>()));
+
+    template<typename G>
+      using Leaving_iterator = decltype(std::declval<Leaving_range<G>>().begin());
+
+
+    // ---------------------------------------------------------------------- //
+    //                          Traversal State
+    //
+    // The traversal state holds the graph, the visited set, and the vertex
+    // most recently reached, together with the tree edge by which it was
+    // reached (an invalid edge for the start vertex). The visited set is
+    // either borrowed from the caller or owned by the state. Creating the
+    // state only clears the set, which grows as vertices are visited.
+    template<typename G>
+      class state
+      {
+      public:
+        state(const G& g, vertex_bitmap* seen)
+          : graph(g), own(seen ? nullptr : new vertex_bitmap()),
+            seen(seen ? seen : own.get()), done(false)
+        {
+          this->seen->clear();
+        }
+
+        const G& graph;
+        std::unique_ptr<vertex_bitmap> own;
+        vertex_bitmap* seen;
+        Vertex<G> vertex;
+        Edge<G> edge;
+        bool done;
+      };
+
+
+    // ---------------------------------------------------------------------- //
+    //                        Traversal Iterator
+    //
+    // The traversal iterator is an input iterator over a breadth- or
+    // depth-first search. It refers to the search, which it advances when
+    // incremented. Dereferencing yields the current vertex or, when Edges
+    // is true, the tree edge that reached it. All past-the-end iterators,
+    // and all iterators over a finished search, compare equal.
+    template<typename S, typename T, bool Edges>
+      class iterator
+      {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = T;
+
+        iterator() : search(nullptr) { }
+        explicit iterator(S* s) : search(s) { }
+
+        reference operator*() const
+        {
+          return get(std::integral_constant<bool, Edges>{});
+        }
+
+        iterator& operator++() { search->next(); return *this; }
+        iterator  operator++(int) { iterator i = *this; ++*this; return i; }
+
+        bool operator==(const iterator& x) const
+        {
+          return finished() == x.finished();
+        }
+
+        bool operator!=(const iterator& x) const { return !(*this == x); }
+
+      private:
+        bool finished() const { return !search || search->done; }
+
+        T get(std::false_type) const { return search->vertex; }
+        T get(std::true_type) const { return search->edge; }
+
+        S* search;
+      };
+
+  } // namespace traversal_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                         Breadth-First Range
+  //
+  // A breadth-first range is a lazy breadth-first search from a start vertex.
+  // Its iterators visit the reachable vertices in breadth-first order, and
+  // the search advances only when an iterator is incremented. In particular,
+  // the edges of a vertex are not examined until the iteration moves past
+  // it, so an algorithm that stops early (e.g., find_if) does no more work
+  // than it needs.
+  //
+  // A range is a single pass: all of its iterators share the state of the
+  // search, and begin() does not restart it. The range must outlive its
+  // iterators and must not be moved while they are in use.
+  //
+  // The edge range yields the tree edges of the search, starting with the
+  // edge that reached the second vertex.
+  template<typename G, bool Edges = false>
+    class basic_bfs_range : public traversal_impl::state<G>
+    {
+      using base_type = traversal_impl::state<G>;
+      using value_type = typename std::conditional<Edges, Edge<G>, Vertex<G>>::type;
+    public:
+      using iterator = traversal_impl::iterator<basic_bfs_range, value_type, Edges>;
+
+      basic_bfs_range(const G& g, Vertex<G> s, vertex_bitmap* seen = nullptr);
+
+      iterator begin() { return iterator(this); }
+      iterator end()   { return iterator(); }
+
+      void next();
+
+    private:
+      std::deque<std::pair<Vertex<G>, Edge<G>>> queue_;
+    };
+
+  template<typename G, bool Edges>
+    basic_bfs_range<G, Edges>::basic_bfs_range(const G& g, Vertex<G> s,
+                                               vertex_bitmap* seen)
+      : base_type(g, seen)
+    {
+      this->seen->insert(s);
+      queue_.emplace_back(s, Edge<G>());
+      this->vertex = s;
+      if (Edges)
+        next();
+    }
+
+  // Expand the current vertex, and move to the next in the queue.
+  template<typename G, bool Edges>
+    void
+    basic_bfs_range<G, Edges>::next()
+    {
+      assert(!this->done);
+      Vertex<G> v = queue_.front().first;
+      queue_.pop_front();
+      for (auto e : traversal_impl::leaving(this->graph, v)) {
+        Vertex<G> w = traversal_impl::head(this->graph, e, v);
+        if (this->seen->insert(w))
+          queue_.emplace_back(w, e);
+      }
+      if (queue_.empty()) {
+        this->done = true;
+        return;
+      }
+      this->vertex = queue_.front().first;
+      this->edge = queue_.front().second;
+    }
+
+
+  // ------------------------------------------------------------------------ //
+  //                          Depth-First Range
+  //
+  // A depth-first range is a lazy depth-first search from a start vertex.
+  // Its iterators visit the reachable vertices in preorder, that is, in the
+  // order in which they are discovered. The search keeps, for each vertex on
+  // the current path, its position in its edge list, so advancing resumes
+  // the scan where it left off. Like the breadth-first range, it is a
+  // single pass, and the edge range yields the tree edges.
+  template<typename G, bool Edges = false>
+    class basic_dfs_range : public traversal_impl::state<G>
+    {
+      using base_type = traversal_impl::state<G>;
+      using value_type = typename std::conditional<Edges, Edge<G>, Vertex<G>>::type;
+      using edge_iter = traversal_impl::Leaving_iterator<G>;
+
+      struct frame
+      {
+        Vertex<G> vertex;
+        edge_iter first;
+        edge_iter last;
+      };
+    public:
+      using iterator = traversal_impl::iterator<basic_dfs_range, value_type, Edges>;
+
+      basic_dfs_range(const G& g, Vertex<G> s, vertex_bitmap* seen = nullptr);
+
+      iterator begin() { return iterator(this); }
+      iterator end()   { return iterator(); }
+
+      void next();
+
+    private:
+      void push(Vertex<G> v);
+
+      std::vector<frame> stack_;
+    };
+
+  template<typename G, bool Edges>
+    basic_dfs_range<G, Edges>::basic_dfs_range(const G& g, Vertex<G> s,
+                                               vertex_bitmap* seen)
+      : base_type(g, seen)
+    {
+      this->seen->insert(s);
+      push(s);
+      this->vertex = s;
+      if (Edges)
+        next();
+    }
+
+  template<typename G, bool Edges>
+    inline void
+    basic_dfs_range<G, Edges>::push(Vertex<G> v)
+    {
+      auto r = traversal_impl::leaving(this->graph, v);
+      stack_.push_back({v, r.begin(), r.end()});
+    }
+
+  // Discover the next vertex: the first unvisited neighbor of the deepest
+  // vertex on the path that has one.
+  template<typename G, bool Edges>
+    void
+    basic_dfs_range<G, Edges>::next()
+    {
+      assert(!this->done);
+      while (!stack_.empty()) {
+        frame& f = stack_.back();
+        while (f.first != f.last) {
+          Edge<G> e = *f.first;
+          ++f.first;
+          Vertex<G> w = traversal_impl::head(this->graph, e, f.vertex);
+          if (this->seen->insert(w)) {
+            this->vertex = w;
+            this->edge = e;
+            push(w);
+            return;
+          }
+        }
+        stack_.pop_back();
+      }
+      this->done = true;
+    }
+
+
+  // ------------------------------------------------------------------------ //
+  //                          Traversal Ranges
+  //
+  // The traversal range functions return lazy searches of g from s. The
+  // optional bitmap is reset and used as the visited set, so that repeated
+  // searches can share one allocation.
+  //
+  //    bfs_range(g, s)
+  //    bfs_range(g, s, seen)
+  //    bfs_tree_edges(g, s)
+  //    dfs_range(g, s)
+  //    dfs_range(g, s, seen)
+  //    dfs_tree_edges(g, s)
+  template<typename G>
+    using bfs_vertex_range = basic_bfs_range<G, false>;
+
+  template<typename G>
+    using bfs_edge_range = basic_bfs_range<G, true>;
+
+  template<typename G>
+    using dfs_vertex_range = basic_dfs_range<G, false>;
+
+  template<typename G>
+    using dfs_edge_range = basic_dfs_range<G, true>;
+
+  template<typename G>
+    inline bfs_vertex_range<G>
+    bfs_range(const G& g, Vertex<G> s) { return {g, s}; }
+
+  template<typename G>
+    inline bfs_vertex_range<G>
+    bfs_range(const G& g, Vertex<G> s, vertex_bitmap& seen)
+    {
+      return {g, s, &seen};
+    }
+
+  template<typename G>
+    inline bfs_edge_range<G>
+    bfs_tree_edges(const G& g, Vertex<G> s) { return {g, s}; }
+
+  template<typename G>
+    inline dfs_vertex_range<G>
+    dfs_range(const G& g, Vertex<G> s) { return {g, s}; }
+
+  template<typename G>
+    inline dfs_vertex_range<G>
+    dfs_range(const G& g, Vertex<G> s, vertex_bitmap& seen)
+    {
+      return {g, s, &seen};
+    }
+
+  template<typename G>
+    inline dfs_edge_range<G>
+    dfs_tree_edges(const G& g, Vertex<G> s) { return {g, s}; }
+
+} // namespace origin
+
+#endif
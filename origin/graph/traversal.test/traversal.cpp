@@ -0,0 +1,220 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/sequence/algorithm.hpp>
+
+#include <origin/graph/adjacency_list.hpp>
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/traversal.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using D = directed_adjacency_vector<>;
+using U = undirected_adjacency_vector<>;
+using L = undirected_adjacency_list<>;
+
+// Copy the elements of a range into a vector.
+template<typename R>
+  vector<typename R::iterator::value_type>
+  collect(R&& r)
+  {
+    vector<typename R::iterator::value_type> v;
+    for (auto x : r)
+      v.push_back(x);
+    return v;
+  }
+
+// Compute breadth-first distances from s, or -1 for unreachable vertices.
+template<typename G>
+  vector<int>
+  distances(const G& g, Vertex<G> s)
+  {
+    vector<int> d(vertex_bound(g), -1);
+    vector<Vertex<G>> q {s};
+    d[s] = 0;
+    for (size_t i = 0; i < q.size(); ++i)
+      for (auto e : g.edges(q[i])) {
+        auto w = opposite(g, e, q[i]);
+        if (d[w] < 0) {
+          d[w] = d[q[i]] + 1;
+          q.push_back(w);
+        }
+      }
+    return d;
+  }
+
+// Check that the vertices of a search from s are exactly the reachable
+// vertices, each visited once, and that every vertex after the first is
+// reached by an edge from a vertex visited before it. For a breadth-first
+// search, distances must also be nondecreasing.
+template<typename G>
+  void
+  check_search(const G& g, Vertex<G> s, const vector<Vertex<G>>& order,
+               const vector<Edge<G>>& tree, bool bfs)
+  {
+    vector<int> d = distances(g, s);
+    vector<int> pos(vertex_bound(g), -1);
+    assert(order.size() == tree.size() + 1);
+    assert(order[0] == s);
+    for (size_t i = 0; i < order.size(); ++i) {
+      assert(d[order[i]] >= 0);
+      assert(pos[order[i]] < 0);
+      pos[order[i]] = i;
+      if (bfs && i > 0)
+        assert(d[order[i - 1]] <= d[order[i]]);
+    }
+    for (auto v : g.vertices())
+      assert((d[v] >= 0) == (pos[v] >= 0));
+    for (size_t i = 0; i < tree.size(); ++i) {
+      Vertex<G> v = order[i + 1];
+      assert(is_endpoint(g, tree[i], v));
+      Vertex<G> u = opposite(g, tree[i], v);
+      assert(pos[u] >= 0 && pos[u] <= int(i));
+      if (bfs)
+        assert(d[v] == d[u] + 1);
+    }
+  }
+
+void
+check_small()
+{
+  cout << "*** small ***\n";
+  // 0 -> 1 -> 3
+  //  \-> 2 -> 4, and 5 is unreachable.
+  D g;
+  for (int i = 0; i < 6; ++i)
+    g.add_vertex();
+  g.add_edge(0, 1);
+  g.add_edge(0, 2);
+  g.add_edge(1, 3);
+  g.add_edge(2, 4);
+  g.add_edge(4, 0);
+  g.add_edge(5, 0);
+
+  auto b = collect(bfs_range(g, Vertex<D>(0)));
+  auto d = collect(dfs_range(g, Vertex<D>(0)));
+  vector<size_t> bs(b.begin(), b.end());
+  vector<size_t> ds(d.begin(), d.end());
+  assert((bs == vector<size_t> {0, 1, 2, 3, 4}));
+  assert((ds == vector<size_t> {0, 1, 3, 2, 4}));
+
+  auto be = collect(bfs_tree_edges(g, Vertex<D>(0)));
+  assert(be.size() == 4);
+  for (size_t i = 0; i < be.size(); ++i)
+    assert(g.target(be[i]) == b[i + 1]);
+
+  auto de = collect(dfs_tree_edges(g, Vertex<D>(0)));
+  assert(de.size() == 4);
+  for (size_t i = 0; i < de.size(); ++i)
+    assert(g.target(de[i]) == d[i + 1]);
+
+  // A vertex with no out edges yields only itself, and no tree edges.
+  assert(collect(bfs_range(g, Vertex<D>(3))).size() == 1);
+  assert(collect(dfs_tree_edges(g, Vertex<D>(3))).empty());
+}
+
+void
+check_early_exit()
+{
+  cout << "*** early exit ***\n";
+  // A path 0 - 1 - ... - 999. Finding vertex 3 must not expand it.
+  U g;
+  for (int i = 0; i < 1000; ++i)
+    g.add_vertex();
+  for (int i = 0; i < 999; ++i)
+    g.add_edge(i, i + 1);
+
+  size_t seen = 0;
+  auto r = bfs_range(g, Vertex<U>(0));
+  auto i = origin::find_if(r, [&](Vertex<U> v) { ++seen; return size_t(v) == 3; });
+  assert(i != r.end());
+  assert(*i == Vertex<U>(3));
+  assert(seen == 4);
+
+  // Resuming the search continues past the vertex that was found.
+  ++i;
+  assert(*i == Vertex<U>(4));
+
+  auto s = dfs_range(g, Vertex<U>(500));
+  auto j = origin::find_if(s, [](Vertex<U> v) { return size_t(v) == 0; });
+  assert(j != s.end());
+  assert(*j == Vertex<U>(0));
+}
+
+void
+check_random()
+{
+  cout << "*** random ***\n";
+  vertex_bitmap seen;
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    U g = random_graph<U>(200, 150 + 10 * seed, seed);
+    for (size_t s = 0; s < 200; s += 37) {
+      Vertex<U> v(s);
+      check_search(g, v, collect(bfs_range(g, v, seen)),
+                   collect(bfs_tree_edges(g, v)), true);
+      check_search(g, v, collect(dfs_range(g, v, seen)),
+                   collect(dfs_tree_edges(g, v)), false);
+    }
+  }
+}
+
+void
+check_list()
+{
+  cout << "*** list ***\n";
+  // Removing vertices leaves holes in the handle space.
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    L g = random_graph<L>(200, 300, seed);
+    for (size_t v = 0; v < 200; v += 7)
+      g.remove_vertex(v);
+    for (size_t s = 1; s < 200; s += 41) {
+      Vertex<L> v(s % 7 ? s : s + 1);
+      check_search(g, v, collect(bfs_range(g, v)),
+                   collect(bfs_tree_edges(g, v)), true);
+      check_search(g, v, collect(dfs_range(g, v)),
+                   collect(dfs_tree_edges(g, v)), false);
+    }
+  }
+}
+
+void
+check_bitmap()
+{
+  cout << "*** bitmap ***\n";
+  vertex_bitmap b(100);
+  assert(b.insert(3));
+  assert(!b.insert(3));
+  assert(b.insert(99));
+  assert(b.test(3) && b.test(99) && !b.test(4));
+  b.reset(1000);
+  assert(!b.test(3) && !b.test(99));
+  assert(b.insert(999));
+
+  // The bitmap grows on insertion.
+  vertex_bitmap c;
+  assert(!c.test(5000));
+  assert(c.insert(5000) && c.test(5000) && !c.test(4999));
+  assert(c.insert(70) && !c.insert(70));
+  c.clear();
+  assert(!c.test(5000) && !c.test(70));
+}
+
+int main()
+{
+  check_small();
+  check_early_exit();
+  check_random();
+  check_list();
+  check_bitmap();
+}
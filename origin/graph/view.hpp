@@ -0,0 +1,308 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#ifndef ORIGIN_GRAPH_VIEW_HPP
+#define ORIGIN_GRAPH_VIEW_HPP
+
+#include <cstddef>
+
+#include <origin/sequence/iterator.hpp>
+#include <origin/sequence/range.hpp>
+
+#include <origin/graph/graph.hpp>
+
+namespace origin
+{
+  // ------------------------------------------------------------------------ //
+  //                                                                [graph.view]
+  //                              Graph Views
+  //
+  // A graph view presents a different graph over the vertices and edges of
+  // an existing graph without copying it. Views have the same vertex and
+  // edge handles as the graph they adapt, so property maps indexed by those
+  // handles can be shared between a graph and its views. A view refers to
+  // its graph, which must outlive it, and the ranges returned by a view
+  // refer to the view.
+  //
+  //    filtered_graph<G, VP, EP>
+  //    transposed_graph<G>
+  //
+
+  namespace view_impl
+  {
+    // A predicate that accepts every vertex or edge.
+    struct keep_all
+    {
+      template<typename T>
+        bool operator()(const T&) const { return true; }
+    };
+
+    // The vertex and edge filters bind the membership tests of a view, so
+    // they can be used as the predicates of filter iterators.
+    template<typename F>
+      struct vertex_filter
+      {
+        bool operator()(Vertex<F> v) const { return view->keep(v); }
+
+        const F* view;
+      };
+
+    template<typename F>
+      struct edge_filter
+      {
+        bool operator()(Edge<F> e) const { return view->keep(e); }
+
+        const F* view;
+      };
+
+    // The range of elements of R that satisfy the predicate P.
+    template<typename R, typename P>
+      using Filtered_range = bounded_range<filter_iterator<Iterator_of<R>, P>>;
+
+    template<typename P, typename R>
+      inline Filtered_range<R, P>
+      filter(const R& r, P pred)
+      {
+        using I = filter_iterator<Iterator_of<R>, P>;
+        return {I(r.begin(), r.end(), pred), I(r.end(), pred)};
+      }
+
+    // Returns the number of elements in a range.
+    template<typename R>
+      inline std::size_t
+      count(const R& r)
+      {
+        std::size_t n = 0;
+        for (auto i = r.begin(); i != r.end(); ++i)
+          ++n;
+        return n;
+      }
+
+  } // namespace view_impl
+
+
+  // ------------------------------------------------------------------------ //
+  //                            Filtered Graph
+  //
+  // A filtered graph is the subgraph of g whose vertices satisfy the vertex
+  // predicate and whose edges satisfy the edge predicate and join two such
+  // vertices. Membership is tested as the graph is traversed, so filtering
+  // costs nothing up front, but each range skips the vertices and edges
+  // that are not members. In particular, order(), size(), and the degree
+  // functions count the members, taking linear time.
+  //
+  // A filtered graph is directed or undirected as G is.
+  template<typename G, typename VP, typename EP>
+    class filtered_graph
+    {
+      using this_type = filtered_graph<G, VP, EP>;
+      using vertex_pred = view_impl::vertex_filter<this_type>;
+      using edge_pred = view_impl::edge_filter<this_type>;
+
+      template<typename R>
+        using Edge_range = view_impl::Filtered_range<R, edge_pred>;
+    public:
+      using graph_type = G;
+
+      using vertex = Vertex<G>;
+      using vertex_range =
+        view_impl::Filtered_range<decltype(std::declval<const G&>().vertices()),
+                                  vertex_pred>;
+
+      using edge = Edge<G>;
+      using edge_range = Edge_range<decltype(std::declval<const G&>().edges())>;
+
+      filtered_graph(const G& g, VP vp = {}, EP ep = {})
+        : g_(g), vp_(vp), ep_(ep)
+      { }
+
+      // Returns the adapted graph.
+      const G& base() const { return g_; }
+
+      // Returns true if v is a vertex of the view.
+      bool keep(vertex v) const { return vp_(v); }
+
+      // Returns true if e is an edge of the view.
+      bool keep(edge e) const
+      {
+        return vp_(g_.source(e)) && vp_(g_.target(e)) && ep_(e);
+      }
+
+      // Observers
+      bool        null() const  { return vertices().begin() == vertices().end(); }
+      std::size_t order() const { return view_impl::count(vertices()); }
+
+      bool        empty() const { return edges().begin() == edges().end(); }
+      std::size_t size() const  { return view_impl::count(edges()); }
+
+      // Vertex observers
+      template<typename X = G>
+        Requires<Directed_graph<X>(), std::size_t>
+        out_degree(vertex v) const { return view_impl::count(out_edges(v)); }
+
+      template<typename X = G>
+        Requires<Directed_graph<X>(), std::size_t>
+        in_degree(vertex v) const { return view_impl::count(in_edges(v)); }
+
+      template<typename X = G>
+        Requires<Directed_graph<X>(), std::size_t>
+        degree(vertex v) const { return out_degree(v) + in_degree(v); }
+
+      template<typename X = G>
+        Requires<Undirected_graph<X>(), std::size_t>
+        degree(vertex v) const { return view_impl::count(edges(v)); }
+
+      // Edge observers
+      vertex source(edge e) const { return g_.source(e); }
+      vertex target(edge e) const { return g_.target(e); }
+
+      // Data access
+      auto operator()(vertex v) const -> decltype(std::declval<const G&>()(v))
+      {
+        return g_(v);
+      }
+
+      auto operator()(edge e) const -> decltype(std::declval<const G&>()(e))
+      {
+        return g_(e);
+      }
+
+      // Iterators
+      vertex_range vertices() const
+      {
+        return view_impl::filter(g_.vertices(), vertex_pred{this});
+      }
+
+      edge_range edges() const
+      {
+        return view_impl::filter(g_.edges(), edge_pred{this});
+      }
+
+      template<typename X = G>
+        auto out_edges(vertex v) const
+          -> Edge_range<decltype(std::declval<const X&>().out_edges(v))>
+        {
+          return view_impl::filter(g_.out_edges(v), edge_pred{this});
+        }
+
+      template<typename X = G>
+        auto in_edges(vertex v) const
+          -> Edge_range<decltype(std::declval<const X&>().in_edges(v))>
+        {
+          return view_impl::filter(g_.in_edges(v), edge_pred{this});
+        }
+
+      template<typename X = G>
+        auto edges(vertex v) const
+          -> Edge_range<decltype(std::declval<const X&>().edges(v))>
+        {
+          return view_impl::filter(g_.edges(v), edge_pred{this});
+        }
+
+    private:
+      const G& g_;
+      VP vp_;
+      EP ep_;
+    };
+
+
+  // Returns the subgraph of g induced by the vertices satisfying pred: the
+  // vertices that satisfy pred, and every edge joining two of them.
+  template<typename G, typename P>
+    inline filtered_graph<G, P, view_impl::keep_all>
+    induced_subgraph(const G& g, P pred) { return {g, pred}; }
+
+  // Returns the spanning subgraph of g whose edges satisfy pred.
+  template<typename G, typename P>
+    inline filtered_graph<G, view_impl::keep_all, P>
+    filter_edges(const G& g, P pred) { return {g, {}, pred}; }
+
+  // Returns the subgraph of g induced by the vertices satisfying vp, less the
+  // edges that do not satisfy ep.
+  template<typename G, typename VP, typename EP>
+    inline filtered_graph<G, VP, EP>
+    filter_graph(const G& g, VP vp, EP ep) { return {g, vp, ep}; }
+
+
+  // ------------------------------------------------------------------------ //
+  //                           Transposed Graph
+  //
+  // The transpose of a directed graph has the same vertices and edges, but
+  // every edge points the other way: the source of an edge is its target in
+  // g, and the out edges of a vertex are its in edges in g. All operations
+  // take the same time as in g.
+  template<typename G>
+    class transposed_graph
+    {
+      static_assert(Directed_graph<G>(), "");
+    public:
+      using graph_type = G;
+
+      using vertex = Vertex<G>;
+      using vertex_range = decltype(std::declval<const G&>().vertices());
+
+      using edge = Edge<G>;
+      using edge_range = decltype(std::declval<const G&>().edges());
+
+      using incidence_range =
+        decltype(std::declval<const G&>().out_edges(std::declval<vertex>()));
+
+      transposed_graph(const G& g)
+        : g_(g)
+      { }
+
+      // Returns the adapted graph.
+      const G& base() const { return g_; }
+
+      // Observers
+      bool        null() const  { return g_.null(); }
+      std::size_t order() const { return g_.order(); }
+
+      bool        empty() const { return g_.empty(); }
+      std::size_t size() const  { return g_.size(); }
+
+      // Vertex observers
+      std::size_t out_degree(vertex v) const { return g_.in_degree(v); }
+      std::size_t in_degree(vertex v) const  { return g_.out_degree(v); }
+      std::size_t degree(vertex v) const     { return g_.degree(v); }
+
+      // Edge observers
+      vertex source(edge e) const { return g_.target(e); }
+      vertex target(edge e) const { return g_.source(e); }
+
+      // Data access
+      auto operator()(vertex v) const -> decltype(std::declval<const G&>()(v))
+      {
+        return g_(v);
+      }
+
+      auto operator()(edge e) const -> decltype(std::declval<const G&>()(e))
+      {
+        return g_(e);
+      }
+
+      // Edge relation
+      edge operator()(vertex u, vertex v) const { return g_(v, u); }
+
+      // Iterators
+      vertex_range    vertices() const { return g_.vertices(); }
+      edge_range      edges() const    { return g_.edges(); }
+      incidence_range out_edges(vertex v) const { return g_.in_edges(v); }
+      incidence_range in_edges(vertex v) const  { return g_.out_edges(v); }
+
+    private:
+      const G& g_;
+    };
+
+  // Returns the transpose of the directed graph g.
+  template<typename G>
+    inline transposed_graph<G>
+    transpose(const G& g) { return {g}; }
+
+} // namespace origin
+
+#endif
@@ -0,0 +1,168 @@
+// Copyright (c) 2008-2010 Kent State University
+// Copyright (c) 2011-2012 Texas A&M University
+//
+// This file is distributed under the MIT License. See the accompanying file
+// LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+// and conditions.
+
+#include <cassert>
+#include <iostream>
+
+#include <origin/graph/adjacency_list.hpp>
+#include <origin/graph/adjacency_vector.hpp>
+#include <origin/graph/core.hpp>
+#include <origin/graph/traversal.hpp>
+#include <origin/graph/view.hpp>
+
+#include "../graph.test/testing.hpp"
+
+using namespace std;
+using namespace origin;
+using namespace testing;
+
+using D = directed_adjacency_vector<empty_t, int>;
+using U = undirected_adjacency_vector<empty_t, int>;
+using L = undirected_adjacency_list<empty_t, int>;
+
+// Copy the handles in a range into a vector of integers.
+template<typename R>
+  vector<size_t>
+  collect(R&& r)
+  {
+    vector<size_t> v;
+    for (auto x : r)
+      v.push_back(x);
+    return v;
+  }
+
+struct not_third
+{
+  bool operator()(vertex_handle v) const { return v % 3 != 0; }
+};
+
+void
+check_induced()
+{
+  cout << "*** induced ***\n";
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    U g = random_graph<U>(300, 1200, seed, uniform_values(0, 10));
+    auto h = induced_subgraph(g, not_third{});
+
+    // Materialize the subgraph with the same handles, leaving the removed
+    // vertices isolated.
+    U c;
+    for (size_t i = 0; i < 300; ++i)
+      c.add_vertex();
+    vector<size_t> es;
+    for (auto e : g.edges())
+      if (g.source(e) % 3 != 0 && g.target(e) % 3 != 0) {
+        c.add_edge(g.source(e), g.target(e), g(e));
+        es.push_back(e);
+      }
+
+    assert(h.order() == 200);
+    assert(h.size() == es.size());
+    assert(collect(h.edges()) == es);
+    for (auto v : h.vertices()) {
+      assert(v % 3 != 0);
+      assert(h.degree(v) == c.degree(v));
+      for (auto e : h.edges(v))
+        assert(h.keep(e) && is_endpoint(h, e, v));
+    }
+
+    auto r1 = core_decomposition(h);
+    auto r2 = core_decomposition(c);
+    for (auto v : h.vertices())
+      assert(r1.core[v] == r2.core[v]);
+  }
+}
+
+void
+check_edges()
+{
+  cout << "*** edges ***\n";
+  D g = random_graph<D>(200, 1000, 1, uniform_values(0, 10));
+  auto light = [&](edge_handle e) { return g(e) < 5; };
+  auto h = filter_edges(g, light);
+  assert(Directed_graph<decltype(h)>());
+  assert(!Undirected_graph<decltype(h)>());
+  assert(h.order() == g.order());
+
+  size_t m = 0;
+  for (auto v : g.vertices()) {
+    vector<size_t> out, in;
+    for (auto e : g.out_edges(v))
+      if (light(e))
+        out.push_back(e);
+    for (auto e : g.in_edges(v))
+      if (light(e))
+        in.push_back(e);
+    assert(collect(h.out_edges(v)) == out);
+    assert(collect(h.in_edges(v)) == in);
+    assert(h.out_degree(v) == out.size());
+    assert(h.in_degree(v) == in.size());
+    m += out.size();
+  }
+  assert(h.size() == m);
+}
+
+void
+check_transpose()
+{
+  cout << "*** transpose ***\n";
+  D g = random_graph<D>(200, 400, 2, uniform_values(0, 10));
+  auto t = transpose(g);
+  assert(Directed_graph<decltype(t)>());
+  assert(t.order() == g.order() && t.size() == g.size());
+  for (auto e : g.edges()) {
+    assert(t.source(e) == g.target(e));
+    assert(t.target(e) == g.source(e));
+    assert(t(e) == g(e));
+  }
+  for (auto v : g.vertices()) {
+    assert(collect(t.out_edges(v)) == collect(g.in_edges(v)));
+    assert(collect(t.in_edges(v)) == collect(g.out_edges(v)));
+    assert(t.out_degree(v) == g.in_degree(v));
+  }
+
+  // A search of the transpose finds the vertices that reach the start.
+  vector<size_t> from = collect(bfs_range(t, Vertex<D>(0)));
+  vector<bool> reach(200, false);
+  for (auto v : g.vertices())
+    for (auto u : bfs_range(g, v))
+      if (size_t(u) == 0)
+        reach[v] = true;
+  assert(from.size() == size_t(count(reach.begin(), reach.end(), true)));
+  for (size_t v : from)
+    assert(reach[v]);
+
+  // Transposing an edge-filtered graph.
+  auto f = filter_edges(g, [&](edge_handle e) { return g(e) % 2 == 0; });
+  auto ft = transpose(f);
+  for (auto v : g.vertices())
+    assert(collect(ft.out_edges(v)) == collect(f.in_edges(v)));
+}
+
+void
+check_list()
+{
+  cout << "*** list ***\n";
+  // Removing vertices leaves holes in the handle space.
+  L g = random_graph<L>(200, 600, 3, uniform_values(0, 10));
+  for (size_t v = 0; v < 200; v += 7)
+    g.remove_vertex(v);
+  auto h = induced_subgraph(g, [](vertex_handle v) { return v % 2 == 0; });
+  for (auto v : h.vertices())
+    assert(v % 2 == 0 && v % 7 != 0);
+  for (auto e : h.edges())
+    assert(h.source(e) % 2 == 0 && h.target(e) % 2 == 0);
+  assert(h.order() == 100 - 15);
+}
+
+int main()
+{
+  check_induced();
+  check_edges();
+  check_transpose();
+  check_list();
+}
@@ -10,6 +10,8 @@
 
 #include <cstring>
 #include <iterator>
+#include <tuple>
+#include <type_traits>
 
 #include "algorithm.hpp"
 
@@ -32,6 +34,15 @@ namespace origin
 			using value_type = Value_type<I>;
 			using reference = Reference_of<I>;
 			using pointer = Pointer_of<I>;
+			using difference_type = Difference_type<I>;
+
+			// A filter iterator can be traversed more than once if its
+			// underlying iterator can, but it cannot move backwards.
+			using iterator_category = typename std::conditional<
+				Derived<Iterator_category<I>, std::forward_iterator_tag>(),
+				std::forward_iterator_tag,
+				std::input_iterator_tag
+			>::type;
 
 			// Constructors
 
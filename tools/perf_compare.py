@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Copyright (c) 2008-2010 Kent State University
+# Copyright (c) 2011-2012 Texas A&M University
+#
+# This file is distributed under the MIT License. See the accompanying file
+# LICENSE.txt or http://www.opensource.org/licenses/mit-license.php for terms
+# and conditions.
+
+# Merge the CSV results of a head-to-head performance comparison.
+#
+#   perf_compare.py -o output.csv baseline.csv other.csv...
+#
+# Each input has a header row and one row per measurement. A measurement is
+# identified by its columns other than the implementation and the timings.
+# The output contains every row of every input, in order, with a ratio
+# column: the best time of the row divided by the best time of the matching
+# row of the baseline (the first input). The ratio is empty when there is no
+# matching row.
+
+import argparse
+import csv
+import sys
+
+IMPL = "implementation"
+TIMES = ("operations", "best_seconds", "mean_seconds", "ns_per_operation")
+
+
+def key(row):
+    return tuple((k, v) for k, v in row.items() if k != IMPL and k not in TIMES)
+
+
+def read(path):
+    with open(path, newline="") as f:
+        reader = csv.DictReader(f)
+        return reader.fieldnames, list(reader)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("inputs", nargs="+")
+    args = parser.parse_args()
+
+    tables = [read(p) for p in args.inputs]
+    fields = tables[0][0]
+    for path, (f, _) in zip(args.inputs, tables):
+        if f != fields:
+            sys.exit("%s: columns differ from %s" % (path, args.inputs[0]))
+
+    baseline = {key(r): float(r["best_seconds"]) for r in tables[0][1]}
+    with open(args.output, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=fields + ["ratio"])
+        writer.writeheader()
+        for _, rows in tables:
+            for r in rows:
+                base = baseline.get(key(r))
+                ratio = ""
+                if base:
+                    ratio = "%.4g" % (float(r["best_seconds"]) / base)
+                writer.writerow(dict(r, ratio=ratio))
+
+
+if __name__ == "__main__":
+    main()